@@ -0,0 +1,216 @@
+//
+//  AsyncChannelBenchmark.swift
+//  Benchmarks
+//
+//  `AsyncChannel` against a copy of the original actor-based one, with many tasks awaiting a single value,
+//  and with many short-lived channels, like `WrappedClosure.withResult` makes.
+//  Then `AsyncBufferedChannel` against `AsyncStream`, with several producers.
+//  Nothing here needs the event loop.
+//
+
+import Foundation
+
+@testable import SlintUI
+
+/// The original `AsyncChannel`. A `UUID` and two tasks per read, a task per send, and an actor hop for each.
+final class LegacyAsyncChannel<T> {
+    private let buffer = Buffer()
+
+    var value: T {
+        get async throws {
+            let id = UUID()
+            return try await withTaskCancellationHandler(operation: {
+                try Task.checkCancellation()
+                return try await withCheckedThrowingContinuation { continuation in
+                    guard !Task.isCancelled else { return }
+                    Task { await buffer.addContinuationIfNeeded(continuation, id) }
+                }
+            }, onCancel: {
+                Task { await buffer.cancelContinuation(id) }
+            })
+        }
+    }
+
+    func send(_ v: T) {
+        Task { await buffer.send(v) }
+    }
+
+    actor Buffer {
+        private var continuations = [UUID: CheckedContinuation<T, Error>]()
+        private var value: T?
+
+        func addContinuationIfNeeded(_ continuation: CheckedContinuation<T, Error>, _ id: UUID) {
+            if let value {
+                continuation.resume(returning: value)
+                return
+            }
+            continuations[id] = continuation
+        }
+
+        func cancelContinuation(_ id: UUID) {
+            continuations[id]?.resume(throwing: CancellationError())
+            continuations[id] = nil
+        }
+
+        func send(_ v: T) {
+            value = v
+            continuations.values.forEach { $0.resume(returning: v) }
+            continuations.removeAll()
+        }
+    }
+}
+
+@main
+struct AsyncChannelBenchmark: SlintApp {
+    /// Waiter counts for the contention runs.
+    static let waiterCounts = [1, 100, 10_000]
+    /// Rounds per waiter count. The first is a warm-up, and not counted.
+    static let rounds = 6
+    /// Channels made for the round-trip runs.
+    static let roundTrips = 100_000
+
+    /// Producers, elements per producer, and buffer capacity for the streaming runs.
+    static let producers = 4
+    static let elementsPerProducer = 250_000
+    static let streamCapacity = 256
+
+    static func start() {
+        Task.detached {
+            for waiters in waiterCounts {
+                await compareContention(waiters)
+            }
+            await compareRoundTrips()
+            await compareStreams()
+
+            exit(0)
+        }
+    }
+
+    // MARK: One-shot
+
+    /// Time from making a channel, through every waiter suspending, to the last one resuming.
+    static func contention(_ waiters: Int, read: @escaping @Sendable () async throws -> Int, send: @escaping @Sendable () -> Void) async -> UInt64 {
+        await measure {
+            await withTaskGroup(of: Void.self) { group in
+                for _ in 0 ..< waiters {
+                    group.addTask { blackHole(try? await read()) }
+                }
+                send()
+            }
+        }
+    }
+
+    static func compareContention(_ waiters: Int) async {
+        var legacyTime: UInt64 = 0
+        var time: UInt64 = 0
+
+        for round in 0 ..< rounds {
+            let legacy = LegacyAsyncChannel<Int>()
+            let legacyRound = await contention(waiters, read: { try await legacy.value }, send: { legacy.send(round) })
+
+            let channel = AsyncChannel(Int.self)
+            let channelRound = await contention(waiters, read: { try await channel.value }, send: { channel.send(round) })
+
+            if round > 0 {
+                legacyTime += legacyRound
+                time += channelRound
+            }
+        }
+
+        let counted = UInt64(rounds - 1)
+        report("one value, \(waiters) awaiting task(s)", [
+            "before": formatDuration(legacyTime / counted),
+            "after": formatDuration(time / counted),
+            "speedup": String(format: "%.2fx", Double(legacyTime) / Double(max(time, 1))),
+        ])
+    }
+
+    /// One channel per round trip, read by one task, sent from another. Like `WrappedClosure.withResult`.
+    static func compareRoundTrips() async {
+        let legacyTime = await measure {
+            for i in 0 ..< roundTrips {
+                let channel = LegacyAsyncChannel<Int>()
+                async let value = channel.value
+                Task.detached { channel.send(i) }
+                blackHole(try? await value)
+            }
+        }
+
+        let time = await measure {
+            for i in 0 ..< roundTrips {
+                let channel = AsyncChannel(Int.self)
+                async let value = channel.value
+                Task.detached { channel.send(i) }
+                blackHole(try? await value)
+            }
+        }
+
+        // Reading a value that's already there.
+        let fulfilled = AsyncChannel(Int.self)
+        fulfilled.send(1)
+        let fastTime = await measure {
+            for _ in 0 ..< roundTrips { blackHole(try? await fulfilled.value) }
+        }
+
+        report("\(roundTrips) round trips", [
+            "before": formatRate(rate(roundTrips, legacyTime)),
+            "after": formatRate(rate(roundTrips, time)),
+            "speedup": String(format: "%.2fx", Double(legacyTime) / Double(max(time, 1))),
+            "already sent": formatRate(rate(roundTrips, fastTime)),
+        ])
+    }
+
+    // MARK: Streaming
+
+    static func compareStreams() async {
+        let total = producers * elementsPerProducer
+
+        // `AsyncStream` has no backpressure, so unbounded is the fairest comparison.
+        let streamTime = await measure {
+            let (stream, continuation) = AsyncStream.makeStream(of: Int.self, bufferingPolicy: .unbounded)
+            await withTaskGroup(of: Void.self) { group in
+                for p in 0 ..< producers {
+                    group.addTask {
+                        for i in 0 ..< elementsPerProducer { continuation.yield(p &+ i) }
+                    }
+                }
+                group.addTask {
+                    var sum = 0
+                    var received = 0
+                    for await element in stream {
+                        sum &+= element
+                        received += 1
+                        if received == total { break }
+                    }
+                    blackHole(sum)
+                }
+            }
+        }
+
+        let channelTime = await measure {
+            let channel = AsyncBufferedChannel(Int.self, capacity: streamCapacity)
+            await withTaskGroup(of: Void.self) { group in
+                for p in 0 ..< producers {
+                    group.addTask {
+                        for i in 0 ..< elementsPerProducer { _ = try? await channel.send(p &+ i) }
+                    }
+                }
+                group.addTask {
+                    var sum = 0
+                    var received = 0
+                    for await element in channel {
+                        sum &+= element
+                        received += 1
+                        if received == total { break }
+                    }
+                    blackHole(sum)
+                }
+            }
+        }
+
+        report("\(producers) producers, \(total) elements", [
+            "AsyncStream (unbounded)": formatRate(rate(total, streamTime)),
+            "AsyncBufferedChannel (\(streamCapacity))": formatRate(rate(total, channelTime))
+        ])
+    }
+}
@@ -0,0 +1,147 @@
+//
+//  BatchBenchmark.swift
+//  Benchmarks
+//
+//  A data feed writing 2,500 updates per tick to 2,000 properties, with some written twice.
+//  200 group totals are bound to 10 properties each, and mirrored into a component that's rendered once per tick.
+//  The feed checks its group's total after each update, like an alarm would.
+//  Compared: every write applied as it comes (before), the writes in `Slint.batch`, and staged from a background thread.
+//  Runs entirely inside `start()`, with time advanced by hand.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// How often things happened. Only touched on the event loop.
+final class Counters {
+    var evaluations = 0
+    var redraws = 0
+}
+
+@main
+struct BatchBenchmark: SlintApp {
+    static let ticks = 100
+    static let sourceCount = 2_000
+    static let groupSize = 10
+    static let updatesPerTick = 2_500
+    static let gauges = 100
+
+    static func start() {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let window = SoftwareWindowAdapter(width: 480, height: 320, bufferAge: 1)
+        platform.nextWindow = window
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        instance.setSize(width: 480, height: 320)
+        instance.show()
+
+        let pixels = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: window.pixelCount)
+        defer { pixels.deallocate() }
+
+        let counters = Counters()
+        window.onRedrawRequested = { counters.redraws += 1 }
+
+        let sources = (0 ..< sourceCount).map { Property<Double>(Double($0)) }
+        let totals = (0 ..< sourceCount / groupSize).map { group in
+            let total = Property<Double>(0)
+            let members = sources[group * groupSize ..< (group + 1) * groupSize]
+            total.setBinding {
+                counters.evaluations += 1
+                return members.reduce(0) { $0 + $1.value }
+            }
+            return total
+        }
+
+        /// One update from the feed: set a source, check its group, and show the total.
+        func update(_ tick: Int, _ index: Int) {
+            let source = (index * 7_919) % sourceCount
+            let group = source / groupSize
+            sources[source].value = Double(tick * index)
+            if totals[group].value > 1e12 { print("alarm") }
+            instance.setProperty("v\(group % gauges)", .number(totals[group].value))
+        }
+
+        func endTick() {
+            // Everything's read once per tick, e.g. for a summary.
+            blackHole(totals.reduce(0) { $0 + $1.value })
+            platform.advance(by: 16)
+            _ = window.render(into: pixels)
+        }
+
+        func run(_ title: String, _ tick: (Int) -> Void) {
+            // Settle everything first, so each mode starts clean.
+            endTick()
+            counters.evaluations = 0
+            counters.redraws = 0
+
+            let elapsed = measure {
+                for index in 0 ..< ticks {
+                    tick(index)
+                    endTick()
+                }
+            }
+
+            report(title, [
+                "binding evaluations per tick": "\(counters.evaluations / ticks)",
+                "redraw requests per tick": String(format: "%.2f", Double(counters.redraws) / Double(ticks)),
+                "time per tick": formatDuration(elapsed / UInt64(ticks)),
+            ])
+        }
+
+        run("every write applied (before)") { tick in
+            for index in 0 ..< updatesPerTick { update(tick, index) }
+        }
+
+        run("Slint.batch") { tick in
+            Slint.batch {
+                for index in 0 ..< updatesPerTick { update(tick, index) }
+            }
+        }
+
+        run("staged from a background thread") { tick in
+            let done = DispatchSemaphore(value: 0)
+            Thread {
+                for index in 0 ..< updatesPerTick {
+                    let source = (index * 7_919) % sourceCount
+                    Slint.stage(sources[source], Double(tick * index))
+                }
+                done.signal()
+            }.start()
+            done.wait()
+            Slint.flushStagedWrites()
+
+            // The feed's checks, and the component, once the writes are in.
+            Slint.batch {
+                for (group, total) in totals.enumerated() {
+                    if total.value > 1e12 { print("alarm") }
+                    instance.setProperty("v\(group % gauges)", .number(total.value))
+                }
+            }
+        }
+
+        exit(0)
+    }
+
+    /// A row of gauges, one per property.
+    static let source: String = {
+        let properties = (0 ..< gauges).map { "in property <float> v\($0): 0;" }.joined(separator: "\n    ")
+        let bars = (0 ..< gauges).map { index in
+            "Rectangle { x: \(index % 20) * 24px; y: \(index / 20) * 64px; width: 20px; height: clamp(root.v\(index) / 1e6, 0, 1) * 60px; background: #40c080; }"
+        }.joined(separator: "\n    ")
+        return """
+            export component Gauges inherits Window {
+                \(properties)
+                background: #181818;
+                \(bars)
+            }
+            """
+    }()
+}
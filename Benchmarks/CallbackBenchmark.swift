@@ -0,0 +1,114 @@
+//
+//  CallbackBenchmark.swift
+//  Benchmarks
+//
+//  Calls per second through `SlintCallback.invoke`, against a copy of the original invocation path:
+//  a heap allocation for the return value, and a type-erased closure in the handler.
+//  Runs entirely inside `start()`. Callbacks don't need the event loop.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// The original handler wrapper: a closure that captures both generic types, and copies the argument out.
+final class LegacyCallbackWrapper {
+    let invoke: (UnsafeRawPointer?, UnsafeMutableRawPointer?) -> Void
+
+    init<Arg, Ret>(_ closure: @escaping (Arg) -> Ret) {
+        invoke = { argPtr, retPtr in
+            let arg = argPtr!.assumingMemoryBound(to: Arg.self).pointee
+            retPtr!.assumingMemoryBound(to: Ret.self).initialize(to: closure(arg))
+        }
+    }
+
+    static let bindingCallback: @convention(c) (UnsafeMutableRawPointer?, UnsafeRawPointer?, UnsafeMutableRawPointer?) -> Void = {
+        userDataPtr, argPtr, retPtr in
+        Unmanaged<LegacyCallbackWrapper>.fromOpaque(userDataPtr!).takeUnretainedValue().invoke(argPtr, retPtr)
+    }
+
+    static let dropCallback: @convention(c) (UnsafeMutableRawPointer?) -> Void = { userDataPtr in
+        Unmanaged<LegacyCallbackWrapper>.fromOpaque(userDataPtr!).release()
+    }
+}
+
+/// The original invocation path. The handle is heap allocated, otherwise setting the handler crashes.
+final class LegacyCallback<Arg, Ret> {
+    private let handle: UnsafeMutablePointer<CallbackOpaque>
+
+    init(_ closure: @escaping (Arg) -> Ret) {
+        handle = .allocate(capacity: 1)
+        handle.initialize(to: CallbackOpaque())
+        slint_callback_init(handle)
+
+        let wrapper = LegacyCallbackWrapper(closure)
+        slint_callback_set_handler(
+            handle,
+            LegacyCallbackWrapper.bindingCallback,
+            Unmanaged.passRetained(wrapper).toOpaque(),
+            LegacyCallbackWrapper.dropCallback
+        )
+    }
+
+    deinit {
+        slint_callback_drop(handle)
+        handle.deallocate()
+    }
+
+    func invoke(_ arg: Arg) -> Ret {
+        let retUnsafe = UnsafeMutableRawPointer.allocate(
+            byteCount: MemoryLayout<Ret>.size,
+            alignment: MemoryLayout<Ret>.alignment
+        )
+        defer { retUnsafe.deallocate() }
+
+        withUnsafePointer(to: arg) { argUnsafe in
+            slint_callback_call(handle, argUnsafe, retUnsafe)
+        }
+
+        return retUnsafe.assumingMemoryBound(to: Ret.self).pointee
+    }
+}
+
+@main
+struct CallbackBenchmark: SlintApp {
+    static let calls = 2_000_000
+
+    static func start() {
+        compare("Int32 -> Int32", 1 as Int32) { (x: Int32) in x &+ 1 }
+        compare("(Float, Float) -> Float", (1.5 as Float, 2.5 as Float)) { (pair: (Float, Float)) in pair.0 * pair.1 }
+        compare("Bool -> Bool", true) { (b: Bool) in !b }
+        compare("String -> Int32 (non-trivial)", "hello") { (s: String) in Int32(truncatingIfNeeded: s.utf8.count) }
+
+        exit(0)
+    }
+
+    /// Run both paths with the same handler and argument.
+    @SlintActor
+    static func compare<Arg, Ret>(_ title: String, _ arg: Arg, _ handler: @escaping @Sendable (Arg) -> Ret) {
+        let legacy = LegacyCallback<Arg, Ret>(handler)
+        let callback = SlintCallback<Arg, Ret>(handler)
+
+        // Warm up both.
+        for _ in 0 ..< 1_000 {
+            _ = legacy.invoke(arg)
+            _ = callback.invoke(arg)
+        }
+
+        let legacyTime = measure {
+            for _ in 0 ..< calls { blackHole(legacy.invoke(arg)) }
+        }
+
+        let time = measure {
+            for _ in 0 ..< calls { blackHole(callback.invoke(arg)) }
+        }
+
+        report(title, [
+            "calls": "\(calls)",
+            "before": formatRate(rate(calls, legacyTime)),
+            "after": formatRate(rate(calls, time)),
+            "speedup": String(format: "%.2fx", Double(legacyTime) / Double(max(time, 1))),
+        ])
+    }
+}
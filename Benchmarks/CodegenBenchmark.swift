@@ -0,0 +1,73 @@
+//
+//  CodegenBenchmark.swift
+//  Benchmarks
+//
+//  1M property sets, and 1M gets, on `Gauge.slint`: a number, and a string from a set of 8.
+//  Compared: string-keyed `setProperty(_:_:)` and `subscript(property:)`, through `SlintValue` (before),
+//  and the accessors `SlintCodegen` generated into `Gauge+Slint.swift`.
+//  Both paths make one interpreter value per set, because that's what Slint's API takes. Allocations are only counted on Linux.
+//  Runs entirely inside `start()`.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct CodegenBenchmark: SlintApp {
+    static let operations = 1_000_000
+
+    static let labels: [SharedString] = ["RPM", "Speed", "Boost", "Oil", "Coolant", "Fuel", "Battery", "Intake"]
+
+    static func start() {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        platform.nextWindow = SoftwareWindowAdapter(width: 240, height: 80, bufferAge: 1)
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromPath: Gauge.sourcePath).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        let gauge = Gauge(instance)
+
+        run("number sets: setProperty (before)") { index in
+            instance.setProperty("value", .number(Double(index)))
+        }
+        run("number sets: generated") { index in
+            gauge.value = Double(index)
+        }
+
+        run("string sets: setProperty (before)") { index in
+            instance.setProperty("label", .string(labels[index % labels.count]))
+        }
+        run("string sets: generated") { index in
+            gauge.label = labels[index % labels.count]
+        }
+
+        run("number gets: subscript (before)") { _ in
+            blackHole(instance[property: "value"]?.number)
+        }
+        run("number gets: generated") { _ in
+            blackHole(gauge.value)
+        }
+
+        exit(0)
+    }
+
+    static func run(_ title: String, _ body: (Int) -> Void) {
+        var elapsed: UInt64 = 0
+        let allocations = countAllocations {
+            elapsed = measure {
+                for index in 0 ..< operations { body(index) }
+            }
+        }
+
+        report(title, [
+            "allocations per op": allocations.map { String(format: "%.2f", Double($0) / Double(operations)) } ?? "n/a",
+            "ops/sec": formatRate(rate(operations, elapsed)),
+        ])
+    }
+}
@@ -0,0 +1,84 @@
+//
+//  ComputedBenchmark.swift
+//  Benchmarks
+//
+//  A parts list of 5,000 rows, filtered by a search query, sorted, and formatted for display, read once per frame.
+//  Meanwhile, a clock property ticks every frame, the query changes every 30 frames, and a row's stock changes every 10.
+//  Compared: deriving the list every frame (before), and caching it in a `SlintComputed`.
+//  Runs entirely inside `start()`. Properties don't need the event loop.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+struct Part {
+    var name: String
+    var stock: Int32
+}
+
+@main
+struct ComputedBenchmark: SlintApp {
+    static let frames = 600
+    static let rows = 5_000
+    static let queries = ["bolt", "nut", "washer", "m3", "m4", ""]
+
+    static func start() {
+        let parts = Property<[Part]>((0 ..< rows).map { index in
+            let kind = ["bolt", "nut", "washer", "screw"][index % 4]
+            return Part(name: "\(kind) m\(3 + index % 5) #\(index)", stock: Int32(index % 97))
+        })
+        let query = Property<String>("")
+        let clock = Property<Int32>(0)
+
+        /// The expensive part: filter, sort, format.
+        func derive() -> [String] {
+            let search = query.value
+            return parts.value
+                .filter { search.isEmpty || $0.name.contains(search) }
+                .sorted { $0.stock > $1.stock }
+                .map { "\($0.name): \($0.stock) in stock" }
+        }
+
+        /// What changes on each frame.
+        func update(_ frame: Int) {
+            clock.value = Int32(frame)
+            if frame % 30 == 0 { query.value = queries[(frame / 30) % queries.count] }
+            if frame % 10 == 0 { parts.value[frame % rows].stock += 1 }
+        }
+
+        var recomputations = 0
+        let before = measure {
+            for frame in 0 ..< frames {
+                update(frame)
+                blackHole(derive())
+                recomputations += 1
+                blackHole(clock.value)
+            }
+        }
+        report("derived every frame (before)", [
+            "recomputations": "\(recomputations)",
+            "time per frame": formatDuration(before / UInt64(frames)),
+        ])
+
+        // Start over, from the same state.
+        query.value = ""
+        clock.value = 0
+        let visible = SlintComputed(derive)
+        let after = measure {
+            for frame in 0 ..< frames {
+                update(frame)
+                blackHole(visible.value)
+                blackHole(clock.value)
+            }
+        }
+        report("SlintComputed", [
+            "recomputations": "\(visible.recomputations)",
+            "time per frame": formatDuration(after / UInt64(frames)),
+            "speedup": String(format: "%.1fx", Double(before) / Double(after)),
+        ])
+
+        exit(0)
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  DiffBenchmark.swift
+//  Benchmarks
+//
+//  An alarm table of 1k, 10k, and 100k rows, sorted by severity, updated by a feed: each update, 1% of alarms change severity,
+//  and so move, 0.5% clear, and 0.5% are raised. Each update is a new snapshot of the whole table.
+//  Compared: swapping in the snapshot and resetting the model (before), and a `SlintDiffingModel`.
+//  Diff time is the diff alone, as it would run off the event loop. Apply time includes the rendered frame that follows.
+//  Runs entirely inside `start()`, with time advanced by hand, and the diff run inline.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+struct Alarm: Identifiable, Equatable, Sendable {
+    let id: Int
+    var severity: Int
+}
+
+@main
+struct DiffBenchmark: SlintApp {
+    static let sizes = [1_000, 10_000, 100_000]
+    static let updates = 50
+
+    static let source = """
+        import { ListView } from "std-widgets.slint";
+        export component AlarmTable inherits Window {
+            in property <[string]> alarms;
+            ListView {
+                for alarm in root.alarms: Text { text: alarm; height: 16px; }
+            }
+        }
+        """
+
+    static func start() {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let window = SoftwareWindowAdapter(width: 480, height: 800, bufferAge: 1)
+        platform.nextWindow = window
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        instance.setSize(width: 480, height: 800)
+        instance.show()
+
+        let pixels = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: window.pixelCount)
+        defer { pixels.deallocate() }
+
+        func frame() {
+            platform.advance(by: 16)
+            _ = window.render(into: pixels)
+        }
+
+        for size in sizes {
+            let snapshots = feed(size: size)
+            var materialized = 0
+            func makeValue(_ alarm: Alarm) -> SlintValue {
+                materialized += 1
+                return .string(SharedString("alarm \(alarm.id), severity \(alarm.severity)"))
+            }
+
+            // Before: every update resets, and Slint makes every visible row again.
+            let reset = SlintArrayModel(snapshots[0], makeValue)
+            instance.setProperty("alarms", .model(reset))
+            frame()
+            materialized = 0
+            let resetTime = measure {
+                for snapshot in snapshots.dropFirst() {
+                    reset.replaceAll(with: snapshot)
+                    frame()
+                }
+            }
+            report("\(size) rows, reset per update (before)", [
+                "notifications per update": "1",
+                "rows materialized per update": String(format: "%.1f", Double(materialized) / Double(updates)),
+                "apply time per update": formatDuration(resetTime / UInt64(updates)),
+            ])
+
+            // After: only what moved, cleared, or was raised.
+            let model = SlintDiffingModel(snapshots[0], makeValue)
+            instance.setProperty("alarms", .model(model))
+            frame()
+            materialized = 0
+            var diffTimes: [UInt64] = []
+            var notifications = 0
+            var applyTime: UInt64 = 0
+            for (old, new) in zip(snapshots, snapshots.dropFirst()) {
+                var diff: SnapshotDiff!
+                diffTimes.append(measure { diff = SnapshotDiff(from: old, to: new) })
+                notifications += diff.notificationCount
+                applyTime += measure {
+                    model.apply(diff, new)
+                    frame()
+                }
+            }
+            report("\(size) rows, SlintDiffingModel", [
+                "notifications per update": String(format: "%.1f", Double(notifications) / Double(updates)),
+                "rows materialized per update": String(format: "%.1f", Double(materialized) / Double(updates)),
+                "diff time p50": formatDuration(percentile(diffTimes, 50)),
+                "diff time p99": formatDuration(percentile(diffTimes, 99)),
+                "apply time per update": formatDuration(applyTime / UInt64(updates)),
+            ])
+        }
+
+        exit(0)
+    }
+
+    /// `updates + 1` snapshots, each sorted by severity, then id.
+    static func feed(size: Int) -> [[Alarm]] {
+        var generator = SystemRandomNumberGenerator()
+        var alarms = (0 ..< size).map { Alarm(id: $0, severity: Int.random(in: 0 ..< 5, using: &generator)) }
+        var nextID = size
+        func sorted() -> [Alarm] {
+            alarms.sorted { ($0.severity, $0.id) < ($1.severity, $1.id) }
+        }
+
+        var snapshots = [sorted()]
+        for _ in 0 ..< updates {
+            for _ in 0 ..< size / 100 {
+                alarms[Int.random(in: alarms.indices, using: &generator)].severity = Int.random(in: 0 ..< 5, using: &generator)
+            }
+            for _ in 0 ..< size / 200 {
+                alarms.remove(at: Int.random(in: alarms.indices, using: &generator))
+                alarms.append(Alarm(id: nextID, severity: Int.random(in: 0 ..< 5, using: &generator)))
+                nextID += 1
+            }
+            snapshots.append(sorted())
+        }
+        return snapshots
+    }
+}
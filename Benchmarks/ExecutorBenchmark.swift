@@ -0,0 +1,83 @@
+//
+//  ExecutorBenchmark.swift
+//  Benchmarks
+//
+//  Throughput and hop latency of `@SlintActor`, when many background tasks hop onto it at once.
+//  Runs the original one-event-per-job design, then the batched executor.
+//
+
+import Foundation
+
+@testable import SlintUI
+
+/// Collects hop latencies. Isolated, so recording is itself a hop.
+@SlintActor
+final class HopRecorder {
+    private(set) var latencies: [UInt64] = []
+
+    nonisolated init() { }
+
+    func reserve(_ count: Int) { latencies.reserveCapacity(count) }
+
+    func record(since start: UInt64) { latencies.append(monotonicNanoseconds() - start) }
+
+    func reset() { latencies.removeAll(keepingCapacity: true) }
+}
+
+@main
+struct ExecutorBenchmark: SlintApp {
+    /// Hops per burst.
+    static let hops = 10_000
+    /// Bursts per mode. The first one is a warm-up, and not counted.
+    static let bursts = 6
+
+    static func start() {
+        Task.detached {
+            await EventLoop.ready
+
+            await run(.perJob, "per-job events (original)")
+            await run(.batched, "batched executor")
+
+            exit(0)
+        }
+    }
+
+    static func run(_ mode: SlintEventLoopExecutor.Mode, _ title: String) async {
+        await { @SlintActor in SlintEventLoopExecutor.shared.mode = mode }()
+
+        let recorder = HopRecorder()
+        await recorder.reserve(hops * bursts)
+
+        var elapsed: UInt64 = 0
+
+        for burst in 0 ..< bursts {
+            let time = await measure {
+                await withTaskGroup(of: Void.self) { group in
+                    for _ in 0 ..< hops {
+                        group.addTask {
+                            let start = monotonicNanoseconds()
+                            await recorder.record(since: start)
+                        }
+                    }
+                }
+            }
+
+            if burst == 0 {
+                await recorder.reset()
+            } else {
+                elapsed += time
+            }
+        }
+
+        let latencies = await recorder.latencies
+        let counted = hops * (bursts - 1)
+
+        report(title, [
+            "hops": "\(counted)",
+            "throughput": formatRate(rate(counted, elapsed)),
+            "p50 hop": formatDuration(percentile(latencies, 50)),
+            "p99 hop": formatDuration(percentile(latencies, 99)),
+            "max hop": formatDuration(latencies.max() ?? 0),
+        ])
+    }
+}
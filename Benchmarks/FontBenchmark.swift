@@ -0,0 +1,117 @@
+//
+//  FontBenchmark.swift
+//  Benchmarks
+//
+//  A screen of text, at 5 sizes, rendered by the software renderer, 480×800, every pixel repainted each frame.
+//  Compared: the font file registered with `slint_register_font_from_path` (before), and the same font baked by `SlintFontBaker`,
+//  at the same sizes, registered with `slint_register_bitmap_font`. Which font is found when configuring; see `Benchmarks/CMakeLists.txt`.
+//  Each runs in its own process, so neither starts with the other's font, or glyphs, already loaded.
+//  Start to first frame includes compiling the screen, which is the same for both. Time is advanced by hand.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct FontBenchmark: SlintApp {
+    static let frames = 300
+    /// The sizes `slint_swift_bake_font` is given.
+    static let sizes = [12, 14, 16, 20, 24]
+
+    static let lines = [
+        "The quick brown fox jumps over the lazy dog.",
+        "Pack my box with five dozen liquor jugs.",
+        "Sphinx of black quartz, judge my vow!",
+        "0123456789 +-*/=%()[]{}<>",
+    ]
+
+    static func start() {
+        switch CommandLine.arguments.dropFirst().first {
+        case "ttf":
+            run(baked: false)
+        case "baked":
+            run(baked: true)
+        default:
+            spawn("ttf")
+            spawn("baked")
+            exit(0)
+        }
+    }
+
+    static func run(baked: Bool) {
+        let started = monotonicNanoseconds()
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let window = SoftwareWindowAdapter(width: 480, height: 800)
+        platform.nextWindow = window
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source(family: BenchmarkFont.font.familyName)).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        instance.setSize(width: 480, height: 800)
+        instance.show()
+
+        let registerTime = measure {
+            if baked {
+                instance.register(BenchmarkFont.font)
+            } else {
+                do {
+                    try instance.registerFont(fromPath: BenchmarkFont.sourcePath)
+                } catch {
+                    print(error)
+                    exit(1)
+                }
+            }
+        }
+
+        let pixels = UnsafeMutableBufferPointer<Rgb8Pixel>.allocate(capacity: window.pixelCount)
+        defer { pixels.deallocate() }
+
+        let firstFrame = measure { window.render(into: pixels) }
+        let startToFirstFrame = monotonicNanoseconds() - started
+
+        var samples: [UInt64] = []
+        samples.reserveCapacity(frames)
+        for frame in 0 ..< frames {
+            instance.setProperty("frame", .number(Double(frame)))
+            platform.advance(by: 16)
+            samples.append(measure { window.render(into: pixels) })
+        }
+
+        let title = baked
+            ? "baked, \(BenchmarkFont.font.pixelSizes.count) sizes, \(BenchmarkFont.font.characterCount) characters"
+            : "slint_register_font_from_path (before)"
+        report("\(title): \(BenchmarkFont.font.familyName)", [
+            "register": formatDuration(registerTime),
+            "first frame": formatDuration(firstFrame),
+            "start to first frame": formatDuration(startToFirstFrame),
+            "frame p50": formatDuration(percentile(samples, 50)),
+            "frame p99": formatDuration(percentile(samples, 99)),
+            "peak RSS": formatBytes(peakResidentBytes()),
+        ])
+        exit(0)
+    }
+
+    /// Rows of text, cycling through the sizes, and a frame counter, so each frame has new text to lay out.
+    static func source(family: String) -> String {
+        let rows = (0 ..< 36).map { row in
+            "        Text { text: \"\(lines[row % lines.count])\"; font-size: \(sizes[row % sizes.count])px; }"
+        }.joined(separator: "\n")
+
+        return """
+            export component Screen inherits Window {
+                in property <int> frame;
+                default-font-family: "\(family)";
+                VerticalLayout {
+                    Text { text: "Frame \\{root.frame}"; font-size: 24px; }
+            \(rows)
+                }
+            }
+            """
+    }
+}
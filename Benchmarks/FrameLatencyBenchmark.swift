@@ -0,0 +1,133 @@
+//
+//  FrameLatencyBenchmark.swift
+//  Benchmarks
+//
+//  Frame pacing while the application does CPU-bound work, in 20ms chunks.
+//  A 16ms timer renders a frame; the gaps between frames are what a user would see.
+//  With the loop on the main thread, the main actor is blocked, so the work has to run on `SlintActor`, between frames.
+//  With a dedicated loop thread, it runs on the main actor, alongside.
+//  Each mode runs in its own process. Run with no arguments for both, or with `main` or `dedicated` for one.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// Frame gaps. Isolated, so it can only be touched from the event loop.
+@SlintActor
+final class FrameRecorder {
+    private(set) var gaps: [UInt64] = []
+    private(set) var frames = 0
+    private var last: UInt64?
+
+    nonisolated init() { }
+
+    func frame() {
+        frames += 1
+        let time = monotonicNanoseconds()
+        if let last { gaps.append(time - last) }
+        last = time
+    }
+}
+
+@main
+struct FrameLatencyBenchmark: SlintApp {
+    static let frameInterval: UInt64 = 16
+    static let chunks = 150
+    static let chunkNanoseconds: UInt64 = 20_000_000
+
+    static var eventLoopThread: SlintEventLoopThread {
+        CommandLine.arguments.dropFirst().first == "dedicated" ? .dedicated : .main
+    }
+
+    static let source = """
+        export component Spinner inherits Window {
+            in property <int> tick: 0;
+            background: #202020;
+            Rectangle {
+                x: mod(root.tick * 4, 280) * 1px;
+                y: 100px;
+                width: 40px;
+                height: 40px;
+                background: #40c080;
+            }
+            Text { text: "Frame \\(root.tick)"; color: white; }
+        }
+        """
+
+    static func start() {
+        let mode = CommandLine.arguments.dropFirst().first
+        guard mode == "main" || mode == "dedicated" else {
+            spawn("main")
+            spawn("dedicated")
+            exit(0)
+        }
+
+        let platform = HeadlessPlatform.install()
+        let window = SoftwareWindowAdapter(width: 320, height: 240, bufferAge: 1)
+        platform.nextWindow = window
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        instance.setSize(width: 320, height: 240)
+        instance.show()
+
+        let pixels = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: window.pixelCount)
+        let recorder = FrameRecorder()
+
+        let timer = SlintTimer()
+        timer.willRun(every: frameInterval) {
+            instance.setProperty("tick", .number(Double(recorder.frames)))
+            _ = window.render(into: pixels)
+            recorder.frame()
+        }
+
+        Task.detached {
+            await EventLoop.ready
+            let elapsed: UInt64
+            if eventLoopThread == .dedicated {
+                elapsed = await work { @MainActor in burn(chunkNanoseconds) }
+            } else {
+                elapsed = await work { @SlintActor in burn(chunkNanoseconds) }
+            }
+
+            let gaps = await recorder.gaps
+            let janky = gaps.filter { $0 > 2 * frameInterval * 1_000_000 }.count
+            report(eventLoopThread == .dedicated ? "dedicated loop thread, work on the main actor" : "loop on the main thread, work on SlintActor (before)", [
+                "frames": "\(await recorder.frames)",
+                "p50 frame gap": formatDuration(percentile(gaps, 50)),
+                "p99 frame gap": formatDuration(percentile(gaps, 99)),
+                "max frame gap": formatDuration(gaps.max() ?? 0),
+                "gaps over 2 frames": "\(janky)",
+                "work time": formatDuration(elapsed),
+            ])
+            exit(0)
+        }
+    }
+
+    /// Run the work, a chunk at a time, yielding between chunks.
+    static func work(_ chunk: @escaping @Sendable () async -> Void) async -> UInt64 {
+        await measure {
+            for _ in 0 ..< chunks {
+                await chunk()
+                await Task.yield()
+            }
+        }
+    }
+}
+
+/// Keep a core busy for a while.
+func burn(_ nanoseconds: UInt64) {
+    let deadline = monotonicNanoseconds() + nanoseconds
+    var state: UInt64 = 0x9e37_79b9_7f4a_7c15
+    while monotonicNanoseconds() < deadline {
+        for _ in 0 ..< 1_000 { state = state &* 6_364_136_223_846_793_005 &+ 1 }
+    }
+    blackHole(state)
+}
@@ -0,0 +1,141 @@
+//
+//  ImageCacheBenchmark.swift
+//  Benchmarks
+//
+//  A gallery of 1,000 photos, 480×360 PNGs, shown as 120×90 thumbnails, 40 on screen.
+//  It scrolls to the bottom and back, half a screen at a time, without waiting for the last screen to finish.
+//  Compared: decoding and scaling on the event loop, as each image scrolls into view (before), and `ImageCache`, with a 16 MiB budget.
+//  Event loop blocking is the time its executor jobs took, from `SlintTracing`. Peak RSS only ever grows, so the cache's includes the inline run's.
+//
+
+import Foundation
+
+import BenchmarkPNG
+@testable import SlintUI
+
+@main
+struct ImageCacheBenchmark: SlintApp {
+    static let images = 1_000
+    static let photo = (width: 480, height: 360)
+    static let thumbnail = (width: 120, height: 90)
+    /// Thumbnails on screen at once.
+    static let visible = 40
+    static let byteBudget = 16 << 20
+
+    static func start() {
+        // Every job is traced. Enough room that none are dropped.
+        SlintTracing.bufferCapacity = 1 << 20
+
+        let directory = URL(fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent("ImageCacheBenchmark-\(getpid())")
+        let paths = writeGallery(to: directory)
+
+        Task.detached {
+            await EventLoop.ready
+            await run(screens(paths))
+            try? FileManager.default.removeItem(at: directory)
+            exit(0)
+        }
+    }
+
+    /// Down to the bottom, and back to the top, half a screen at a time.
+    static func screens(_ paths: [String]) -> [ArraySlice<String>] {
+        let starts = Array(stride(from: 0, through: paths.count - visible, by: visible / 2))
+        return (starts + starts.reversed()).map { paths[$0 ..< $0 + visible] }
+    }
+
+    @SlintActor
+    static func run(_ screens: [ArraySlice<String>]) async {
+        let title = "\(images) images, \(screens.count) screens of \(visible)"
+        SlintTracing.start()
+
+        // Before: each screen is one job, which decodes and scales every image on it.
+        SlintTracing.reset()
+        let inlineTime = await measure {
+            for screen in screens {
+                await Task.yield()
+                for path in screen {
+                    let data = FileManager.default.contents(atPath: path)!
+                    let pixels = SlintPixelBuffer(decoding: data)!.scaled(toFit: thumbnail.width, thumbnail.height)
+                    blackHole(SlintValue.image(pixels))
+                }
+            }
+        }
+        let inlineJobs = SlintTracing.summary()[.executorJob]
+        report("\(title), on the event loop (before)", [
+            "total": formatDuration(inlineTime),
+            "event loop blocked": formatDuration(inlineJobs?.total ?? 0),
+            "longest job": formatDuration(inlineJobs?.max ?? 0),
+            "p99 job": formatDuration(inlineJobs?.p99 ?? 0),
+            "peak RSS": formatBytes(peakResidentBytes()),
+        ])
+
+        let cache = ImageCache(byteBudget: byteBudget)
+        SlintTracing.reset()
+        let cachedTime = await measure {
+            var previous: Task<Void, Never>?
+            for screen in screens {
+                // Scrolling on before the last screen's done, so the half they share is requested twice.
+                let current = Task { @SlintActor in
+                    await withTaskGroup(of: SlintPixelBuffer?.self) { group in
+                        for path in screen {
+                            group.addTask { try? await cache.pixels(atPath: path, maxWidth: thumbnail.width, maxHeight: thumbnail.height) }
+                        }
+                        for await pixels in group {
+                            if let pixels { blackHole(SlintValue.image(pixels)) }
+                        }
+                    }
+                }
+                await previous?.value
+                previous = current
+            }
+            await previous?.value
+        }
+        let cachedJobs = SlintTracing.summary()[.executorJob]
+        SlintTracing.stop()
+
+        let statistics = cache.statistics
+        report("\(title), ImageCache, \(formatBytes(byteBudget)) budget", [
+            "total": formatDuration(cachedTime),
+            "event loop blocked": formatDuration(cachedJobs?.total ?? 0),
+            "longest job": formatDuration(cachedJobs?.max ?? 0),
+            "p99 job": formatDuration(cachedJobs?.p99 ?? 0),
+            "hits": "\(statistics.hits)",
+            "misses": "\(statistics.misses)",
+            "deduplicated": "\(statistics.deduplicated)",
+            "evictions": "\(statistics.evictions)",
+            "decode time, on workers": formatDuration(statistics.decodeNanoseconds),
+            "resident, peak": "\(formatBytes(cache.residentBytes)), \(formatBytes(statistics.peakResidentBytes))",
+            "peak RSS": formatBytes(peakResidentBytes()),
+        ])
+    }
+
+    /// Gradients, with a pattern that changes per image, so no two are alike.
+    static func writeGallery(to directory: URL) -> [String] {
+        try! FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        let pixels = SlintPixelBuffer(width: photo.width, height: photo.height)
+        return (0 ..< images).map { index in
+            pixels.withUnsafeMutableBytes { bytes in
+                for y in 0 ..< photo.height {
+                    for x in 0 ..< photo.width {
+                        let offset = (y * photo.width + x) * 4
+                        bytes[offset] = UInt8(x * 255 / photo.width)
+                        bytes[offset + 1] = UInt8(y * 255 / photo.height)
+                        bytes[offset + 2] = UInt8(truncatingIfNeeded: (x ^ y) &+ index)
+                        bytes[offset + 3] = 255
+                    }
+                }
+            }
+
+            let path = directory.appendingPathComponent("photo-\(index).png").path
+            var image = png_image()
+            image.version = UInt32(PNG_IMAGE_VERSION)
+            image.width = UInt32(photo.width)
+            image.height = UInt32(photo.height)
+            image.format = UInt32(PNG_FORMAT_RGBA)
+            let written = pixels.withUnsafeBytes { png_image_write_to_file(&image, path, 0, $0.baseAddress, 0, nil) }
+            precondition(written != 0, "Couldn't write \(path)")
+            return path
+        }
+    }
+}
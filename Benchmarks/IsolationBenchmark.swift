@@ -0,0 +1,101 @@
+//
+//  IsolationBenchmark.swift
+//  Benchmarks
+//
+//  Latency from asking for work on the event loop, to it running.
+//  `SlintActor.dispatch` from the event loop thread runs inline. Compared against posting a `WrappedClosure`
+//  from the same thread, which is what code had to do before, and against `dispatch` from a background thread.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// Collects latencies. Isolated, so it can only be touched from the event loop.
+@SlintActor
+final class LatencyRecorder {
+    private(set) var latencies: [UInt64] = []
+    private var expected = 0
+    private var done: AsyncChannel<Void>?
+
+    nonisolated init() { }
+
+    /// Reset, and get a channel that's sent once `count` latencies are recorded.
+    func expect(_ count: Int) -> AsyncChannel<Void> {
+        latencies.removeAll(keepingCapacity: true)
+        latencies.reserveCapacity(count)
+        expected = count
+        let channel = AsyncChannel(Void.self)
+        done = channel
+        return channel
+    }
+
+    func record(since start: UInt64) {
+        latencies.append(monotonicNanoseconds() - start)
+        if latencies.count == expected { done?.send() }
+    }
+}
+
+@main
+struct IsolationBenchmark: SlintApp {
+    static let count = 100_000
+
+    static func start() {
+        Task.detached {
+            await EventLoop.ready
+
+            let recorder = LatencyRecorder()
+
+            // Inline: runs before `dispatch` returns.
+            let inlineTime = await { @SlintActor in
+                _ = recorder.expect(count)
+                return measure {
+                    for _ in 0 ..< count {
+                        let start = monotonicNanoseconds()
+                        SlintActor.dispatch { recorder.record(since: start) }
+                    }
+                }
+            }()
+            await summarize("inline dispatch, on the event loop", recorder, inlineTime)
+
+            // Posted from the event loop thread, like code had to before.
+            let postedDone = await recorder.expect(count)
+            let postedTime = await measure {
+                await { @SlintActor in
+                    for _ in 0 ..< count {
+                        let start = monotonicNanoseconds()
+                        let wrapper = WrappedClosure { recorder.record(since: start) }
+                        slint_post_event(WrappedClosure.invokeCallback, wrapper.getRetainedPointer(), WrappedClosure.dropCallback)
+                    }
+                }()
+                try? await postedDone.value
+            }
+            await summarize("posted WrappedClosure, on the event loop (before)", recorder, postedTime)
+
+            // Dispatched from a background thread, so it can't run inline.
+            let backgroundDone = await recorder.expect(count)
+            let backgroundTime = await measure {
+                for _ in 0 ..< count {
+                    let start = monotonicNanoseconds()
+                    SlintActor.dispatch { recorder.record(since: start) }
+                }
+                try? await backgroundDone.value
+            }
+            await summarize("dispatch from a background thread", recorder, backgroundTime)
+
+            exit(0)
+        }
+    }
+
+    static func summarize(_ title: String, _ recorder: LatencyRecorder, _ elapsed: UInt64) async {
+        let latencies = await recorder.latencies
+        report(title, [
+            "calls": "\(latencies.count)",
+            "throughput": formatRate(rate(latencies.count, elapsed)),
+            "p50 latency": formatDuration(percentile(latencies, 50)),
+            "p99 latency": formatDuration(percentile(latencies, 99)),
+            "max latency": formatDuration(latencies.max() ?? 0),
+        ])
+    }
+}
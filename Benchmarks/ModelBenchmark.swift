@@ -0,0 +1,108 @@
+//
+//  ModelBenchmark.swift
+//  Benchmarks
+//
+//  A log view: a `ListView` showing about 50 of 10k, 100k, and 1M rows, with new entries inserted at the top.
+//  Compared: rebuilding an array model of every row on each insert (before), and a `SlintArrayModel`, which notifies one added row.
+//  Each insert is followed by a rendered frame. Rows materialized counts `SlintValue`s made for Slint.
+//  Runs entirely inside `start()`, with time advanced by hand.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct ModelBenchmark: SlintApp {
+    static let sizes = [10_000, 100_000, 1_000_000]
+    static let rebuildInserts = 5
+    static let modelInserts = 200
+
+    static let source = """
+        import { ListView } from "std-widgets.slint";
+        export component LogView inherits Window {
+            in property <[string]> entries;
+            ListView {
+                for entry in root.entries: Text { text: entry; height: 16px; }
+            }
+        }
+        """
+
+    static func start() {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let window = SoftwareWindowAdapter(width: 480, height: 800, bufferAge: 1)
+        platform.nextWindow = window
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+        instance.setSize(width: 480, height: 800)
+        instance.show()
+
+        let pixels = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: window.pixelCount)
+        defer { pixels.deallocate() }
+
+        func frame() {
+            platform.advance(by: 16)
+            _ = window.render(into: pixels)
+        }
+
+        for size in sizes {
+            var entries = (0 ..< size).map { "entry \($0)" }
+
+            // Before: every insert makes a value of every row.
+            var materialized = 0
+            let rebuild = measure {
+                for insert in 0 ..< rebuildInserts {
+                    entries.insert("new entry \(insert)", at: 0)
+                    instance.setProperty("entries", arrayModel(of: entries))
+                    materialized += entries.count
+                    frame()
+                }
+            }
+            report("\(size) rows, array model rebuilt per insert (before)", [
+                "rows materialized per insert": "\(materialized / rebuildInserts)",
+                "time per insert": formatDuration(rebuild / UInt64(rebuildInserts)),
+            ])
+
+            // After: Slint reads the rows it shows, and hears about the one that's new.
+            materialized = 0
+            let model = SlintArrayModel(entries) { entry -> SlintValue in
+                materialized += 1
+                return .string(SharedString(entry))
+            }
+            instance.setProperty("entries", .model(model))
+            frame()
+            materialized = 0
+
+            let incremental = measure {
+                for insert in 0 ..< modelInserts {
+                    model.insert("new entry \(insert)", at: 0)
+                    frame()
+                }
+            }
+            report("\(size) rows, SlintArrayModel", [
+                "rows materialized per insert": String(format: "%.1f", Double(materialized) / Double(modelInserts)),
+                "time per insert": formatDuration(incremental / UInt64(modelInserts)),
+            ])
+        }
+
+        exit(0)
+    }
+
+    /// An array model of strings, the way it had to be done before: one boxed value per row, all up front.
+    static func arrayModel(of entries: [String]) -> SlintValue {
+        let boxes = SharedVector(entries.lazy.map { SlintValue.string(SharedString($0)).makeBox() })
+        let box = withUnsafePointer(to: boxes.storage.header) { header in
+            slint_interpreter_value_new_array_model(UnsafeRawPointer(header).assumingMemoryBound(to: ValueVector.self))
+        }
+        // Slint copies the values, so the boxes are still ours.
+        boxes.forEach { slint_interpreter_value_destructor($0) }
+        return .other(SlintValueBox(owning: box))
+    }
+}
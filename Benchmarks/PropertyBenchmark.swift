@@ -0,0 +1,144 @@
+//
+//  PropertyBenchmark.swift
+//  Benchmarks
+//
+//  Reads and binding evaluations per second through `Property<T>`.
+//  Reads are compared against the prototype's, which allocated a scratch buffer for every read.
+//  Runs entirely inside `start()`. Properties don't need the event loop.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct PropertyBenchmark: SlintApp {
+    static let reads = 10_000_000
+    static let evaluations = 1_000_000
+    static let chainLength = 16
+
+    static func start() {
+        compareReads()
+        measureReads(of: Property<Float>(1.5), "Float")
+        measureReads(of: Property<Bool>(true), "Bool")
+        measureReads(of: Property<String>("status: nominal"), "String")
+        measureBinding()
+        measureChain()
+        measureTwoWay()
+        exit(0)
+    }
+
+    /// `Int32` reads, now and like the prototype did them.
+    @SlintActor
+    static func compareReads() {
+        let property = Property<Int32>(42)
+
+        var sum: Int32 = 0
+        let before = measure {
+            for _ in 0 ..< reads {
+                // The prototype: a heap buffer per read, which Slint only writes to if the binding is dirty.
+                let scratch = UnsafeMutableRawPointer.allocate(byteCount: MemoryLayout<Int32>.size, alignment: MemoryLayout<Int32>.alignment)
+                scratch.storeBytes(of: property.valuePointer.pointee, as: Int32.self)
+                slint_property_update(property.handle, scratch)
+                sum &+= scratch.load(as: Int32.self)
+                scratch.deallocate()
+            }
+        }
+        blackHole(sum)
+
+        let after = measure {
+            for _ in 0 ..< reads { sum &+= property.value }
+        }
+        blackHole(sum)
+
+        report("Int32 reads", [
+            "scratch buffer per read (before)": formatRate(rate(reads, before)),
+            "inline storage": formatRate(rate(reads, after)),
+            "speedup": String(format: "%.1fx", Double(before) / Double(after)),
+        ])
+    }
+
+    @SlintActor
+    static func measureReads<T>(of property: Property<T>, _ name: String) {
+        let elapsed = measure {
+            for _ in 0 ..< reads { blackHole(property.value) }
+        }
+        report("\(name) reads", [
+            "reads/sec": formatRate(rate(reads, elapsed)),
+        ])
+    }
+
+    /// Set a source, read a property bound to it. Every read evaluates the binding once.
+    @SlintActor
+    static func measureBinding() {
+        let source = Property<Int32>(0)
+        let doubled = Property<Int32>(0)
+        doubled.setBinding { source.value &* 2 }
+
+        var sum: Int32 = 0
+        let elapsed = measure {
+            for index in 0 ..< Int32(evaluations) {
+                source.value = index
+                sum &+= doubled.value
+            }
+        }
+        blackHole(sum)
+
+        report("one binding", [
+            "bindings evaluated/sec": formatRate(rate(evaluations, elapsed)),
+            "time per set and read": formatDuration(elapsed / UInt64(evaluations)),
+        ])
+    }
+
+    /// A chain of bindings, each one more than the last. Setting the head dirties them all, reading the tail evaluates them all.
+    @SlintActor
+    static func measureChain() {
+        let head = Property<Int32>(0)
+        var chain = [head]
+        for _ in 1 ..< chainLength {
+            let previous = chain.last!
+            let next = Property<Int32>(0)
+            next.setBinding { previous.value &+ 1 }
+            chain.append(next)
+        }
+        let tail = chain.last!
+
+        let iterations = evaluations / chainLength
+        var sum: Int32 = 0
+        let elapsed = measure {
+            for index in 0 ..< Int32(iterations) {
+                head.value = index
+                sum &+= tail.value
+            }
+        }
+        blackHole(sum)
+
+        let evaluated = iterations * (chainLength - 1)
+        report("chain of \(chainLength) properties", [
+            "bindings evaluated/sec": formatRate(rate(evaluated, elapsed)),
+            "time per set and read": formatDuration(elapsed / UInt64(iterations)),
+        ])
+    }
+
+    /// Set one side of a two-way link, read the other.
+    @SlintActor
+    static func measureTwoWay() {
+        let first = Property<Int32>(0)
+        let second = Property<Int32>(0)
+        Property.linkTwoWay(first, second)
+
+        var sum: Int32 = 0
+        let elapsed = measure {
+            for index in 0 ..< Int32(evaluations) {
+                first.value = index
+                sum &+= second.value
+            }
+        }
+        blackHole(sum)
+
+        report("two-way link", [
+            "set and read/sec": formatRate(rate(evaluations, elapsed)),
+        ])
+    }
+}
@@ -0,0 +1,208 @@
+//
+//  RenderBenchmark.swift
+//  Benchmarks
+//
+//  Headless rendering with Slint's software renderer: no GPU, no display, like the embedded targets.
+//  Drives a few representative scenes through a fixed number of frames, at fixed sizes, in both pixel formats.
+//  Time is advanced by hand, 16ms a frame, so animations run the same every time.
+//  Runs entirely inside `start()`, before the event loop.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// A scene, and how to change it each frame.
+struct Scene {
+    let name: String
+    let source: String
+    let step: @SlintActor (SlintComponentInstance, Int) -> Void
+}
+
+@main
+struct RenderBenchmark: SlintApp {
+    static let frames = 300
+    static let sizes: [(width: UInt32, height: UInt32)] = [(320, 240), (800, 480)]
+
+    static let scenes = [
+        Scene(name: "long list", source: listScene) { instance, frame in
+            instance.setProperty("scroll", .number(Double(frame * 3)))
+        },
+        Scene(name: "animated gauges", source: gaugeScene) { instance, frame in
+            // A new target every 10 frames. The bars animate towards it in between.
+            if frame % 10 == 0 { instance.setProperty("target", .number(Double((frame * 37) % 100))) }
+        },
+        Scene(name: "text panel", source: textScene) { instance, frame in
+            instance.setProperty("counter", .number(Double(frame)))
+        },
+    ]
+
+    static func start() {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let compiler = SlintCompiler()
+
+        for scene in scenes {
+            let definition: ComponentDefinition
+            do {
+                definition = try compiler.build(fromSource: scene.source)
+            } catch {
+                print("\(scene.name): \(error)")
+                exit(1)
+            }
+
+            for size in sizes {
+                run(scene, definition, size, .rgb8, platform)
+                run(scene, definition, size, .rgb565, platform)
+            }
+        }
+
+        exit(0)
+    }
+
+    @SlintActor
+    static func run(
+        _ scene: Scene,
+        _ definition: ComponentDefinition,
+        _ size: (width: UInt32, height: UInt32),
+        _ format: SoftwareWindowAdapter.PixelFormat,
+        _ platform: HeadlessPlatform
+    ) {
+        // One buffer, reused, so Slint only repaints what changed.
+        let window = SoftwareWindowAdapter(width: size.width, height: size.height, bufferAge: 1)
+        platform.nextWindow = window
+        let instance = definition.create()
+        instance.setSize(width: size.width, height: size.height)
+        instance.show()
+
+        let pixels = window.pixelCount
+        let rgb8 = UnsafeMutableBufferPointer<Rgb8Pixel>.allocate(capacity: pixels)
+        let rgb565 = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: pixels)
+        defer {
+            rgb8.deallocate()
+            rgb565.deallocate()
+            instance.hide()
+        }
+
+        func frame() -> IntRect {
+            switch format {
+            case .rgb8: return window.render(into: rgb8)
+            case .rgb565: return window.render(into: rgb565)
+            }
+        }
+
+        // The first frame paints everything.
+        _ = frame()
+
+        var dirtyArea = 0
+        var largest = 0
+        let elapsed = measure {
+            for index in 0 ..< frames {
+                scene.step(instance, index)
+                platform.advance(by: 16)
+                let dirty = frame()
+                dirtyArea += dirty.area
+                largest = max(largest, dirty.area)
+            }
+        }
+
+        let averageArea = dirtyArea / frames
+        report("\(scene.name), \(size.width)×\(size.height), \(format)", [
+            "frames/sec": String(format: "%.1f", rate(frames, elapsed)),
+            "time per frame": formatDuration(elapsed / UInt64(frames)),
+            "dirty area per frame": "\(averageArea)px (\(String(format: "%.1f", 100 * Double(averageArea) / Double(pixels)))%)",
+            "largest dirty area": "\(largest)px",
+            "bytes touched per frame": formatBytes(averageArea * format.bytesPerPixel),
+        ])
+    }
+
+    // MARK: Scenes
+
+    /// 200 rows in a scroll view, scrolled a little each frame.
+    static let listScene = """
+        export component ListScene inherits Window {
+            in property <float> scroll: 0;
+            background: #202020;
+
+            Flickable {
+                viewport-y: -1px * mod(root.scroll, 200 * 32);
+                viewport-height: 200 * 32px;
+
+                for index in 200: Rectangle {
+                    y: index * 32px;
+                    height: 32px;
+                    background: mod(index, 2) == 0 ? #2c2c2c : #262626;
+
+                    Text {
+                        x: 12px;
+                        text: "Row \\(index): device status and last reading";
+                        color: #e0e0e0;
+                        vertical-alignment: center;
+                    }
+                }
+            }
+        }
+        """
+
+    /// Six bar gauges that animate towards a shared target, with readouts.
+    static let gaugeScene = """
+        component Gauge inherits Rectangle {
+            in property <float> value;
+            in property <string> label;
+            background: #303030;
+            border-radius: 6px;
+
+            Rectangle {
+                x: 4px;
+                y: 4px;
+                height: parent.height - 8px;
+                width: (parent.width - 8px) * clamp(root.value, 0, 100) / 100;
+                background: root.value > 80 ? #e04040 : #40c080;
+                border-radius: 4px;
+            }
+
+            Text {
+                text: "\\(root.label): \\(round(root.value))%";
+                color: white;
+                horizontal-alignment: center;
+                vertical-alignment: center;
+            }
+        }
+
+        export component GaugeScene inherits Window {
+            in property <float> target: 0;
+            background: #181818;
+
+            VerticalLayout {
+                padding: 12px;
+                spacing: 8px;
+
+                for index in 6: Gauge {
+                    label: "Channel \\(index + 1)";
+                    value: mod(root.target + index * 13, 100);
+                    animate value { duration: 150ms; easing: ease-in-out; }
+                }
+            }
+        }
+        """
+
+    /// A page of static text, with a counter that changes every frame.
+    static let textScene = """
+        export component TextScene inherits Window {
+            in property <int> counter: 0;
+            background: white;
+
+            VerticalLayout {
+                padding: 8px;
+
+                Text { text: "Frame \\(root.counter)"; font-size: 20px; color: black; }
+
+                for index in 24: Text {
+                    text: "Line \\(index): The quick brown fox jumps over the lazy dog. 0123456789";
+                    color: #333333;
+                    wrap: word-wrap;
+                }
+            }
+        }
+        """
+}
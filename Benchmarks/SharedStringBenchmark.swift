@@ -0,0 +1,70 @@
+//
+//  SharedStringBenchmark.swift
+//  Benchmarks
+//
+//  Heap allocations and time for 1M label reads, and 1M label writes, from a set of 12 labels, short and long.
+//  Reads and writes are compared against the prototype's: `String(cString:)` per read, and `utf8CString` per write.
+//  Runs entirely inside `start()`. Allocations are only counted on Linux.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct SharedStringBenchmark: SlintApp {
+    static let operations = 1_000_000
+
+    static let labels = [
+        "OK", "Ready", "Charging", "84%", "Idle", "12:45",
+        "Battery temperature nominal", "Connected to gateway 192.168.0.12", "Firmware update available",
+        "Fan speed: automatic", "Last sync 4 minutes ago", "Tap to dismiss this notification",
+    ]
+
+    static func start() {
+        let shared = labels.map { SharedString($0) }
+
+        run("reads: String(cString:) (before)") { index in
+            let label = shared[index % shared.count]
+            blackHole(withUnsafePointer(to: label) { String(cString: slint_shared_string_bytes($0)!) })
+        }
+        run("reads: string") { index in
+            blackHole(shared[index % shared.count].string)
+        }
+        run("reads: withUTF8") { index in
+            blackHole(shared[index % shared.count].withUTF8 { $0.last })
+        }
+        run("reads: utf8 view, compared with a Swift string") { index in
+            blackHole(shared[index % shared.count].utf8.elementsEqual(labels[index % labels.count].utf8))
+        }
+
+        run("writes: utf8CString and withCString (before)") { index in
+            let label = labels[index % labels.count]
+            let length = label.utf8CString.count - 1
+            blackHole(label.withCString { slint_shared_string_from_utf8($0, length) })
+        }
+        run("writes: SharedString(_:)") { index in
+            blackHole(SharedString(labels[index % labels.count]))
+        }
+        run("writes: SharedString.interned(_:)") { index in
+            blackHole(SharedString.interned(labels[index % labels.count]))
+        }
+
+        exit(0)
+    }
+
+    static func run(_ title: String, _ body: (Int) -> Void) {
+        var elapsed: UInt64 = 0
+        let allocations = countAllocations {
+            elapsed = measure {
+                for index in 0 ..< operations { body(index) }
+            }
+        }
+
+        report(title, [
+            "allocations per 1M": allocations.map { "\($0 * 1_000_000 / operations)" } ?? "n/a",
+            "ops/sec": formatRate(rate(operations, elapsed)),
+        ])
+    }
+}
@@ -0,0 +1,114 @@
+//
+//  SharedVectorBenchmark.swift
+//  Benchmarks
+//
+//  Appending floats, like a point array for a chart, to the Swift `SharedVector<Float>` and the C++ `slint::SharedVector<float>`.
+//  One at a time, and in chunks of 10,000 from a `[Float]`. Bytes copied counts what growing the buffer moved.
+//  Runs entirely inside `start()`.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct SharedVectorBenchmark: SlintApp {
+    static let elements = 1_000_000
+    static let chunk = 10_000
+    static let rounds = 10
+
+    static func start() {
+        appendOneAtATime()
+        appendInChunks()
+        exit(0)
+    }
+
+    /// Elements moved by growing the buffer, found by watching the capacity change.
+    static func bytesCopiedByGrowth(_ append: (Int) -> (count: Int, capacity: Int)) -> Int {
+        var copied = 0
+        var capacity = 0
+        for index in 0 ..< elements {
+            let before = capacity
+            let after = append(index)
+            if after.capacity != before, index > 0 { copied += (after.count - 1) * MemoryLayout<Float>.stride }
+            capacity = after.capacity
+        }
+        return copied
+    }
+
+    static func appendOneAtATime() {
+        let cpp = measure {
+            for _ in 0 ..< rounds {
+                var vector = SharedFloatVector()
+                for index in 0 ..< elements { slint_shared_float_vector_push(&vector, Float(index)) }
+                blackHole(slint_shared_float_vector_len(&vector))
+            }
+        }
+        var cppVector = SharedFloatVector()
+        let cppCopied = bytesCopiedByGrowth { index in
+            slint_shared_float_vector_push(&cppVector, Float(index))
+            return (slint_shared_float_vector_len(&cppVector), slint_shared_float_vector_capacity(&cppVector))
+        }
+
+        let swift = measure {
+            for _ in 0 ..< rounds {
+                var vector = SharedVector<Float>()
+                for index in 0 ..< elements { vector.append(Float(index)) }
+                blackHole(vector.count)
+            }
+        }
+        var swiftVector = SharedVector<Float>()
+        let swiftCopied = bytesCopiedByGrowth { index in
+            swiftVector.append(Float(index))
+            return (swiftVector.count, swiftVector.capacity)
+        }
+
+        let total = elements * rounds
+        report("one at a time", [
+            "C++ SharedVector appends/sec": formatRate(rate(total, cpp)),
+            "C++ SharedVector bytes copied": formatBytes(cppCopied),
+            "SharedVector appends/sec": formatRate(rate(total, swift)),
+            "SharedVector bytes copied": formatBytes(swiftCopied),
+        ])
+    }
+
+    static func appendInChunks() {
+        let points = (0 ..< chunk).map { Float($0) * 0.5 }
+        let chunks = elements / chunk
+
+        let cpp = measure {
+            for _ in 0 ..< rounds {
+                var vector = SharedFloatVector()
+                for _ in 0 ..< chunks {
+                    for point in points { slint_shared_float_vector_push(&vector, point) }
+                }
+                blackHole(slint_shared_float_vector_len(&vector))
+            }
+        }
+
+        let swift = measure {
+            for _ in 0 ..< rounds {
+                var vector = SharedVector<Float>()
+                for _ in 0 ..< chunks { vector.append(contentsOf: points) }
+                blackHole(vector.count)
+            }
+        }
+
+        let reserved = measure {
+            for _ in 0 ..< rounds {
+                var vector = SharedVector<Float>()
+                vector.reserveCapacity(elements)
+                for _ in 0 ..< chunks { vector.append(contentsOf: points) }
+                blackHole(vector.count)
+            }
+        }
+
+        let total = elements * rounds
+        report("chunks of \(chunk)", [
+            "C++ SharedVector push_back, appends/sec": formatRate(rate(total, cpp)),
+            "SharedVector append(contentsOf:), appends/sec": formatRate(rate(total, swift)),
+            "with reserveCapacity, appends/sec": formatRate(rate(total, reserved)),
+        ])
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  SocketLatencyBenchmark.swift
+//  Benchmarks
+//
+//  Latency from a socket becoming readable, to a UI property holding what was read.
+//  With `EpollPlatform`, the event loop waits on the socket itself, and the handler sets the property.
+//  Before, a thread had to block on the socket, then hop to the event loop with `SlintActor.dispatch`.
+//  The sender waits for each reading to land before writing the next, so latencies don't queue.
+//  Each design runs in its own process, since Slint only takes one platform.
+//  Run with no arguments for both, or with `epoll` or `thread` for one.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct SocketLatencyBenchmark: SlintApp {
+    static let count = 20_000
+
+    static let source = """
+        export component Readout inherits Window {
+            in property <int> reading: 0;
+            Text { text: "Reading: \\(root.reading)"; }
+        }
+        """
+
+    static func start() {
+        switch CommandLine.arguments.dropFirst().first {
+        case "epoll":
+            #if os(Linux)
+            run(epoll: true)
+            #else
+            print("epoll is Linux only.")
+            exit(0)
+            #endif
+        case "thread":
+            run(epoll: false)
+        default:
+            spawn("thread")
+            spawn("epoll")
+            exit(0)
+        }
+    }
+
+    @SlintActor
+    static func run(epoll: Bool) {
+        #if os(Linux)
+        let platform = epoll ? EpollPlatform.install() : nil
+        #endif
+
+        let instance: SlintComponentInstance
+        do {
+            instance = try SlintCompiler().build(fromSource: source).create()
+        } catch {
+            print(error)
+            exit(1)
+        }
+
+        var sockets: [Int32] = [0, 0]
+        #if os(Linux)
+        let streamType = Int32(SOCK_STREAM.rawValue)
+        #else
+        let streamType = SOCK_STREAM
+        #endif
+        guard socketpair(AF_UNIX, streamType, 0, &sockets) == 0 else {
+            print("socketpair failed: \(String(cString: strerror(errno)))")
+            exit(1)
+        }
+        let (sender, receiver) = (sockets[0], sockets[1])
+
+        var latencies: [UInt64] = []
+        latencies.reserveCapacity(count)
+        let landed = DispatchSemaphore(value: 0)
+
+        /// On the event loop: read one timestamp, show it, and time it.
+        @SlintActor
+        func receive(_ sentAt: UInt64) {
+            instance.setProperty("reading", .number(Double(latencies.count)))
+            latencies.append(monotonicNanoseconds() - sentAt)
+            landed.signal()
+
+            if latencies.count == count {
+                report(epoll ? "epoll loop, handler on the event loop" : "reader thread, dispatch to the event loop (before)", [
+                    "readings": "\(latencies.count)",
+                    "p50 latency": formatDuration(percentile(latencies, 50)),
+                    "p99 latency": formatDuration(percentile(latencies, 99)),
+                    "max latency": formatDuration(latencies.max() ?? 0),
+                ])
+                exit(0)
+            }
+        }
+
+        if epoll {
+            #if os(Linux)
+            platform!.watch(receiver, for: .readable) { _ in
+                receive(readTimestamp(receiver))
+            }
+            #endif
+        } else {
+            let reader = Thread {
+                while true {
+                    let sentAt = readTimestamp(receiver)
+                    SlintActor.dispatch { receive(sentAt) }
+                }
+            }
+            reader.name = "Socket reader"
+            reader.start()
+        }
+
+        // Starts sending once the loop runs, so the first reading isn't waiting on startup.
+        // On its own thread, since it blocks between readings.
+        Task.detached {
+            await EventLoop.ready
+            Thread {
+                for _ in 0 ..< count {
+                    var sentAt = monotonicNanoseconds()
+                    _ = write(sender, &sentAt, MemoryLayout<UInt64>.size)
+                    landed.wait()
+                }
+            }.start()
+        }
+    }
+
+    /// Read one timestamp. Blocks if there isn't one yet.
+    static func readTimestamp(_ socket: Int32) -> UInt64 {
+        var value: UInt64 = 0
+        _ = read(socket, &value, MemoryLayout<UInt64>.size)
+        return value
+    }
+}
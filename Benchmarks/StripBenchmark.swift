@@ -0,0 +1,142 @@
+//
+//  StripBenchmark.swift
+//  Benchmarks
+//
+//  Streaming RGB565 frames to a mock SPI display, a strip at a time, against pushing the whole frame.
+//  Each configuration runs in its own process, so each peak RSS is its own.
+//  Run with no arguments for every configuration, or `<width> <height> <strip height | full>` for one.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct StripBenchmark: SlintApp {
+    static let frames = 300
+    static let sizes = [(width: 320, height: 240), (width: 800, height: 480)]
+    /// Rows per strip. `nil` pushes the whole frame.
+    static let stripHeights: [Int?] = [1, 8, 16, 32, nil]
+
+    static func start() {
+        let arguments = CommandLine.arguments.dropFirst()
+        if arguments.count == 3, let width = Int(arguments[1]), let height = Int(arguments[2]) {
+            run(width: width, height: height, stripHeight: Int(arguments[3]))
+        } else {
+            for size in sizes {
+                for stripHeight in stripHeights {
+                    spawn(size.width, size.height, stripHeight.map(String.init) ?? "full")
+                }
+            }
+        }
+        exit(0)
+    }
+
+    @SlintActor
+    static func run(width: Int, height: Int, stripHeight: Int?) {
+        let platform = HeadlessPlatform.install(manualTime: true)
+        let definition: ComponentDefinition
+        do {
+            definition = try SlintCompiler().build(fromSource: gaugeScene)
+        } catch {
+            print(error)
+            exit(1)
+        }
+
+        let renderer = StripRenderer(width: width, height: height, stripHeight: stripHeight ?? height, byteSwapped: true)
+        platform.nextWindow = renderer.window
+        let instance = definition.create()
+        instance.setSize(width: UInt32(width), height: UInt32(height))
+        instance.show()
+        defer { instance.hide() }
+
+        let display = MockSPIStripSink()
+
+        // Pushing the whole frame: render it, and send every pixel.
+        let frame = UnsafeMutableBufferPointer<UInt16>.allocate(capacity: width * height)
+        defer { frame.deallocate() }
+        func fullFrame() {
+            _ = renderer.window.render(into: frame)
+            var region = IntRect()
+            region.width = Int32(width)
+            region.height = Int32(height)
+            try! display.begin(region: region)
+            try! display.write(UnsafeBufferPointer(frame), y: 0, rows: height)
+            try! display.end()
+        }
+
+        func step() {
+            if stripHeight == nil { fullFrame() } else { try! renderer.render(to: display) }
+        }
+
+        // The first frame paints everything.
+        step()
+        let baseline = display.bytesTransferred
+
+        let elapsed = measure {
+            for index in 0 ..< frames {
+                if index % 10 == 0 { instance.setProperty("target", .number(Double((index * 37) % 100))) }
+                platform.advance(by: 16)
+                step()
+            }
+        }
+        blackHole(display.checksum)
+
+        let streamed = display.bytesTransferred - baseline
+        let buffers = stripHeight == nil ? frame.count * MemoryLayout<UInt16>.stride : renderer.bufferBytes
+        let strip = stripHeight.map { "\($0)-row strips" } ?? "full frame"
+        report("animated gauges, \(width)×\(height), \(strip)", [
+            "frames/sec": String(format: "%.1f", rate(frames, elapsed)),
+            "streamed/sec": "\(formatBytes(Int(rate(streamed, elapsed))))/s",
+            "bytes per frame": formatBytes(streamed / frames),
+            "transactions per frame": String(format: "%.1f", Double(display.transactions) / Double(display.frames)),
+            "pixel buffers": formatBytes(buffers),
+            "peak RSS": formatBytes(peakResidentBytes()),
+        ])
+    }
+
+    // MARK: Scene
+
+    /// Six bar gauges that animate towards a shared target, like RenderBenchmark's.
+    static let gaugeScene = """
+        component Gauge inherits Rectangle {
+            in property <float> value;
+            in property <string> label;
+            background: #303030;
+            border-radius: 6px;
+
+            Rectangle {
+                x: 4px;
+                y: 4px;
+                height: parent.height - 8px;
+                width: (parent.width - 8px) * clamp(root.value, 0, 100) / 100;
+                background: root.value > 80 ? #e04040 : #40c080;
+                border-radius: 4px;
+            }
+
+            Text {
+                text: "\\(root.label): \\(round(root.value))%";
+                color: white;
+                horizontal-alignment: center;
+                vertical-alignment: center;
+            }
+        }
+
+        export component GaugeScene inherits Window {
+            in property <float> target: 0;
+            background: #181818;
+
+            VerticalLayout {
+                padding: 12px;
+                spacing: 8px;
+
+                for index in 6: Gauge {
+                    label: "Channel \\(index + 1)";
+                    value: mod(root.target + index * 13, 100);
+                    animate value { duration: 150ms; easing: ease-in-out; }
+                }
+            }
+        }
+        """
+}
@@ -0,0 +1,53 @@
+//
+//  AllocationCounter.swift
+//  Benchmarks
+//
+//  Counts heap allocations, by standing in for `malloc`, `calloc` and `realloc`, and passing them on to glibc.
+//  Swift and Slint both allocate through those, so both are counted.
+//  Only linked into benchmarks that count allocations, and only on Linux. Elsewhere, counts are `nil`.
+//
+
+#if os(Linux)
+@_silgen_name("__libc_malloc")
+private func libcMalloc(_ size: Int) -> UnsafeMutableRawPointer?
+
+@_silgen_name("__libc_calloc")
+private func libcCalloc(_ count: Int, _ size: Int) -> UnsafeMutableRawPointer?
+
+@_silgen_name("__libc_realloc")
+private func libcRealloc(_ pointer: UnsafeMutableRawPointer?, _ size: Int) -> UnsafeMutableRawPointer?
+
+/// Allocations so far. Not atomic: benchmarks count on one thread, with nothing else running.
+/// Initializing it doesn't allocate, so counting the first allocation doesn't recurse.
+private var allocations = 0
+
+@_cdecl("malloc")
+public func countingMalloc(_ size: Int) -> UnsafeMutableRawPointer? {
+    allocations &+= 1
+    return libcMalloc(size)
+}
+
+@_cdecl("calloc")
+public func countingCalloc(_ count: Int, _ size: Int) -> UnsafeMutableRawPointer? {
+    allocations &+= 1
+    return libcCalloc(count, size)
+}
+
+@_cdecl("realloc")
+public func countingRealloc(_ pointer: UnsafeMutableRawPointer?, _ size: Int) -> UnsafeMutableRawPointer? {
+    allocations &+= 1
+    return libcRealloc(pointer, size)
+}
+#endif
+
+/// Heap allocations made by a closure, or `nil` if they can't be counted here.
+func countAllocations(_ body: () throws -> Void) rethrows -> Int? {
+    #if os(Linux)
+    let before = allocations
+    try body()
+    return allocations - before
+    #else
+    try body()
+    return nil
+    #endif
+}
@@ -0,0 +1,128 @@
+//
+//  BenchmarkSupport.swift
+//  Benchmarks
+//
+//  Shared helpers. Deliberately tiny: every benchmark prints plain `name: value` lines, so output can be diffed or grepped.
+//
+
+import Foundation
+
+// For `monotonicNanoseconds()`, the clock the runtime itself uses.
+@testable import SlintUI
+
+/// Time a closure.
+/// - Returns: Elapsed nanoseconds.
+@discardableResult
+func measure(_ body: () throws -> Void) rethrows -> UInt64 {
+    let start = monotonicNanoseconds()
+    try body()
+    return monotonicNanoseconds() - start
+}
+
+/// Time an async closure.
+/// - Returns: Elapsed nanoseconds.
+@discardableResult
+func measure(_ body: () async throws -> Void) async rethrows -> UInt64 {
+    let start = monotonicNanoseconds()
+    try await body()
+    return monotonicNanoseconds() - start
+}
+
+/// Keep the optimizer from deleting a result.
+@inline(never)
+func blackHole<T>(_ value: T) { }
+
+/// Value at a percentile of some samples.
+/// - Parameters:
+///   - samples: The samples. Need not be sorted.
+///   - p: Percentile, from 0 to 100.
+func percentile(_ samples: [UInt64], _ p: Double) -> UInt64 {
+    guard !samples.isEmpty else { return 0 }
+    let sorted = samples.sorted()
+    let index = Int((Double(sorted.count - 1) * p / 100).rounded())
+    return sorted[index]
+}
+
+/// Operations per second.
+func rate(_ count: Int, _ nanoseconds: UInt64) -> Double {
+    Double(count) / (Double(max(nanoseconds, 1)) / 1_000_000_000)
+}
+
+/// Format a rate, e.g. `1.25M/s`.
+func formatRate(_ perSecond: Double) -> String {
+    switch perSecond {
+    case 1_000_000...: return String(format: "%.2fM/s", perSecond / 1_000_000)
+    case 1_000...: return String(format: "%.2fk/s", perSecond / 1_000)
+    default: return String(format: "%.1f/s", perSecond)
+    }
+}
+
+/// Format a duration, picking a sensible unit.
+func formatDuration(_ nanoseconds: UInt64) -> String {
+    switch nanoseconds {
+    case 1_000_000_000...: return String(format: "%.2fs", Double(nanoseconds) / 1_000_000_000)
+    case 1_000_000...: return String(format: "%.2fms", Double(nanoseconds) / 1_000_000)
+    case 1_000...: return String(format: "%.2fµs", Double(nanoseconds) / 1_000)
+    default: return "\(nanoseconds)ns"
+    }
+}
+
+/// Format a byte count, picking a sensible unit.
+func formatBytes(_ bytes: Int) -> String {
+    switch bytes {
+    case 1 << 30 ...: return String(format: "%.2fGiB", Double(bytes) / Double(1 << 30))
+    case 1 << 20 ...: return String(format: "%.2fMiB", Double(bytes) / Double(1 << 20))
+    case 1 << 10 ...: return String(format: "%.2fKiB", Double(bytes) / Double(1 << 10))
+    default: return "\(bytes)B"
+    }
+}
+
+/// Print one result block.
+/// - Parameters:
+///   - title: What was measured, e.g. `"batched executor"`.
+///   - metrics: Name/value pairs, printed in order.
+func report(_ title: String, _ metrics: KeyValuePairs<String, String>) {
+    print("== \(title)")
+    let width = metrics.map(\.key.count).max() ?? 0
+    for (name, value) in metrics {
+        print("  \(name.padding(toLength: width, withPad: " ", startingAt: 0))  \(value)")
+    }
+}
+
+/// Run this benchmark again in a child process, and wait for it to exit.
+/// For configurations that need a fresh process, like installing a different platform.
+/// - Parameter arguments: Passed to the child, as strings.
+func spawn(_ arguments: Any...) {
+    let process = Process()
+    process.executableURL = URL(fileURLWithPath: CommandLine.arguments[0])
+    process.arguments = arguments.map { "\($0)" }
+    do {
+        try process.run()
+        process.waitUntilExit()
+    } catch {
+        print("Couldn't run \(process.arguments!): \(error)")
+        exit(1)
+    }
+}
+
+/// Process CPU time (user + system), in nanoseconds.
+func cpuTime() -> UInt64 {
+    var usage = rusage()
+    getrusage(RUSAGE_SELF, &usage)
+    let user = UInt64(usage.ru_utime.tv_sec) * 1_000_000_000 + UInt64(usage.ru_utime.tv_usec) * 1_000
+    let system = UInt64(usage.ru_stime.tv_sec) * 1_000_000_000 + UInt64(usage.ru_stime.tv_usec) * 1_000
+    return user + system
+}
+
+/// Peak resident set size of the process, in bytes.
+func peakResidentBytes() -> Int {
+    var usage = rusage()
+    getrusage(RUSAGE_SELF, &usage)
+    #if os(Linux)
+    // Kilobytes on Linux…
+    return Int(usage.ru_maxrss) * 1024
+    #else
+    // …bytes on Darwin.
+    return Int(usage.ru_maxrss)
+    #endif
+}
@@ -0,0 +1,5 @@
+// Only ImageCacheBenchmark imports this, so only it needs libpng's headers.
+
+#pragma once
+
+#include <png.h>
@@ -0,0 +1,153 @@
+//
+//  TimerServiceBenchmark.swift
+//  Benchmarks
+//
+//  `SlintTimerService` against one native Slint timer per Swift timer, the original design.
+//  First, the cost of starting and cancelling 100k timers. Then wakeups and CPU time for
+//  a dashboard-like load: many periodic timers, at unaligned intervals.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+@main
+struct TimerServiceBenchmark: SlintApp {
+    /// Timers started and cancelled.
+    static let churn = 100_000
+    /// Periodic timers running at once.
+    static let periodic = 1_000
+    /// How long the periodic timers run for, in milliseconds.
+    static let duration: UInt64 = 3_000
+    /// Leeway for the coalesced run.
+    static let leeway: UInt64 = 16
+
+    /// Timers fired during a periodic run.
+    @SlintActor static var fired = 0
+
+    static func start() {
+        compareChurn()
+
+        Task.detached {
+            await EventLoop.ready
+
+            await runPeriodic("native timer per Swift timer (original)") { await startNativePeriodic() }
+            await runPeriodic("timer service, no leeway") { await startServicePeriodic(leeway: 0) }
+            await runPeriodic("timer service, \(leeway)ms leeway") { await startServicePeriodic(leeway: leeway) }
+
+            exit(0)
+        }
+    }
+
+    /// Deadlines spread over 1–2s, so nothing is due while cancelling.
+    static func delay(_ i: Int) -> UInt64 {
+        1_000 + UInt64(i % 1_000)
+    }
+
+    /// Intervals from 50ms to about 1s, deliberately not lined up with each other.
+    static func interval(_ i: Int) -> UInt64 {
+        50 + UInt64((i &* 7_919) % 977)
+    }
+
+    // MARK: Start and cancel
+
+    @SlintActor
+    static func compareChurn() {
+        var ids = [UInt](repeating: 0, count: churn)
+        var handles: [SlintTimerService.Handle] = []
+        handles.reserveCapacity(churn)
+
+        let nativeCPU = cpuTime()
+        let nativeTime = measure {
+            for i in 0 ..< churn {
+                ids[i] = slint_timer_start(
+                    0,
+                    TimerMode.SingleShot,
+                    delay(i),
+                    WrappedClosure.invokeCallback,
+                    WrappedClosure { }.getRetainedPointer(),
+                    WrappedClosure.dropCallback
+                )
+            }
+            for id in ids { slint_timer_destroy(id) }
+        }
+        let nativeCPUTime = cpuTime() - nativeCPU
+
+        let serviceCPU = cpuTime()
+        let serviceTime = measure {
+            for i in 0 ..< churn {
+                handles.append(SlintTimerService.shared.schedule(after: delay(i)) { })
+            }
+            for handle in handles { SlintTimerService.shared.cancel(handle) }
+        }
+        let serviceCPUTime = cpuTime() - serviceCPU
+
+        report("start + cancel \(churn) timers", [
+            "before": "\(formatDuration(nativeTime)) (\(formatRate(rate(churn, nativeTime))))",
+            "after": "\(formatDuration(serviceTime)) (\(formatRate(rate(churn, serviceTime))))",
+            "before CPU": formatDuration(nativeCPUTime),
+            "after CPU": formatDuration(serviceCPUTime),
+            "speedup": String(format: "%.2fx", Double(nativeTime) / Double(max(serviceTime, 1))),
+        ])
+    }
+
+    // MARK: Periodic load
+
+    /// Start the periodic timers, let them run, stop them, and report.
+    /// - Parameter startTimers: Starts the timers, and returns a closure that stops them.
+    static func runPeriodic(_ title: String, _ startTimers: () async -> @SlintActor () -> Void) async {
+        let before = await { @SlintActor in
+            fired = 0
+            return (WakeupScheduler.shared.statistics.wakeups, SlintTimerService.shared.statistics.wakeups)
+        }()
+        let cpuBefore = cpuTime()
+
+        let stopTimers = await startTimers()
+        try? await Task.sleep(nanoseconds: duration * 1_000_000)
+        await stopTimers()
+
+        let cpu = cpuTime() - cpuBefore
+        let (fired, wakeups, serviceWakeups) = await { @SlintActor in
+            (
+                fired,
+                WakeupScheduler.shared.statistics.wakeups - before.0,
+                SlintTimerService.shared.statistics.wakeups - before.1
+            )
+        }()
+
+        let seconds = Double(duration) / 1_000
+        report(title, [
+            "timers": "\(periodic)",
+            "fired": "\(fired)",
+            "loop wakeups": "\(wakeups) (\(String(format: "%.1f/s", Double(wakeups) / seconds)))",
+            "native timer wakeups": "\(serviceWakeups)",
+            "fired per wakeup": String(format: "%.2f", Double(fired) / Double(max(wakeups, 1))),
+            "CPU": "\(formatDuration(cpu)) (\(String(format: "%.1f%%", Double(cpu) / Double(duration * 10_000))))",
+        ])
+    }
+
+    @SlintActor
+    static func startNativePeriodic() -> @SlintActor () -> Void {
+        let ids = (0 ..< periodic).map { i in
+            slint_timer_start(
+                0,
+                TimerMode.Repeated,
+                interval(i),
+                WrappedClosure.invokeCallback,
+                WrappedClosure { fired += 1 }.getRetainedPointer(),
+                WrappedClosure.dropCallback
+            )
+        }
+        WakeupScheduler.shared.rearm()
+        return { for id in ids { slint_timer_destroy(id) } }
+    }
+
+    @SlintActor
+    static func startServicePeriodic(leeway: UInt64) -> @SlintActor () -> Void {
+        let handles = (0 ..< periodic).map { i in
+            SlintTimerService.shared.schedule(every: interval(i), leeway: leeway) { fired += 1 }
+        }
+        return { for handle in handles { SlintTimerService.shared.cancel(handle) } }
+    }
+}
@@ -0,0 +1,69 @@
+//
+//  TracingBenchmark.swift
+//  Benchmarks
+//
+//  What tracing costs. A bare trace point, and 2M `SlintCallback` invocations, each traced by the callback trampoline.
+//  Compared: no trace point at all (before), tracing disabled, and tracing enabled.
+//  Then the cost of reading the trace back: the Chrome JSON export, and the summary.
+//  Runs entirely inside `start()`. Callbacks don't need the event loop.
+//
+
+import Foundation
+
+@testable import SlintUI
+
+@main
+struct TracingBenchmark: SlintApp {
+    static let calls = 2_000_000
+
+    static func start() {
+        SlintTracing.stop()
+        let bare = measure { for index in 0 ..< calls { blackHole(index) } }
+        let disabled = measure { for index in 0 ..< calls { traced(.callback) { blackHole(index) } } }
+        SlintTracing.start()
+        let enabled = measure { for index in 0 ..< calls { traced(.callback) { blackHole(index) } } }
+        SlintTracing.stop()
+        report("trace point", [
+            "no trace point (before)": perCall(bare),
+            "disabled": perCall(disabled),
+            "enabled": perCall(enabled),
+        ])
+
+        let callback = SlintCallback<Int32, Int32> { $0 &+ 1 }
+        for _ in 0 ..< 1_000 { _ = callback.invoke(1) }
+
+        let callbackDisabled = measure { for _ in 0 ..< calls { blackHole(callback.invoke(1)) } }
+        SlintTracing.reset()
+        SlintTracing.start()
+        let callbackEnabled = measure { for _ in 0 ..< calls { blackHole(callback.invoke(1)) } }
+        SlintTracing.stop()
+        report("SlintCallback<Int32, Int32>.invoke", [
+            "disabled": perCall(callbackDisabled),
+            "enabled": perCall(callbackEnabled),
+            "overhead enabled": String(format: "%.1f%%", (Double(callbackEnabled) / Double(max(callbackDisabled, 1)) - 1) * 100),
+        ])
+
+        var json = ""
+        let exportTime = measure { json = SlintTracing.chromeTraceJSON() }
+        var summary: [SlintTracing.Category: SlintTracing.Summary] = [:]
+        let summaryTime = measure { summary = SlintTracing.summary() }
+        report("reading \(SlintTracing.bufferCapacity) events back", [
+            "chrome JSON": "\(formatDuration(exportTime)), \(formatBytes(json.utf8.count))",
+            "summary": formatDuration(summaryTime),
+        ])
+        for (category, summary) in summary.sorted(by: { $0.key.rawValue < $1.key.rawValue }) {
+            report("summary: \(category)", [
+                "count": "\(summary.count)",
+                "p50": formatDuration(summary.p50),
+                "p99": formatDuration(summary.p99),
+                "max": formatDuration(summary.max),
+            ])
+        }
+
+        exit(0)
+    }
+
+    static func perCall(_ nanoseconds: UInt64) -> String {
+        String(format: "%.2fns/call", Double(nanoseconds) / Double(calls))
+    }
+}
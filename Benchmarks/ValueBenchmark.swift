@@ -0,0 +1,118 @@
+//
+//  ValueBenchmark.swift
+//  Benchmarks
+//
+//  Structs per second through `SlintStructEncoder` and `SlintStructDecoder`, for a telemetry-like record.
+//  Each is run with cached field names, and with every name converted per field, like the original `withStrSlice`.
+//  Runs entirely inside `start()`. Values don't need the event loop.
+//
+
+import Foundation
+
+import SlintFFI
+@testable import SlintUI
+
+/// A record like a dashboard would push every frame.
+struct Telemetry: Codable {
+    struct Position: Codable {
+        var latitude: Double
+        var longitude: Double
+        var altitude: Float
+    }
+
+    var sequence: Int
+    var speed: Double
+    var heading: Float
+    var throttle: Double
+    var engaged: Bool
+    var warning: Bool
+    var position: Position
+    var status: String
+}
+
+/// The same record, with the string kept as Slint's own, so decoding it doesn't copy.
+struct SharedTelemetry: Codable {
+    var sequence: Int
+    var speed: Double
+    var heading: Float
+    var throttle: Double
+    var engaged: Bool
+    var warning: Bool
+    var position: Telemetry.Position
+    var status: SharedString
+}
+
+@main
+struct ValueBenchmark: SlintApp {
+    static let count = 200_000
+
+    static func start() {
+        let records = (0 ..< 64).map { i in
+            Telemetry(
+                sequence: i,
+                speed: Double(i) * 1.5,
+                heading: Float(i % 360),
+                throttle: 0.75,
+                engaged: i % 2 == 0,
+                warning: i % 7 == 0,
+                position: .init(latitude: 51.5, longitude: -0.12, altitude: 35),
+                status: "nominal, all systems go (\(i))"
+            )
+        }
+
+        var uncachedEncoder = SlintStructEncoder()
+        uncachedEncoder.cachesFieldNames = false
+        var uncachedDecoder = SlintStructDecoder()
+        uncachedDecoder.cachesFieldNames = false
+
+        compareEncoding(records, before: uncachedEncoder, after: SlintStructEncoder())
+
+        let encoded = try! SlintStructEncoder().encode(records[0])
+        compareDecoding(encoded, before: uncachedDecoder, after: SlintStructDecoder())
+    }
+
+    static func compareEncoding(_ records: [Telemetry], before: SlintStructEncoder, after: SlintStructEncoder) {
+        let target = SlintStruct()
+        // Warm up, so the first pass isn't learning the field order.
+        try! after.encode(records[0], into: target)
+
+        let beforeTime = measure {
+            for i in 0 ..< count { try! before.encode(records[i & 63], into: target) }
+        }
+        let afterTime = measure {
+            for i in 0 ..< count { try! after.encode(records[i & 63], into: target) }
+        }
+        let freshTime = measure {
+            for i in 0 ..< count { blackHole(try! after.encode(records[i & 63])) }
+        }
+
+        report("encode \(count) structs", [
+            "names converted per field": formatRate(rate(count, beforeTime)),
+            "cached names": formatRate(rate(count, afterTime)),
+            "speedup": String(format: "%.2fx", Double(beforeTime) / Double(max(afterTime, 1))),
+            "cached names, new struct each": formatRate(rate(count, freshTime)),
+        ])
+    }
+
+    static func compareDecoding(_ source: SlintStruct, before: SlintStructDecoder, after: SlintStructDecoder) {
+        blackHole(try! after.decode(Telemetry.self, from: source))
+        blackHole(try! after.decode(SharedTelemetry.self, from: source))
+
+        let beforeTime = measure {
+            for _ in 0 ..< count { blackHole(try! before.decode(Telemetry.self, from: source)) }
+        }
+        let afterTime = measure {
+            for _ in 0 ..< count { blackHole(try! after.decode(Telemetry.self, from: source)) }
+        }
+        let sharedTime = measure {
+            for _ in 0 ..< count { blackHole(try! after.decode(SharedTelemetry.self, from: source)) }
+        }
+
+        report("decode \(count) structs", [
+            "names converted per field": formatRate(rate(count, beforeTime)),
+            "cached names": formatRate(rate(count, afterTime)),
+            "speedup": String(format: "%.2fx", Double(beforeTime) / Double(max(afterTime, 1))),
+            "cached names, SharedString": formatRate(rate(count, sharedTime)),
+        ])
+    }
+}
@@ -28,6 +28,9 @@ IMPORT_SLINT_TYPE(Rgb8Pixel)
 IMPORT_SLINT_TYPE(SharedString)
 
 IMPORT_PRIVATE_SLINT_TYPE(BitmapFont)
+IMPORT_PRIVATE_SLINT_TYPE(BitmapGlyph)
+IMPORT_PRIVATE_SLINT_TYPE(BitmapGlyphs)
+IMPORT_PRIVATE_SLINT_TYPE(CharacterMapEntry)
 IMPORT_PRIVATE_SLINT_TYPE(Clipboard)
 IMPORT_PRIVATE_SLINT_TYPE(CppRawHandleOpaque)
 IMPORT_PRIVATE_SLINT_TYPE(IntSize)
@@ -270,6 +273,132 @@ bool slint_timer_running(uintptr_t id) {
     return slint::cbindgen_private::slint_timer_running(id);
 }
 
+/*************************
+ *
+ * Properties
+ *
+ *************************/
+IMPORT_PRIVATE_SLINT_TYPE(PropertyHandleOpaque)
+IMPORT_PRIVATE_SLINT_TYPE(PropertyAnimation)
+IMPORT_PRIVATE_SLINT_TYPE(Color)
+
+void slint_property_init(PropertyHandleOpaque *out) {
+    return slint::cbindgen_private::slint_property_init(out);
+}
+
+void slint_property_update(const PropertyHandleOpaque *handle, void *val) {
+    return slint::cbindgen_private::slint_property_update(handle, val);
+}
+
+void slint_property_set_changed(const PropertyHandleOpaque *handle, const void *value) {
+    return slint::cbindgen_private::slint_property_set_changed(handle, value);
+}
+
+void slint_property_set_binding(const PropertyHandleOpaque *handle,
+                                void (*binding)(void *user_data, void *pointer_to_value),
+                                void *user_data,
+                                void (*drop_user_data)(void*),
+                                bool (*intercept_set)(void *user_data, const void *pointer_to_value),
+                                bool (*intercept_set_binding)(void *user_data, void *new_binding)) {
+
+    return slint::cbindgen_private::slint_property_set_binding(handle, binding, user_data, drop_user_data, intercept_set, intercept_set_binding);
+}
+
+void slint_property_set_binding_internal(const PropertyHandleOpaque *handle, void *binding) {
+    return slint::cbindgen_private::slint_property_set_binding_internal(handle, binding);
+}
+
+bool slint_property_is_dirty(const PropertyHandleOpaque *handle) {
+    return slint::cbindgen_private::slint_property_is_dirty(handle);
+}
+
+void slint_property_mark_dirty(const PropertyHandleOpaque *handle) {
+    return slint::cbindgen_private::slint_property_mark_dirty(handle);
+}
+
+void slint_property_drop(PropertyHandleOpaque *handle) {
+    return slint::cbindgen_private::slint_property_drop(handle);
+}
+
+void slint_property_set_animated_value_int(const PropertyHandleOpaque *handle,
+                                           int32_t from,
+                                           int32_t to,
+                                           const PropertyAnimation *animation_data) {
+
+    return slint::cbindgen_private::slint_property_set_animated_value_int(handle, from, to, animation_data);
+}
+
+void slint_property_set_animated_value_float(const PropertyHandleOpaque *handle,
+                                             float from,
+                                             float to,
+                                             const PropertyAnimation *animation_data) {
+
+    return slint::cbindgen_private::slint_property_set_animated_value_float(handle, from, to, animation_data);
+}
+
+void slint_property_set_animated_value_color(const PropertyHandleOpaque *handle,
+                                             Color from,
+                                             Color to,
+                                             const PropertyAnimation *animation_data) {
+
+    return slint::cbindgen_private::slint_property_set_animated_value_color(handle, from, to, animation_data);
+}
+
+void slint_property_set_animated_binding_int(const PropertyHandleOpaque *handle,
+                                             void (*binding)(void*, int32_t*),
+                                             void *user_data,
+                                             void (*drop_user_data)(void*),
+                                             const PropertyAnimation *animation_data,
+                                             PropertyAnimation (*transition_data)(void *user_data, uint64_t *start_instant)) {
+
+    return slint::cbindgen_private::slint_property_set_animated_binding_int(handle, binding, user_data, drop_user_data, animation_data, transition_data);
+}
+
+void slint_property_set_animated_binding_float(const PropertyHandleOpaque *handle,
+                                               void (*binding)(void*, float*),
+                                               void *user_data,
+                                               void (*drop_user_data)(void*),
+                                               const PropertyAnimation *animation_data,
+                                               PropertyAnimation (*transition_data)(void *user_data, uint64_t *start_instant)) {
+
+    return slint::cbindgen_private::slint_property_set_animated_binding_float(handle, binding, user_data, drop_user_data, animation_data, transition_data);
+}
+
+void slint_property_set_animated_binding_color(const PropertyHandleOpaque *handle,
+                                               void (*binding)(void*, Color*),
+                                               void *user_data,
+                                               void (*drop_user_data)(void*),
+                                               const PropertyAnimation *animation_data,
+                                               PropertyAnimation (*transition_data)(void *user_data, uint64_t *start_instant)) {
+
+    return slint::cbindgen_private::slint_property_set_animated_binding_color(handle, binding, user_data, drop_user_data, animation_data, transition_data);
+}
+
+//
+// Property tracker
+//
+IMPORT_PRIVATE_SLINT_TYPE(PropertyTrackerOpaque)
+
+void slint_property_tracker_init(PropertyTrackerOpaque *out) {
+    return slint::cbindgen_private::slint_property_tracker_init(out);
+}
+
+void slint_property_tracker_evaluate(const PropertyTrackerOpaque *handle, void (*callback)(void *user_data), void *user_data) {
+    return slint::cbindgen_private::slint_property_tracker_evaluate(handle, callback, user_data);
+}
+
+void slint_property_tracker_evaluate_as_dependency_root(const PropertyTrackerOpaque *handle, void (*callback)(void *user_data), void *user_data) {
+    return slint::cbindgen_private::slint_property_tracker_evaluate_as_dependency_root(handle, callback, user_data);
+}
+
+bool slint_property_tracker_is_dirty(const PropertyTrackerOpaque *handle) {
+    return slint::cbindgen_private::slint_property_tracker_is_dirty(handle);
+}
+
+void slint_property_tracker_drop(PropertyTrackerOpaque *handle) {
+    return slint::cbindgen_private::slint_property_tracker_drop(handle);
+}
+
 /*************************
  *
  * Interpreter
@@ -277,6 +406,9 @@ bool slint_timer_running(uintptr_t id) {
  *************************/
 #include "slint_interpreter_internal.h"
 
+// Only for the component instance helpers below, which go through the public C++ API.
+#include "slint-interpreter.h"
+
 //
 // Value
 //
@@ -303,6 +435,19 @@ IMPORT_PRIVATE_SLINT_TEMPLATE(Slice)
 // Custom alias for Slice<uint8_t>
 using StrSlice = Slice<uint8_t>;
 
+// Concrete vectors, so Swift can name them
+using SharedStringVector = SharedVector<SharedString>;
+using DiagnosticVector = SharedVector<Diagnostic>;
+using ValueVector = SharedVector<Box<Value>>;
+using PropertyDescriptorVector = SharedVector<PropertyDescriptor>;
+
+// Callback arguments, and `invoke`'s
+using ValueSlice = Slice<Box<Value>>;
+
+// The model vtable's functions get the model as a `VRef`: the vtable, and a pointer to the model.
+using ModelAdaptorVRef = vtable::VRef<ModelAdaptorVTable>;
+using ModelAdaptorVRefMut = vtable::VRefMut<ModelAdaptorVTable>;
+
 /// Construct a new Value in the given memory location
 Box<Value> slint_interpreter_value_new() {
     return slint::cbindgen_private::slint_interpreter_value_new();
@@ -787,3 +932,190 @@ void slint_shared_vector_free(
 const uint8_t *slint_shared_vector_empty() {
     return slint::cbindgen_private::slint_shared_vector_empty();
 }
+
+//
+// C++ `SharedVector<float>`, to compare the Swift one against.
+//
+using SharedFloatVector = SharedVector<float>;
+
+inline void slint_shared_float_vector_push(SharedFloatVector *vec, float value) {
+    vec->push_back(value);
+}
+
+inline SharedFloatVector slint_shared_float_vector_from(const float *values, size_t count) {
+    return SharedFloatVector(values, values + count);
+}
+
+inline size_t slint_shared_float_vector_len(const SharedFloatVector *vec) {
+    return vec->size();
+}
+
+/// Read from the backing vector's header, which is private to Slint. The C++ vector doesn't expose its capacity.
+inline size_t slint_shared_float_vector_capacity(const SharedFloatVector *vec) {
+    return (*reinterpret_cast<const SharedVectorHeader *const *>(vec))->capacity;
+}
+
+/*************************
+ *
+ * Shared string
+ *
+ *************************/
+
+#include <cstring>
+
+/// Pointer to the UTF-8 bytes of a SharedString. Null terminated. Borrowed, valid as long as the string is.
+inline const char *slint_shared_string_bytes(const SharedString *ss) {
+    return slint::cbindgen_private::slint_shared_string_bytes(ss);
+}
+
+/// Length of a SharedString in bytes, without the terminator.
+/// `strlen` of the public bytes, rather than the size in the backing vector's header, which is private to Slint.
+inline size_t slint_shared_string_len(const SharedString *ss) {
+    return std::strlen(slint_shared_string_bytes(ss));
+}
+
+/// Make a SharedString from UTF-8 bytes. The bytes are copied once, straight into the new string.
+inline SharedString slint_shared_string_from_utf8(const char *bytes, size_t len) {
+    return SharedString(std::string_view(bytes, len));
+}
+
+/// True if the bytes of two SharedStrings are equal. Compares lengths first, then `memcmp`.
+inline bool slint_shared_string_eq(const SharedString *a, const SharedString *b) {
+    return *a == *b;
+}
+
+/*************************
+ *
+ * Shared string vector
+ *
+ *************************/
+
+inline size_t slint_shared_string_vector_len(const SharedStringVector *vec) {
+    return vec->size();
+}
+
+/// Borrowed, valid until the vector changes.
+inline const SharedString *slint_shared_string_vector_at(const SharedStringVector *vec, size_t index) {
+    return &(*vec)[index];
+}
+
+inline void slint_shared_string_vector_push(SharedStringVector *vec, const SharedString *str) {
+    vec->push_back(*str);
+}
+
+/*************************
+ *
+ * Property descriptors
+ *
+ *************************/
+
+inline size_t slint_property_descriptor_vector_len(const PropertyDescriptorVector *vec) {
+    return vec->size();
+}
+
+/// Borrowed, valid until the vector changes.
+inline const SharedString *slint_property_descriptor_vector_name_at(const PropertyDescriptorVector *vec, size_t index) {
+    return &(*vec)[index].property_name;
+}
+
+inline ValueType slint_property_descriptor_vector_type_at(const PropertyDescriptorVector *vec, size_t index) {
+    return (*vec)[index].property_type;
+}
+
+/*************************
+ *
+ * Diagnostics
+ *
+ *************************/
+
+inline size_t slint_diagnostic_vector_len(const DiagnosticVector *vec) {
+    return vec->size();
+}
+
+/// Borrowed, valid until the vector changes.
+inline const Diagnostic *slint_diagnostic_vector_at(const DiagnosticVector *vec, size_t index) {
+    return &(*vec)[index];
+}
+
+/// The level enum lives in another namespace, so compare here rather than import it.
+inline bool slint_diagnostic_is_error(const Diagnostic *diag) {
+    return diag->level == decltype(diag->level)::Error;
+}
+
+/*************************
+ *
+ * Component instance
+ *
+ *************************/
+
+// The interpreter hands out instances as a `VRc`, which Swift can't hold.
+// So the instance lives on the C++ heap, as the public API's handle, and Swift gets an opaque pointer to it.
+
+using ComponentInstanceHandle = slint::ComponentHandle<slint::interpreter::ComponentInstance>;
+
+/// Instantiate a component. Free with `slint_swift_component_instance_drop`.
+inline void *slint_swift_component_instance_new(const ComponentDefinitionOpaque *def) {
+    // `slint::interpreter::ComponentDefinition` is just a `ComponentDefinitionOpaque`.
+    auto definition = reinterpret_cast<const slint::interpreter::ComponentDefinition *>(def);
+    return new ComponentInstanceHandle(definition->create());
+}
+
+inline void slint_swift_component_instance_drop(void *instance) {
+    delete static_cast<ComponentInstanceHandle *>(instance);
+}
+
+/// The erased item tree, for the `slint_interpreter_component_instance_*` functions. Borrowed.
+inline const ErasedItemTreeBox *slint_swift_component_instance_erased(const void *instance) {
+    auto &handle = *static_cast<const ComponentInstanceHandle *>(instance);
+    return reinterpret_cast<const ErasedItemTreeBox *>(&*handle);
+}
+
+/// Resize the instance's window, in physical pixels.
+inline void slint_swift_component_instance_set_size(const void *instance, uint32_t width, uint32_t height) {
+    auto &handle = *static_cast<const ComponentInstanceHandle *>(instance);
+    handle->window().set_size(slint::PhysicalSize({ width, height }));
+}
+
+/*************************
+ *
+ * Images
+ *
+ *************************/
+
+// Pixels live in a Slint pixel buffer, on the C++ heap, like component instances, and Swift gets an opaque pointer.
+// PNG and JPEG are decoded into one by the optional `SlintImageDecoders` library, so only it needs libpng and libjpeg.
+
+using Rgba8PixelBuffer = slint::SharedPixelBuffer<slint::Rgba8Pixel>;
+
+/// A buffer of uninitialized pixels. Free with `slint_swift_pixel_buffer_drop`.
+inline void *slint_swift_pixel_buffer_new(uint32_t width, uint32_t height) {
+    return new Rgba8PixelBuffer(width, height);
+}
+
+inline void slint_swift_pixel_buffer_drop(void *buffer) {
+    delete static_cast<Rgba8PixelBuffer *>(buffer);
+}
+
+inline uint32_t slint_swift_pixel_buffer_width(const void *buffer) {
+    return static_cast<const Rgba8PixelBuffer *>(buffer)->width();
+}
+
+inline uint32_t slint_swift_pixel_buffer_height(const void *buffer) {
+    return static_cast<const Rgba8PixelBuffer *>(buffer)->height();
+}
+
+/// Pixels to write, as RGBA bytes, rows packed. Only before the buffer is shared with an image: after, this copies it.
+inline uint8_t *slint_swift_pixel_buffer_bytes(void *buffer) {
+    return reinterpret_cast<uint8_t *>(static_cast<Rgba8PixelBuffer *>(buffer)->begin());
+}
+
+/// Pixels to read, as RGBA bytes, rows packed.
+inline const uint8_t *slint_swift_pixel_buffer_const_bytes(const void *buffer) {
+    return reinterpret_cast<const uint8_t *>(static_cast<const Rgba8PixelBuffer *>(buffer)->begin());
+}
+
+/// An interpreter value showing the buffer. Slint shares the pixels, rather than copying them.
+inline Box<Value> slint_swift_pixel_buffer_new_image_value(const void *buffer) {
+    Image image(*static_cast<const Rgba8PixelBuffer *>(buffer));
+    return slint_interpreter_value_new_image(&image);
+}
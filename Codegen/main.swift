@@ -0,0 +1,190 @@
+//
+//  main.swift
+//  SlintCodegen
+//
+//  Compiles a `.slint` file, reads its component's properties, callbacks and globals,
+//  and writes a Swift struct with a typed accessor for each.
+//
+//      SlintCodegen <input.slint> <output.swift> [--style <style>] [-I <include path>]...
+//
+//  Names are encoded once, as `SlintName`s, and values go through the `SlintValueRepresentable` path for their type.
+//  A name that's misspelt, or used with the wrong type, is a Swift compile error, rather than `false` at runtime.
+//
+
+import Foundation
+
+import SlintFFI
+import SlintUI
+
+func fail(_ message: String) -> Never {
+    FileHandle.standardError.write(Data("SlintCodegen: \(message)\n".utf8))
+    exit(1)
+}
+
+// MARK: Arguments
+
+var arguments = CommandLine.arguments.dropFirst()
+var positional: [String] = []
+var style: String?
+var includePaths: [String] = []
+while let argument = arguments.popFirst() {
+    switch argument {
+    case "--style":
+        style = arguments.popFirst() ?? fail("--style needs a value.")
+    case "-I":
+        includePaths.append(arguments.popFirst() ?? fail("-I needs a path."))
+    default:
+        positional.append(argument)
+    }
+}
+guard positional.count == 2 else {
+    fail("Usage: SlintCodegen <input.slint> <output.swift> [--style <style>] [-I <include path>]...")
+}
+let (input, output) = (positional[0], positional[1])
+
+// MARK: Compiling
+
+let compiler = SlintCompiler()
+if let style { compiler.style = style }
+compiler.includePaths = includePaths
+
+let definition: ComponentDefinition
+do {
+    definition = try compiler.build(fromPath: input)
+} catch {
+    fail("\(error)")
+}
+for warning in compiler.diagnostics {
+    FileHandle.standardError.write(Data("\(warning)\n".utf8))
+}
+
+// MARK: Names
+
+let keywords: Set<String> = [
+    "as", "associatedtype", "break", "case", "catch", "class", "continue", "default", "defer", "deinit", "do", "else", "enum",
+    "extension", "fallthrough", "false", "fileprivate", "for", "func", "guard", "if", "import", "in", "init", "inout",
+    "internal", "is", "let", "nil", "operator", "private", "protocol", "public", "repeat", "rethrows", "return", "self",
+    "Self", "static", "struct", "subscript", "super", "switch", "throw", "throws", "true", "try", "typealias", "var", "where", "while",
+]
+
+/// Members every generated struct has, that a Slint name mustn't shadow.
+let reserved: Set<String> = ["instance", "sourcePath", "Names"]
+
+/// `font-size` and `font_size` become `fontSize`. Keywords are escaped, and reserved names get a suffix.
+func swiftName(_ slintName: String, capitalized: Bool = false) -> String {
+    let words = slintName.split(whereSeparator: { $0 == "-" || $0 == "_" }).map(String.init)
+    var name = words.enumerated().map { index, word in
+        index == 0 && !capitalized ? word.prefix(1).lowercased() + word.dropFirst() : word.prefix(1).uppercased() + word.dropFirst()
+    }.joined()
+    if name.isEmpty || name.first!.isNumber { name = "_" + name }
+    if reserved.contains(name) { name += "Property" }
+    return keywords.contains(name) ? "`\(name)`" : name
+}
+
+/// A Swift string literal.
+func literal(_ string: String) -> String {
+    "\"" + string.replacingOccurrences(of: "\\", with: "\\\\").replacingOccurrences(of: "\"", with: "\\\"") + "\""
+}
+
+/// The Swift type a property is read and written as.
+func swiftType(_ type: ValueType) -> String {
+    switch type {
+    case .Number: "Double"
+    case .String: "SharedString"
+    case .Bool: "Bool"
+    case .Struct: "SlintStruct"
+    default: "SlintValue"
+    }
+}
+
+// MARK: Generating
+
+var lines: [String] = []
+
+/// Accessors for properties and callbacks, on `instance`. For a global's, the struct has its name, as `global`.
+func members(properties: [SlintPropertyDescriptor], callbacks: [String], isGlobal: Bool, indent: String) {
+    let scope = isGlobal ? "Self.global, " : ""
+
+    lines.append("\(indent)private enum Names {")
+    for name in properties.map(\.name) + callbacks {
+        lines.append("\(indent)    static let \(swiftName(name)) = SlintName(\(literal(name)))")
+    }
+    lines.append("\(indent)}")
+
+    for property in properties {
+        let name = swiftName(property.name)
+        let type = swiftType(property.type)
+        lines.append("")
+        lines.append("\(indent)/// The `\(property.name)` property.")
+        lines.append("\(indent)public var \(name): \(type) {")
+        lines.append("\(indent)    get { instance.get(\(scope)Names.\(name), as: \(type).self)! }")
+        lines.append("\(indent)    nonmutating set { instance.set(\(scope)Names.\(name), newValue) }")
+        lines.append("\(indent)}")
+    }
+
+    for callback in callbacks {
+        let name = swiftName(callback)
+        lines.append("")
+        lines.append("\(indent)/// Invoke the `\(callback)` callback.")
+        lines.append("\(indent)@discardableResult")
+        lines.append("\(indent)public func \(name)(_ arguments: SlintValue...) -> SlintValue? {")
+        lines.append("\(indent)    instance.invoke(\(scope)Names.\(name), arguments)")
+        lines.append("\(indent)}")
+        lines.append("")
+        lines.append("\(indent)/// Handle the `\(callback)` callback.")
+        lines.append("\(indent)public func \(swiftName("on-" + callback))(_ handler: @escaping @SlintActor ([SlintValue]) -> SlintValue) {")
+        lines.append("\(indent)    instance.setCallback(\(scope)Names.\(name), handler)")
+        lines.append("\(indent)}")
+    }
+}
+
+let component = swiftName(definition.name, capitalized: true)
+let file = URL(fileURLWithPath: input).lastPathComponent
+
+lines.append("// Generated by SlintCodegen, from \(file). Don't edit.")
+lines.append("")
+lines.append("import SlintFFI")
+lines.append("import SlintUI")
+lines.append("")
+lines.append("/// Typed accessors for the `\(definition.name)` component, from `\(file)`.")
+lines.append("@SlintActor")
+lines.append("public struct \(component) {")
+lines.append("    /// Where the component was compiled from, to compile it again at runtime.")
+lines.append("    public static let sourcePath = \(literal(URL(fileURLWithPath: input).standardizedFileURL.path))")
+lines.append("")
+lines.append("    public let instance: SlintComponentInstance")
+lines.append("")
+lines.append("    /// Wrap an instance of `\(definition.name)`.")
+lines.append("    public nonisolated init(_ instance: SlintComponentInstance) {")
+lines.append("        self.instance = instance")
+lines.append("    }")
+lines.append("")
+members(properties: definition.properties, callbacks: definition.callbacks, isGlobal: false, indent: "    ")
+
+for global in definition.globals {
+    let type = swiftName(global, capitalized: true)
+    lines.append("")
+    lines.append("    /// The `\(global)` global.")
+    lines.append("    public var \(swiftName(global)): \(type) { \(type)(instance: instance) }")
+    lines.append("")
+    lines.append("    @SlintActor")
+    lines.append("    public struct \(type) {")
+    lines.append("        let instance: SlintComponentInstance")
+    lines.append("        private static let global = SlintName(\(literal(global)))")
+    lines.append("")
+    members(
+        properties: definition.properties(ofGlobal: global) ?? [],
+        callbacks: definition.callbacks(ofGlobal: global) ?? [],
+        isGlobal: true,
+        indent: "        "
+    )
+    lines.append("    }")
+}
+lines.append("}")
+lines.append("")
+
+do {
+    try lines.joined(separator: "\n").write(toFile: output, atomically: true, encoding: .utf8)
+} catch {
+    fail("Couldn't write \(output): \(error)")
+}
@@ -0,0 +1,398 @@
+//
+//  main.cpp
+//  SlintFontBaker
+//
+//  Rasterizes a TrueType font at a few pixel sizes, for a subset of characters, laid out the way Slint's software renderer
+//  reads them. `SlintBitmapFont(baked:)` registers them without parsing, rasterizing, or even copying anything.
+//  C++, rather than Swift, only because FreeType is a C library.
+//
+//      SlintFontBaker <font.ttf> <output.swift> --sizes <px>[,<px>...] [--characters <text>] [--ranges <first>-<last>[,...]]
+//                     [--name <SwiftName>] [--family <family name>]
+//
+//  Without `--characters` or `--ranges`, printable ASCII is baked.
+//
+//  Next to `<output.swift>`, it writes `<output>.cpp`, with the data as a static array, and `<output>.h` and `module.modulemap`,
+//  which let the Swift file import it as `<SwiftName>Data`. A Swift array literal would take the compiler minutes,
+//  and be copied again at startup.
+//
+//  The data, little-endian, tables 4-byte aligned, offsets from the start:
+//
+//      0   "SLBF", u32 version (1)
+//      8   f32 units per em, f32 ascent, f32 descent, in design units
+//      20  u16 weight, u8 italic, u8 0
+//      24  u32 family name offset, u32 length (UTF-8)
+//      32  u32 character map offset, u32 count. Entries: u32 code point, u16 glyph index, u16 0. Sorted by code point.
+//      40  u32 glyphs per size, u32 size count
+//      48  u32 sizes offset. Entries: u32 pixel size, u32 glyphs offset.
+//          Glyphs: i16 x, y, width, height, x advance, u16 0, u32 alpha offset, u32 alpha length.
+//          x, y and x advance are 26.6 fixed point, y is the bottom edge, up from the baseline.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_TRUETYPE_TABLES_H
+
+[[noreturn]] static void fail(const std::string &message) {
+    std::fprintf(stderr, "SlintFontBaker: %s\n", message.c_str());
+    std::exit(1);
+}
+
+static const char *usage =
+    "Usage: SlintFontBaker <font.ttf> <output.swift> --sizes <px>[,<px>...] [--characters <text>] "
+    "[--ranges <first>-<last>[,...]] [--name <SwiftName>] [--family <family name>]";
+
+// MARK: Arguments
+
+static std::vector<std::string> split(const std::string &string, char separator) {
+    std::vector<std::string> parts;
+    std::stringstream stream(string);
+    for (std::string part; std::getline(stream, part, separator);) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+/// Decimal, or hex with `0x` or `U+`.
+static uint32_t parseNumber(std::string string) {
+    if (string.rfind("U+", 0) == 0 || string.rfind("u+", 0) == 0) string = "0x" + string.substr(2);
+    char *end = nullptr;
+    unsigned long value = std::strtoul(string.c_str(), &end, 0);
+    if (string.empty() || *end != '\0' || value > 0x10FFFF) fail("Bad number: " + string);
+    return uint32_t(value);
+}
+
+/// Strict: stray or missing continuation bytes, overlong forms, surrogates, and anything past U+10FFFF all fail.
+static std::vector<uint32_t> decodeUTF8(const std::string &text) {
+    std::vector<uint32_t> codePoints;
+    for (size_t index = 0; index < text.size();) {
+        auto invalid = [&] { fail("--characters isn't valid UTF-8, at byte " + std::to_string(index) + "."); };
+
+        uint8_t lead = uint8_t(text[index]);
+        int length;
+        uint32_t codePoint, smallest;
+        if (lead < 0x80) {
+            length = 1, codePoint = lead, smallest = 0;
+        } else if (lead >= 0xC2 && lead <= 0xDF) {
+            length = 2, codePoint = lead & 0x1F, smallest = 0x80;
+        } else if (lead >= 0xE0 && lead <= 0xEF) {
+            length = 3, codePoint = lead & 0x0F, smallest = 0x800;
+        } else if (lead >= 0xF0 && lead <= 0xF4) {
+            length = 4, codePoint = lead & 0x07, smallest = 0x10000;
+        } else {
+            invalid();
+        }
+        if (index + length > text.size()) invalid();
+
+        for (int continuation = 1; continuation < length; continuation++) {
+            uint8_t byte = uint8_t(text[index + continuation]);
+            if ((byte & 0xC0) != 0x80) invalid();
+            codePoint = (codePoint << 6) | (byte & 0x3F);
+        }
+        if (codePoint < smallest || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) invalid();
+
+        codePoints.push_back(codePoint);
+        index += length;
+    }
+    return codePoints;
+}
+
+/// `font-awesome.ttf` becomes `FontAwesome`.
+static std::string typeName(const std::string &path) {
+    std::string base = path.substr(path.find_last_of('/') + 1);
+    base = base.substr(0, base.find('.'));
+
+    std::string name;
+    bool capitalize = true;
+    for (char character : base) {
+        if (!std::isalnum(uint8_t(character))) {
+            capitalize = true;
+            continue;
+        }
+        name += capitalize ? char(std::toupper(uint8_t(character))) : character;
+        capitalize = false;
+    }
+    if (name.empty() || std::isdigit(uint8_t(name[0]))) name = "Font" + name;
+    return name;
+}
+
+/// A Swift string literal.
+static std::string literal(const std::string &string) {
+    std::string escaped = "\"";
+    for (char character : string) {
+        if (character == '\\' || character == '"') escaped += '\\';
+        escaped += character;
+    }
+    return escaped + "\"";
+}
+
+// MARK: Writing
+
+struct Blob {
+    std::vector<uint8_t> bytes;
+
+    size_t align() {
+        while (bytes.size() % 4) bytes.push_back(0);
+        return bytes.size();
+    }
+
+    void u8(uint8_t value) { bytes.push_back(value); }
+    void u16(uint16_t value) { u8(value & 0xFF), u8(value >> 8); }
+    void u32(uint32_t value) { u16(value & 0xFFFF), u16(value >> 16); }
+    void i16(int16_t value) { u16(uint16_t(value)); }
+    void f32(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, 4);
+        u32(bits);
+    }
+
+    /// Fill in a u32 written earlier.
+    void patch(size_t offset, uint32_t value) {
+        for (int byte = 0; byte < 4; byte++) bytes[offset + byte] = uint8_t(value >> (byte * 8));
+    }
+};
+
+/// A rendered glyph's record. Its alpha map is already in the blob.
+struct Glyph {
+    int16_t x, y, width, height, advance;
+    uint32_t offset, length;
+};
+
+static int16_t narrow(long value, const char *what) {
+    if (value < INT16_MIN || value > INT16_MAX) fail(std::string("Glyph ") + what + " doesn't fit in 16 bits. Is the size too big?");
+    return int16_t(value);
+}
+
+int main(int argc, char **argv) {
+    std::vector<std::string> positional;
+    std::vector<uint32_t> sizes;
+    std::vector<uint32_t> codePoints;
+    std::string name, family;
+
+    for (int index = 1; index < argc; index++) {
+        std::string argument = argv[index];
+        auto value = [&]() -> std::string {
+            if (++index == argc) fail(argument + " needs a value.");
+            return argv[index];
+        };
+
+        if (argument == "--sizes") {
+            for (auto &size : split(value(), ',')) sizes.push_back(parseNumber(size));
+        } else if (argument == "--characters") {
+            for (uint32_t codePoint : decodeUTF8(value())) codePoints.push_back(codePoint);
+        } else if (argument == "--ranges") {
+            for (auto &range : split(value(), ',')) {
+                auto ends = split(range, '-');
+                if (ends.size() > 2 || ends.empty()) fail("Bad range: " + range);
+                uint32_t first = parseNumber(ends.front()), last = parseNumber(ends.back());
+                for (uint32_t codePoint = first; codePoint <= last; codePoint++) codePoints.push_back(codePoint);
+            }
+        } else if (argument == "--name") {
+            name = value();
+        } else if (argument == "--family") {
+            family = value();
+        } else {
+            positional.push_back(argument);
+        }
+    }
+    if (positional.size() != 2 || sizes.empty()) fail(usage);
+    const std::string &input = positional[0], &output = positional[1];
+
+    if (codePoints.empty()) {
+        for (uint32_t codePoint = 0x20; codePoint <= 0x7E; codePoint++) codePoints.push_back(codePoint);
+    }
+    std::sort(codePoints.begin(), codePoints.end());
+    codePoints.erase(std::unique(codePoints.begin(), codePoints.end()), codePoints.end());
+    std::sort(sizes.begin(), sizes.end());
+    sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+    if (name.empty()) name = typeName(input);
+
+    // MARK: Loading
+
+    FT_Library library;
+    FT_Face face;
+    if (FT_Init_FreeType(&library)) fail("Couldn't start FreeType.");
+    if (FT_New_Face(library, input.c_str(), 0, &face)) fail("Couldn't open " + input + " as a font.");
+    if (!FT_IS_SCALABLE(face)) fail(input + " isn't a scalable font.");
+    if (family.empty()) family = face->family_name ? face->family_name : name;
+
+    // Characters the font doesn't have are left out, with a warning.
+    std::vector<uint32_t> present;
+    for (uint32_t codePoint : codePoints) {
+        if (FT_Get_Char_Index(face, codePoint)) {
+            present.push_back(codePoint);
+        } else {
+            std::fprintf(stderr, "SlintFontBaker: %s has no glyph for U+%04X, skipping it.\n", input.c_str(), codePoint);
+        }
+    }
+
+    uint16_t weight = 400;
+    if (auto os2 = static_cast<TT_OS2 *>(FT_Get_Sfnt_Table(face, FT_SFNT_OS2)); os2 && os2->usWeightClass) {
+        weight = os2->usWeightClass;
+    } else if (face->style_flags & FT_STYLE_FLAG_BOLD) {
+        weight = 700;
+    }
+
+    // MARK: Baking
+
+    Blob blob;
+    blob.u8('S'), blob.u8('L'), blob.u8('B'), blob.u8('F');
+    blob.u32(1);
+    blob.f32(face->units_per_EM);
+    blob.f32(face->ascender);
+    blob.f32(face->descender);
+    blob.u16(weight);
+    blob.u8(face->style_flags & FT_STYLE_FLAG_ITALIC ? 1 : 0);
+    blob.u8(0);
+    size_t familyHeader = blob.bytes.size();
+    blob.u32(0), blob.u32(uint32_t(family.size()));
+    size_t characterHeader = blob.bytes.size();
+    blob.u32(0), blob.u32(uint32_t(present.size()));
+    blob.u32(uint32_t(present.size())), blob.u32(uint32_t(sizes.size()));
+    size_t sizesHeader = blob.bytes.size();
+    blob.u32(0);
+
+    blob.patch(familyHeader, uint32_t(blob.align()));
+    for (char character : family) blob.u8(uint8_t(character));
+
+    // Glyphs are numbered by their place in the subset, the same at every size.
+    blob.patch(characterHeader, uint32_t(blob.align()));
+    for (size_t index = 0; index < present.size(); index++) {
+        blob.u32(present[index]);
+        blob.u16(uint16_t(index));
+        blob.u16(0);
+    }
+
+    blob.patch(sizesHeader, uint32_t(blob.align()));
+    size_t sizesTable = blob.bytes.size();
+    for (uint32_t size : sizes) blob.u32(size), blob.u32(0);
+
+    size_t alphaBytes = 0;
+    for (size_t sizeIndex = 0; sizeIndex < sizes.size(); sizeIndex++) {
+        if (FT_Set_Pixel_Sizes(face, 0, sizes[sizeIndex])) fail("Couldn't size " + input + " to " + std::to_string(sizes[sizeIndex]) + "px.");
+
+        // Every glyph's alpha map, then the records, so the records stay together.
+        std::vector<Glyph> glyphs;
+        for (uint32_t codePoint : present) {
+            if (FT_Load_Char(face, codePoint, FT_LOAD_RENDER)) fail("Couldn't render U+" + std::to_string(codePoint) + ".");
+            const FT_GlyphSlot slot = face->glyph;
+            const FT_Bitmap &bitmap = slot->bitmap;
+
+            Glyph glyph;
+            glyph.x = narrow(long(slot->bitmap_left) * 64, "x");
+            glyph.y = narrow((long(slot->bitmap_top) - long(bitmap.rows)) * 64, "y");
+            glyph.width = narrow(bitmap.width, "width");
+            glyph.height = narrow(bitmap.rows, "height");
+            glyph.advance = narrow(slot->advance.x, "advance");
+            glyph.offset = uint32_t(blob.bytes.size());
+            glyph.length = bitmap.width * bitmap.rows;
+            // Rows are packed, whatever FreeType's pitch.
+            for (unsigned row = 0; row < bitmap.rows; row++) {
+                const uint8_t *start = bitmap.buffer + long(row) * bitmap.pitch;
+                blob.bytes.insert(blob.bytes.end(), start, start + bitmap.width);
+            }
+            alphaBytes += glyph.length;
+            glyphs.push_back(glyph);
+        }
+
+        blob.patch(sizesTable + sizeIndex * 8 + 4, uint32_t(blob.align()));
+        for (const Glyph &glyph : glyphs) {
+            blob.i16(glyph.x), blob.i16(glyph.y);
+            blob.i16(glyph.width), blob.i16(glyph.height);
+            blob.i16(glyph.advance);
+            blob.u16(0);
+            blob.u32(glyph.offset), blob.u32(glyph.length);
+        }
+    }
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+
+    // MARK: Generating
+
+    std::string file = input.substr(input.find_last_of('/') + 1);
+    std::string sizeList;
+    for (size_t index = 0; index < sizes.size(); index++) {
+        sizeList += (index == 0 ? "" : index + 1 == sizes.size() ? " and " : ", ") + std::to_string(sizes[index]);
+    }
+
+    // `dir/Inter+Font.swift` gives `dir/Inter+Font.cpp`, `dir/Inter+Font.h`, and `dir/module.modulemap`.
+    std::string stem = output.size() > 6 && output.compare(output.size() - 6, 6, ".swift") == 0 ? output.substr(0, output.size() - 6) : output;
+    size_t slash = output.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "" : output.substr(0, slash + 1);
+    std::string header = stem.substr(stem.find_last_of('/') + 1) + ".h";
+    std::string module = name + "Data";
+    std::string bytesFunction = "slint_baked_" + name + "_bytes", countFunction = "slint_baked_" + name + "_count";
+    std::string generated = "// Generated by SlintFontBaker, from " + file + ". Don't edit.\n\n";
+
+    std::ostringstream swift;
+    swift << generated
+          << "import SlintUI\n"
+          << "import " << module << "\n\n"
+          << "/// `" << family << "`, baked at " << sizeList << "px, for " << present.size() << " characters.\n"
+          << "public enum " << name << " {\n"
+          << "    /// Where it was baked from, to register the font itself at runtime instead.\n"
+          << "    public static let sourcePath = " << literal(input) << "\n\n"
+          << "    /// Register with `SlintComponentInstance.register(_:)`. Points into the static data, without copying it.\n"
+          << "    public static let font = SlintBitmapFont(baked: UnsafeRawBufferPointer(start: " << bytesFunction << "(), count: "
+          << countFunction << "()))\n"
+          << "}\n";
+
+    std::ostringstream cHeader;
+    cHeader << generated
+            << "#pragma once\n\n"
+            << "#include <stddef.h>\n"
+            << "#include <stdint.h>\n\n"
+            << "#ifdef __cplusplus\n"
+            << "extern \"C\" {\n"
+            << "#endif\n\n"
+            << "/// " << blob.bytes.size() << " bytes, " << alphaBytes << " of them glyph alpha maps. Static, so never freed.\n"
+            << "const uint8_t *" << bytesFunction << "(void);\n"
+            << "size_t " << countFunction << "(void);\n\n"
+            << "#ifdef __cplusplus\n"
+            << "}\n"
+            << "#endif\n";
+
+    std::ostringstream source;
+    source << generated
+           << "#include \"" << header << "\"\n\n"
+           << "// Tables are 4-byte aligned from the start, and read in place.\n"
+           << "alignas(8) static const uint8_t baked[" << blob.bytes.size() << "] = {\n";
+    char hex[8];
+    for (size_t index = 0; index < blob.bytes.size(); index++) {
+        if (index % 16 == 0) source << "   ";
+        std::snprintf(hex, sizeof hex, " 0x%02x,", blob.bytes[index]);
+        source << hex;
+        if (index % 16 == 15 || index + 1 == blob.bytes.size()) source << "\n";
+    }
+    source << "};\n\n"
+           << "const uint8_t *" << bytesFunction << "(void) { return baked; }\n"
+           << "size_t " << countFunction << "(void) { return sizeof baked; }\n";
+
+    std::ostringstream moduleMap;
+    moduleMap << "// Generated by SlintFontBaker. Don't edit.\n\n"
+              << "module " << module << " {\n"
+              << "    header \"" << header << "\"\n"
+              << "}\n";
+
+    auto write = [](const std::string &path, const std::string &contents) {
+        std::ofstream stream(path, std::ios::binary);
+        stream << contents;
+        if (!stream) fail("Couldn't write " + path + ".");
+    };
+    write(output, swift.str());
+    write(stem + ".cpp", source.str());
+    write(stem + ".h", cHeader.str());
+    write(directory + "module.modulemap", moduleMap.str());
+    return 0;
+}
@@ -0,0 +1,118 @@
+//
+//  ImageDecoders.cpp
+//  slint
+//
+//  Slint's own loader isn't used: its cache is per thread, and the `Image` it makes mustn't leave the thread that made it.
+//
+
+#include "SlintImageDecoders.h"
+
+#include <csetjmp>
+#include <cstdio>
+#include <png.h>
+#include <jpeglib.h>
+#include <slint.h>
+
+using Rgba8PixelBuffer = slint::SharedPixelBuffer<slint::Rgba8Pixel>;
+
+namespace {
+
+/// Checked before allocating, against the size the header claims.
+bool fits(uint32_t width, uint32_t height) {
+    return width > 0 && height > 0 && uint64_t(width) * height <= slint_swift_pixel_buffer_max_pixels();
+}
+
+/// libjpeg reports errors by calling `error_exit`, which mustn't return. So it jumps back to the decode.
+struct JpegError {
+    jpeg_error_mgr manager;
+    std::jmp_buf jump;
+};
+
+void jpeg_error_exit(j_common_ptr info) {
+    std::longjmp(reinterpret_cast<JpegError *>(info->err)->jump, 1);
+}
+
+/// Decode a JPEG, in one pass: the header gives the size, then the scanlines go straight into the buffer.
+/// Only C state, and the buffer, live between `setjmp` and a failure, so jumping back skips no destructors.
+Rgba8PixelBuffer *jpeg_decode(const uint8_t *data, size_t length) {
+    jpeg_decompress_struct info;
+    JpegError error;
+    info.err = jpeg_std_error(&error.manager);
+    error.manager.error_exit = jpeg_error_exit;
+    // Warnings about damaged data would go to stderr. A decode that fails is reported by returning `nullptr`.
+    error.manager.output_message = [](j_common_ptr) {};
+
+    // Set after `setjmp`, and read after jumping back, so it has to be volatile.
+    Rgba8PixelBuffer *volatile buffer = nullptr;
+    if (setjmp(error.jump)) {
+        jpeg_destroy_decompress(&info);
+        delete buffer;
+        return nullptr;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_mem_src(&info, data, static_cast<unsigned long>(length));
+    jpeg_read_header(&info, TRUE);
+
+    // Greyscale is expanded too. CMYK isn't supported, and fails.
+    info.out_color_space = JCS_RGB;
+    jpeg_calc_output_dimensions(&info);
+    if (!fits(info.output_width, info.output_height)) {
+        jpeg_destroy_decompress(&info);
+        return nullptr;
+    }
+
+    buffer = new Rgba8PixelBuffer(info.output_width, info.output_height);
+    auto rgba = reinterpret_cast<uint8_t *>(buffer->begin());
+    jpeg_start_decompress(&info);
+
+    // Freed by `jpeg_destroy_decompress`, even after a failure.
+    JSAMPARRAY row = (*info.mem->alloc_sarray)(reinterpret_cast<j_common_ptr>(&info), JPOOL_IMAGE, info.output_width * 3, 1);
+    while (info.output_scanline < info.output_height) {
+        uint8_t *out = rgba + size_t(info.output_scanline) * info.output_width * 4;
+        jpeg_read_scanlines(&info, row, 1);
+        for (uint32_t x = 0; x < info.output_width; x++) {
+            out[x * 4 + 0] = row[0][x * 3 + 0];
+            out[x * 4 + 1] = row[0][x * 3 + 1];
+            out[x * 4 + 2] = row[0][x * 3 + 2];
+            out[x * 4 + 3] = 0xFF;
+        }
+    }
+
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+    return buffer;
+}
+
+/// Decode a PNG, with libpng's simplified API, which handles its own errors.
+Rgba8PixelBuffer *png_decode(const uint8_t *data, size_t length) {
+    png_image image {};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_memory(&image, data, length)) return nullptr;
+    if (!fits(image.width, image.height)) {
+        png_image_free(&image);
+        return nullptr;
+    }
+
+    // Straight alpha, which is what Slint's `Rgba8Pixel` holds.
+    image.format = PNG_FORMAT_RGBA;
+    auto buffer = new Rgba8PixelBuffer(image.width, image.height);
+    if (!png_image_finish_read(&image, nullptr, buffer->begin(), 0, nullptr)) {
+        png_image_free(&image);
+        delete buffer;
+        return nullptr;
+    }
+    return buffer;
+}
+
+} // namespace
+
+void *slint_swift_pixel_buffer_decode(const uint8_t *data, size_t length) {
+    if (length >= 8 && png_sig_cmp(data, 0, 8) == 0) {
+        return png_decode(data, length);
+    }
+    if (length >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+        return jpeg_decode(data, length);
+    }
+    return nullptr;
+}
@@ -0,0 +1,21 @@
+//
+//  SlintImageDecoders.h
+//  slint
+//
+//  PNG and JPEG, decoded with libpng and libjpeg, straight into a Slint pixel buffer, on any thread.
+//  Only this header is seen by Swift, so the libraries' headers aren't needed to import it.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Largest image decoded, in pixels: 256 MiB of RGBA. A header claiming more is rejected before anything is allocated.
+inline uint64_t slint_swift_pixel_buffer_max_pixels() {
+    return uint64_t(1) << 26;
+}
+
+/// Decode a PNG or JPEG, told apart by their first bytes. `nullptr` if it's neither, it's broken, or it's too big.
+/// The buffer is the same as `slint_swift_pixel_buffer_new` makes. Free with `slint_swift_pixel_buffer_drop`.
+void *slint_swift_pixel_buffer_decode(const uint8_t *data, size_t length);
@@ -0,0 +1,253 @@
+//
+//  Batch.swift
+//  slint
+//
+
+// For `NSLock`.
+import Foundation
+
+import Atomics
+
+/// Namespace for library-wide functions.
+public enum Slint { }
+
+public extension Slint {
+    /// Run `body` with property writes batched, then apply them all at once.
+    ///
+    /// Writes to a `Property`, or to a component with `SlintComponentInstance.setProperty(_:_:)`, are held until `body` returns.
+    /// Then each property is set once, to the last value written, in the order they were first written.
+    /// While the writes are applied, windows' redraw requests are held too, and each window's is delivered once, at the end.
+    ///
+    /// So dependents are only marked dirty once per property, and bindings aren't evaluated against half-applied writes.
+    /// The catch: inside the batch, reads still see the old values, including reads of properties just written.
+    ///
+    /// Batches nest. Only the outermost one applies the writes.
+    @SlintActor
+    @discardableResult
+    static func batch<R>(_ body: () throws -> R) rethrows -> R {
+        let batch = PropertyBatch.open()
+        defer { PropertyBatch.close(batch) }
+        return try body()
+    }
+
+    /// Write a property from any thread. Applied on the event loop, in a batch, with everything else staged since the last flush.
+    ///
+    /// Staging doesn't lock. Staged writes are flushed once per `stagingFlushInterval`, or by `flushStagedWrites()`.
+    static func stage<T>(_ property: Property<T>, _ value: T) {
+        PropertyBatch.staging.stage(StagedPropertyWrite(property, value))
+    }
+
+    /// Set a component's property from any thread. Applied like `stage(_:_:)`.
+    static func stage(_ instance: SlintComponentInstance, _ name: String, _ value: SlintValue) {
+        PropertyBatch.staging.stage(StagedInstanceWrite(instance, name, value))
+    }
+
+    /// Apply staged writes now, in one batch, instead of waiting for the next flush. E.g. just before rendering a frame.
+    @SlintActor
+    static func flushStagedWrites() {
+        PropertyBatch.staging.flush()
+    }
+
+    /// Milliseconds between flushes of staged writes. One frame, by default.
+    static var stagingFlushInterval: UInt64 {
+        get { PropertyBatch.staging.flushInterval.load(ordering: .relaxed) }
+        set { PropertyBatch.staging.flushInterval.store(newValue, ordering: .relaxed) }
+    }
+}
+
+// MARK: - Batches
+
+/// Writes held by an open batch. Only ever touched on the event loop thread.
+@usableFromInline
+final class PropertyBatch {
+    /// What a write is to. Writes to the same thing replace each other.
+    enum Key: Hashable {
+        case property(ObjectIdentifier)
+        case instance(ObjectIdentifier, String)
+    }
+
+    /// True while a batch is open. Checked on every property write, so it's a plain global, not a lookup.
+    @usableFromInline static var isOpen = false
+
+    /// True while a batch is applying its writes. Windows hold their redraw requests while it's set.
+    static var isCommitting = false
+
+    private static var current: PropertyBatch?
+    private static var depth = 0
+
+    /// Windows that asked for a redraw during the commit, in order, once each.
+    private static var pendingRedraws: [SoftwareWindowAdapter] = []
+
+    /// Writes from other threads.
+    static let staging = StagingBuffer()
+
+    private var writes: [StagedWrite] = []
+    private var indices: [Key: Int] = [:]
+
+    static func open() -> PropertyBatch {
+        depth += 1
+        if let current { return current }
+        let batch = PropertyBatch()
+        current = batch
+        isOpen = true
+        return batch
+    }
+
+    static func close(_ batch: PropertyBatch) {
+        depth -= 1
+        guard depth == 0 else { return }
+        current = nil
+        isOpen = false
+        batch.commit()
+    }
+
+    /// Hold a write in the open batch, replacing any earlier write to the same thing.
+    static func stage(_ write: StagedWrite) {
+        current!.stage(write)
+    }
+
+    /// Hold a window's redraw request until the commit is done. False if there's no commit running.
+    static func deferRedraw(_ window: SoftwareWindowAdapter) -> Bool {
+        guard isCommitting else { return false }
+        if !pendingRedraws.contains(where: { $0 === window }) { pendingRedraws.append(window) }
+        return true
+    }
+
+    private func stage(_ write: StagedWrite) {
+        if let index = indices[write.key] {
+            writes[index] = write
+        } else {
+            indices[write.key] = writes.count
+            writes.append(write)
+        }
+    }
+
+    private func commit() {
+        Self.isCommitting = true
+        for write in writes { write.apply() }
+        Self.isCommitting = false
+
+        let windows = Self.pendingRedraws
+        Self.pendingRedraws.removeAll(keepingCapacity: true)
+        for window in windows { window.onRedrawRequested?() }
+    }
+}
+
+extension Property {
+    /// Hold a write in the open batch.
+    @usableFromInline
+    func stage(_ newValue: T) {
+        PropertyBatch.stage(StagedPropertyWrite(self, newValue))
+    }
+}
+
+// MARK: - Writes
+
+/// A write, held for later.
+class StagedWrite {
+    let key: PropertyBatch.Key
+    /// Order among staged writes, from any thread. Set by `StagingBuffer`. Unused in `Slint.batch`, where writes are in call order.
+    var sequence: UInt64 = 0
+
+    init(_ key: PropertyBatch.Key) {
+        self.key = key
+    }
+
+    /// Do the write. Only on the event loop thread, with no batch open.
+    func apply() { }
+}
+
+final class StagedPropertyWrite<T>: StagedWrite {
+    private let property: Property<T>
+    private let value: T
+
+    init(_ property: Property<T>, _ value: T) {
+        self.property = property
+        self.value = value
+        super.init(.property(ObjectIdentifier(property)))
+    }
+
+    override func apply() {
+        property.store(value)
+    }
+}
+
+final class StagedInstanceWrite: StagedWrite {
+    private let instance: SlintComponentInstance
+    private let name: String
+    private let value: SlintValue
+
+    init(_ instance: SlintComponentInstance, _ name: String, _ value: SlintValue) {
+        self.instance = instance
+        self.name = name
+        self.value = value
+        super.init(.instance(ObjectIdentifier(instance), name))
+    }
+
+    override func apply() {
+        SlintActor.assumeIsolated { _ = instance.applyProperty(name, value) }
+    }
+}
+
+// MARK: - Staging
+
+/// Writes from any thread, on their way to the event loop.
+///
+/// Producers push onto a lock-free queue, and the first one since the last flush schedules the next flush.
+/// Same handshake as `SlintEventLoopExecutor`'s drain: the flush clears `flushScheduled` before it pops,
+/// so a write either makes this flush, or its producer sees the flag cleared, and schedules another.
+///
+/// Each write takes a sequence number before it's pushed, and a flush always applies writes in sequence order, so the newest wins.
+/// Pop order isn't enough: a write can overflow, or lose a race to push, and land behind a newer one.
+final class StagingBuffer {
+    private let queue = JobQueue<StagedWrite>(minimumCapacity: 16_384)
+    private let flushScheduled = ManagedAtomic<Bool>(false)
+    private let nextSequence = ManagedAtomic<UInt64>(0)
+    let flushInterval = ManagedAtomic<UInt64>(16)
+
+    /// Writes that didn't fit in the queue. Only used when the event loop falls far behind.
+    private let overflowLock = NSLock()
+    private var overflow: [StagedWrite] = []
+
+    func stage(_ write: StagedWrite) {
+        write.sequence = nextSequence.loadThenWrappingIncrement(ordering: .relaxed)
+        if !queue.push(write) {
+            overflowLock.lock()
+            overflow.append(write)
+            overflowLock.unlock()
+        }
+
+        if !flushScheduled.exchange(true, ordering: .sequentiallyConsistent) {
+            let interval = flushInterval.load(ordering: .relaxed)
+            Task.detached {
+                try? await Task.sleep(nanoseconds: interval * 1_000_000)
+                await Slint.flushStagedWrites()
+            }
+        }
+    }
+
+    /// Apply everything staged, in one batch. Only on the event loop thread.
+    func flush() {
+        _ = flushScheduled.exchange(false, ordering: .sequentiallyConsistent)
+
+        let batch = PropertyBatch.open()
+        defer { PropertyBatch.close(batch) }
+
+        // The queue first: a producer that overflowed appended before any later push of its own,
+        // so once the queue is empty, the overflow has every write older than the ones popped.
+        // Sorting then puts them all in place.
+        var writes: [StagedWrite] = []
+        while let write = queue.pop() { writes.append(write) }
+
+        overflowLock.lock()
+        let overflowed = overflow
+        overflow.removeAll()
+        overflowLock.unlock()
+
+        // Popped writes are nearly in order already, and Swift's sort is quick on runs that are.
+        writes += overflowed
+        writes.sort { $0.sequence < $1.sequence }
+        // Later writes replace earlier ones to the same thing.
+        for write in writes { PropertyBatch.stage(write) }
+    }
+}
@@ -9,101 +9,125 @@ import Foundation
 
 import SlintFFI
 
-/// CURRENT STATUS: ☠️ DOES NOT WORK ☠️
-/// 
-/// Causes a bus error, with a backtrace:
-/// 
-/// * thread #1, queue = 'com.apple.main-thread', stop reason = EXC_BAD_ACCESS (code=257, address=0x910003fda9bf7bfd)
-///   * frame #0: 0x000003fda9bf7bfd
-///     frame #1: 0x000000010321ac40 libslint_cpp.dylib`core::ptr::drop_in_place$LT$alloc..boxed..Box$LT$dyn$u20$core..ops..function..FnMut$LT$$LP$$RF$$LP$$RP$$C$$RF$mut$u20$$LP$$RP$$RP$$GT$$u2b$Output$u20$$u3d$$u20$$LP$$RP$$GT$$GT$::h389bad9f3a99fcf6((null)=0x000000016fdfef98) at mod.rs:498:1
-///     frame #2: 0x000000010321b044 libslint_cpp.dylib`core::ptr::drop_in_place$LT$core..option..Option$LT$alloc..boxed..Box$LT$dyn$u20$core..ops..function..FnMut$LT$$LP$$RF$$LP$$RP$$C$$RF$mut$u20$$LP$$RP$$RP$$GT$$u2b$Output$u20$$u3d$$u20$$LP$$RP$$GT$$GT$$GT$::h2e784ca1072556b7((null)=0x000000016fdfef98) at mod.rs:498:1
-///     frame #3: 0x00000001031f8b60 libslint_cpp.dylib`core::cell::Cell$LT$T$GT$::set::h5f990a57f826cbf2 at mod.rs:992:24
-///     frame #4: 0x00000001031f8b5c libslint_cpp.dylib`core::cell::Cell$LT$T$GT$::set::h5f990a57f826cbf2(self=0x000000016fdff028, val=Option<alloc::boxed::Box<dyn core::ops::function::FnMut<(&(), &mut ()), Output=()>, alloc::alloc::Global>> @ 0x000000016fdfefb0) at cell.rs:413:9
-///     frame #5: 0x00000001031eb79c libslint_cpp.dylib`slint_callback_set_handler(sig=0x000000016fdff028, binding=(libSlintUI.dylib`@objc closure #1 (Swift.Optional<Swift.UnsafeMutableRawPointer>, Swift.Optional<Swift.UnsafeRawPointer>, Swift.Optional<Swift.UnsafeMutableRawPointer>) -> () in variable initialization expression of static SlintUI.WrappedCallback.bindingCallback : Swift.Optional<@convention(c) (Swift.Optional<Swift.UnsafeMutableRawPointer>, Swift.Optional<Swift.UnsafeRawPointer>, Swift.Optional<Swift.UnsafeMutableRawPointer>) -> ()> at <compiler-generated>), user_data=0x0000600002f10e00, drop_user_data=Option<extern "C" fn(*mut ())> @ 0x000000016fdff050) at callbacks.rs:149:9
-///     frame #6: 0x00000001004a48b8 libSlintUI.dylib`slint_callback_set_handler(sig=0x000000016fdff028, binding=(libSlintUI.dylib`@objc closure #1 (Swift.Optional<Swift.UnsafeMutableRawPointer>, Swift.Optional<Swift.UnsafeRawPointer>, Swift.Optional<Swift.UnsafeMutableRawPointer>) -> () in variable initialization expression of static SlintUI.WrappedCallback.bindingCallback : Swift.Optional<@convention(c) (Swift.Optional<Swift.UnsafeMutableRawPointer>, Swift.Optional<Swift.UnsafeRawPointer>, Swift.Optional<Swift.UnsafeMutableRawPointer>) -> ()> at <compiler-generated>), user_data=0x0000600002f10e00, drop_user_data=(libSlintUI.dylib`@objc closure #1 (Swift.Optional<Swift.UnsafeMutableRawPointer>) -> () in variable initialization expression of static SlintUI.WrappedCallback.dropCallback : Swift.Optional<@convention(c) (Swift.Optional<Swift.UnsafeMutableRawPointer>) -> ()> at <compiler-generated>)) at FFI.h:743:12
-///     frame #7: 0x00000001004a4674 libSlintUI.dylib`SlintCallback.setHandler(closure=0x100002ce8, self=0x0000600002f10da0) at Callback.swift:133:9
-/// 
-/// Looking at the backtrace and disassembly of frame #1, core::ptr::drop_in_place (from Rust) is branching to a SUPER high memory address.
-/// On my machine, it's consistently at 0x000003fda9bf7bfd, even across sessions. IDK.
-/// 
-/// From here: https://opentitan.org/book/doc/rust_for_c_devs.html
-/// > std::ptr::drop_in_place()83 can be used to run the destructor in the value behind a raw pointer, without technically giving up access to it.
-/// 
-/// That would suggest its trying to run a destructor, but getting a crazy value and exploding.
-/// I don't know enough about Rust memory management to say what's really going on.
-/// And I'm not interested in becoming an expert to decode it.
-/// q
-
-/// Private class for wrapped closure. Based on `WrappedClosure`, but modified for callbacks,
-/// which are expected to take arguments and return values.
-fileprivate class WrappedCallback {
-    private var invoke: @SlintActor (UnsafeRawPointer, UnsafeMutableRawPointer) -> Void
-
-    /// Initializer. Type parameters `Arg` and `Ret` are stored in the `invoke` closure.
-    init<Arg, Ret>(_ closure: @SlintActor @escaping @Sendable (Arg) -> Ret) {
-        invoke = { argPtr, retPtr in
-            assert(Thread.current.isMainThread, "Callback not running on main thread!")
-            let arg = argPtr.assumingMemoryBound(to: Arg.self).pointee
-            retPtr.assumingMemoryBound(to: Ret.self).initialize(to: closure(arg))
-        }
+/// Previously, `slint_callback_set_handler` crashed with a bus error, inside Rust's `drop_in_place` for the old handler.
+///
+/// The handle was a stored property, and it was passed to Slint through `withUnsafePointer(to: handle) { $0 }`.
+/// That pointer only lives for the duration of the closure, and points at a temporary copy of the handle, on the stack.
+/// (The backtrace showed `sig=0x000000016fdff028`, a stack address.) So Slint was replacing the handler in garbage,
+/// and tried to drop whatever "handler" that garbage pointed at.
+///
+/// The handle now lives in its own allocation, made once in the initializer, so its address is stable for the lifetime of the callback.
+///
+/// The wrapper also used to capture the `SlintCallback`, which owns the handle, which owns the wrapper. That cycle leaked every callback.
+
+/// Trampoline for callback handlers. Slint calls `bindingCallback` with a pointer to an instance of this class.
+///
+/// This class is never instantiated directly. Subclasses are specialized for the argument and return types,
+/// so a call costs one dynamic dispatch, rather than going through a type-erased closure.
+fileprivate class CallbackTrampoline {
+    /// Invoke the handler.
+    /// - Parameters:
+    ///   - argPtr: Pointer to the argument. May be `nil` if the argument is `Void`.
+    ///   - retPtr: Pointer to storage for the return value. May be `nil` if the return value is `Void`.
+    func call(_ argPtr: UnsafeRawPointer?, _ retPtr: UnsafeMutableRawPointer?) {
+        fatalError("CallbackTrampoline must be subclassed!")
     }
 
     /// Convience method to do an unbalanced retain and get an opaque pointer to this instance.
     /// - Returns: An opaque pointer to this instance.
-    /// 
+    ///
     /// Note: This is meant for Slint APIs, to be passed as `user_data`.
     /// The `drop_user_data` callback you provide MUST use `Unmanaged` to release this instance.
-    /// 
+    ///
     /// See `WrappedClosure.dropCallback` as an example.
-    @inlinable
-    public func getRetainedPointer() -> UnsafeMutableRawPointer {
-        let pointer = Unmanaged<WrappedCallback>.passRetained(self).toOpaque()
-        return pointer
+    final func getRetainedPointer() -> UnsafeMutableRawPointer {
+        Unmanaged<CallbackTrampoline>.passRetained(self).toOpaque()
     }
 
     /// Type alias for the `binding` callback.
     typealias BindingCallback = (@convention(c) (UnsafeMutableRawPointer?, UnsafeRawPointer?, UnsafeMutableRawPointer?) -> Void)?
-    
+
     /// Type alias for the `drop_user_data` callback.
     typealias DropUserDataCallback = (@convention(c) (UnsafeMutableRawPointer?) -> Void)?
 
     /// Binding callback. Invokes the handler.
-    public static let bindingCallback: BindingCallback = { userDataPtr, argPtr, retPtr in
-        // Convert the raw pointer to an instance reference
-        let wrapper = Unmanaged<WrappedCallback>.fromOpaque(userDataPtr!).takeUnretainedValue()
-
-        // Same as `WrappedClosure.invokeCallback`, bit cast to remove isolation requirement.
-        // Because it is isolated, Swift just doesn't let us prove it.
-        unsafeBitCast(
-            wrapper.invoke,
-            to: ((UnsafeRawPointer, UnsafeMutableRawPointer) -> Void).self
-        )(argPtr!, retPtr!)
-    }
-    
-    /// Drop user data callback. Releases the wrapper.
-    public static let dropCallback: DropUserDataCallback = { userDataPtr in
-        // Convert the raw pointer to an unmanaged instance
-        Unmanaged<WrappedCallback>.fromOpaque(userDataPtr!).release()
+    static let bindingCallback: BindingCallback = { userDataPtr, argPtr, retPtr in
+        let trampoline = Unmanaged<CallbackTrampoline>.fromOpaque(userDataPtr!).takeUnretainedValue()
+        traced(.callback) { trampoline.call(argPtr, retPtr) }
+    }
+
+    /// Drop user data callback. Releases the trampoline.
+    static let dropCallback: DropUserDataCallback = { userDataPtr in
+        Unmanaged<CallbackTrampoline>.fromOpaque(userDataPtr!).release()
+    }
+}
+
+/// Trampoline for any argument and return types.
+/// The argument is copied out of Slint's storage, and the result is initialized into it.
+fileprivate final class TypedCallbackTrampoline<Arg, Ret>: CallbackTrampoline {
+    private let closure: @SlintActor (Arg) -> Ret
+
+    init(_ closure: @SlintActor @escaping (Arg) -> Ret) {
+        self.closure = closure
+    }
+
+    override func call(_ argPtr: UnsafeRawPointer?, _ retPtr: UnsafeMutableRawPointer?) {
+        // `Void` arguments and return values may come with `nil` pointers.
+        let arg = MemoryLayout<Arg>.size == 0
+            ? unsafeBitCast((), to: Arg.self)
+            : argPtr!.assumingMemoryBound(to: Arg.self).pointee
+
+        // Slint only invokes callbacks on the event loop thread. Same as `WrappedClosure.invokeCallback`.
+        let result = SlintActor.assumeIsolated { closure(arg) }
+
+        if MemoryLayout<Ret>.size > 0 {
+            retPtr!.assumingMemoryBound(to: Ret.self).initialize(to: result)
+        }
+    }
+}
+
+/// Trampoline for trivial argument and return types: `Void`, `Int32`, `Float`, `Bool`, and tuples of them.
+/// The argument is loaded straight out of Slint's storage, and the result is stored straight into it. No copies, retains or releases.
+fileprivate final class TrivialCallbackTrampoline<Arg, Ret>: CallbackTrampoline {
+    private let closure: @SlintActor (Arg) -> Ret
+
+    init(_ closure: @SlintActor @escaping (Arg) -> Ret) {
+        assert(_isPOD(Arg.self) && _isPOD(Ret.self), "TrivialCallbackTrampoline used with non-trivial types!")
+        self.closure = closure
+    }
+
+    override func call(_ argPtr: UnsafeRawPointer?, _ retPtr: UnsafeMutableRawPointer?) {
+        // Zero-sized types (`Void`, empty tuples) may come with a `nil` pointer. There's nothing to load anyway.
+        let arg = MemoryLayout<Arg>.size == 0
+            ? unsafeBitCast((), to: Arg.self)
+            : argPtr!.load(as: Arg.self)
+
+        // Same as `WrappedClosure.invokeCallback`.
+        let result = SlintActor.assumeIsolated { closure(arg) }
+
+        if MemoryLayout<Ret>.size > 0 {
+            retPtr!.storeBytes(of: result, as: Ret.self)
+        }
     }
 }
 
 /// Calls a closure when invoked. Can take arguments, and return a result.
 @SlintActor
 public class SlintCallback<Arg, Ret> {
-    /// Handle for the callback this instance controls.
-    private var handle: CallbackOpaque = CallbackOpaque()
-    /// Convience. Get an unsafe pointer to the handle.
-    private var handleUnsafe: UnsafePointer<CallbackOpaque> {
-        withUnsafePointer(to: handle) { $0 }
-    }
+    /// Handle for the callback this instance controls. Heap allocated, because Slint needs its address to be stable.
+    private let handle: UnsafeMutablePointer<CallbackOpaque>
+
+    /// True once a handler has been set. Invoking without one leaves the return value uninitialized.
+    private var hasHandler = false
+
+    /// True if both `Arg` and `Ret` are trivial, and can take the fast path.
+    private static var isTrivial: Bool { _isPOD(Arg.self) && _isPOD(Ret.self) }
 
     /// Initializer. Creates a callback.
-    public init(_ argType: Arg.Type = Arg.self, _ retType: Ret.Type = Ret.self) {
-        debugPrint(handle)
-        withUnsafeMutablePointer(to: &handle) { handleOpaque in
-            slint_callback_init(handleOpaque)
-        }
-        debugPrint(handle)
+    nonisolated public init(_ argType: Arg.Type = Arg.self, _ retType: Ret.Type = Ret.self) {
+        handle = .allocate(capacity: 1)
+        handle.initialize(to: CallbackOpaque())
+        slint_callback_init(handle)
     }
 
     /// Convience initializer. Creates a callback and sets the handler.
@@ -116,61 +140,72 @@ public class SlintCallback<Arg, Ret> {
         setHandler(closure)
     }
 
-    /// Deinitializer. Drops a callback.
+    /// Deinitializer. Drops a callback, which releases the handler.
     deinit {
-        withUnsafeMutablePointer(to: &handle) { handleOpaque in
-            slint_callback_drop(handleOpaque)
-        }
+        slint_callback_drop(handle)
+        handle.deinitialize(count: 1)
+        handle.deallocate()
     }
 
     /// Set the handler for this callback.
     /// - Parameter closure: The closure to invoke when the callback is invoked.
     public func setHandler(_ closure: @SlintActor @escaping @Sendable (Arg) -> Ret) {
-        // Create a wrapper.
-        // Like Timer, we must prevent Swift from dropping this unless Slint drops `user_data`.
-        // Once Slint does, the closure will be released, and thus this Callback instance.
-        let wrapper = WrappedCallback { arg in
-            withExtendedLifetime(self) { return closure(arg) }
-        }
+        // Slint owns the trampoline from here, and releases it when the handler is replaced, or the callback dropped.
+        // It must not capture `self`: `self` owns the handle, which owns the trampoline.
+        let trampoline: CallbackTrampoline = Self.isTrivial
+            ? TrivialCallbackTrampoline(closure)
+            : TypedCallbackTrampoline(closure)
 
         slint_callback_set_handler(
-            handleUnsafe,
-            WrappedCallback.bindingCallback,
-            wrapper.getRetainedPointer(),
-            WrappedCallback.dropCallback
+            handle,
+            CallbackTrampoline.bindingCallback,
+            trampoline.getRetainedPointer(),
+            CallbackTrampoline.dropCallback
         )
+
+        hasHandler = true
     }
 
     /// Invoke the callback with the given arguments.
-    /// - Parameter arg: The arguments to pass to the callback.
+    /// - Parameter arg: The arguments to pass to the callback. Passed by reference to Slint, never copied.
     /// - Returns: The return value of the closure.
+    ///
+    /// The return value is written into stack storage, so invoking never allocates.
     public func invoke(_ arg: Arg) -> Ret {
-        // Allocate space for the return value
-        let retUnsafe = UnsafeMutableRawPointer.allocate(
-            byteCount: MemoryLayout<Ret>.size,
-            alignment: MemoryLayout<Ret>.alignment
-        )
-        // Release it when the function exits, so it doesn't leak.
-        defer { retUnsafe.deallocate() }
-
         withUnsafePointer(to: arg) { argUnsafe in
-            // Invoke the handler
-            slint_callback_call(handleUnsafe, argUnsafe, retUnsafe)
+            callReturning { retUnsafe in
+                slint_callback_call(handle, argUnsafe, retUnsafe)
+            }
         }
+    }
 
-        // Return the value.
-        return retUnsafe.assumingMemoryBound(to: Ret.self).pointee
+    /// Run `call` with uninitialized stack storage for the return value, then move the value out.
+    private func callReturning(_ call: (UnsafeMutableRawPointer) -> Void) -> Ret {
+        withUnsafeTemporaryAllocation(of: Ret.self, capacity: 1) { retBuffer in
+            let retUnsafe = UnsafeMutableRawPointer(retBuffer.baseAddress!)
+
+            if Self.isTrivial {
+                // Without a handler, this is what the caller gets back. Same as the C++ bindings, which value-initialize.
+                retUnsafe.initializeMemory(as: UInt8.self, repeating: 0, count: MemoryLayout<Ret>.size)
+            } else {
+                precondition(hasHandler, "Invoked a SlintCallback with a non-trivial return type, but no handler!")
+            }
+
+            call(retUnsafe)
+
+            return retBuffer.baseAddress!.move()
+        }
     }
 }
 
-// Extension. Removes allocating space for the return pointer, if the callback doesn't return anything.
+// Extension. Skips the return storage entirely, if the callback doesn't return anything.
 public extension SlintCallback where Ret == Void {
     /// Invoke the callback with the given arguments.
     /// - Parameter arg: The arguments to pass to the callback.
     func invoke(_ arg: Arg) -> Void {
         // Invoke the handler
         withUnsafePointer(to: arg) { argUnsafe in
-            slint_callback_call(handleUnsafe, argUnsafe, nil)
+            slint_callback_call(handle, argUnsafe, nil)
         }
     }
 }
@@ -179,25 +214,15 @@ public extension SlintCallback where Arg == Void {
     /// Invoke the callback with no arguments.
     /// - Returns: The return value of the closure.
     func invoke() -> Ret {
-        // Allocate space for the return value
-        let retUnsafe = UnsafeMutableRawPointer.allocate(
-            byteCount: MemoryLayout<Ret>.size,
-            alignment: MemoryLayout<Ret>.alignment
-        )
-        // Release it when the function exits, so it doesn't leak.
-        defer { retUnsafe.deallocate() }
-
-        // Invoke the handler
-        slint_callback_call(handleUnsafe, nil, retUnsafe)
-
-        // Return the value.
-        return retUnsafe.assumingMemoryBound(to: Ret.self).pointee
+        callReturning { retUnsafe in
+            slint_callback_call(handle, nil, retUnsafe)
+        }
     }
 }
 
 public extension SlintCallback where Arg == Void, Ret == Void {
     /// Invoke the callback with no arguments.
     func invoke() -> Void {
-        slint_callback_call(handleUnsafe, nil, nil)
+        slint_callback_call(handle, nil, nil)
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,78 @@
+//
+// Computed.swift
+// slint
+//
+
+/// A value computed from properties, and cached until one of them changes.
+///
+/// For derived state that's expensive to compute, like a filtered and sorted list, or formatted text.
+/// The first read runs the closure, and records the properties it read, with a `PropertyTracker`.
+/// Later reads return the cached value, until one of those properties changes. Then the next read runs it again.
+/// Nothing is computed eagerly: changes only mark the value stale.
+///
+/// ```swift
+/// let items = Property<[Item]>([])
+/// let query = Property<String>("")
+/// let visible = SlintComputed { items.value.filter { $0.name.contains(query.value) }.sorted() }
+/// print(visible.value) // Filters and sorts.
+/// print(visible.value) // Cached.
+/// query.value = "bolt"
+/// print(visible.value) // Filters and sorts again.
+/// ```
+///
+/// Or as a property wrapper: `@SlintComputed({ … }) var visible: [Item]`.
+///
+/// Only reads of `Property` values, component properties, and other computed values are tracked.
+/// Anything else the closure reads, like a plain Swift variable, won't make it stale. Call `invalidate()` when one of those changes.
+@SlintActor
+@propertyWrapper
+public final class SlintComputed<T> {
+    private let compute: @SlintActor () -> T
+    private var cached: T?
+    private var isBound = false
+
+    /// Records what `compute` read. Dirty once any of it changes.
+    private let tracker = PropertyTracker()
+
+    /// Depends on `tracker`, and runs `compute` when it's dirty. Whatever reads `value` depends on this in turn,
+    /// so a binding, or another computed value, is marked dirty when this one goes stale, even if it only ever read the cache.
+    private let revision = Property<Int>(0)
+
+    /// How many times the closure has run.
+    public private(set) var recomputations = 0
+
+    /// Initializer. Nothing runs until the first read.
+    public nonisolated init(_ compute: @escaping @SlintActor () -> T) {
+        self.compute = compute
+    }
+
+    /// The value. Computed if it's stale, or hasn't been yet.
+    public var value: T {
+        if !isBound { bind() }
+        _ = revision.value
+        return cached!
+    }
+
+    public var wrappedValue: T { value }
+
+    /// Whether the next read will run the closure.
+    public var isStale: Bool {
+        !isBound || tracker.isDirty || revision.isDirty
+    }
+
+    /// Mark the value stale, so the next read runs the closure. Whatever depends on it is marked dirty too.
+    public func invalidate() {
+        bind()
+    }
+
+    /// (Re)bind `revision`. Binding marks it, and its dependents, dirty, so it's evaluated on the next read.
+    private func bind() {
+        isBound = true
+        revision.setBinding { [unowned self] in
+            // Not a dependency root, so `revision` depends on the tracker.
+            cached = tracker.evaluate { compute() }
+            recomputations += 1
+            return recomputations
+        }
+    }
+}
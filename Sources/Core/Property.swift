@@ -0,0 +1,334 @@
+//
+//  Property.swift
+//  slint
+//
+//  Created by Matthew Taylor on 2/6/24.
+//
+
+import SlintFFI
+
+/// Handle and value, side by side. Slint keeps pointers to the handle, so it's allocated once, and never moves.
+@usableFromInline
+struct PropertyStorage<T> {
+    @usableFromInline var handle: PropertyHandleOpaque
+    @usableFromInline var value: T
+}
+
+/// A property stores either a value, or a binding to other properties, and tracks what depends on it.
+///
+/// Reading `value` inside a binding makes it a dependency: when the property changes,
+/// the binding is marked dirty, and evaluated again the next time it's read.
+///
+/// ```swift
+/// let width = Property<Float>(100)
+/// let doubled = Property<Float>(0)
+/// doubled.setBinding { width.value * 2 }
+/// width.value = 150
+/// print(doubled.value) // 300
+/// ```
+///
+/// Same as the C++ `slint::private_api::Property`: Slint only ever sees the handle, and a pointer to the value.
+/// Reading calls `slint_property_update` with that pointer, so a dirty binding writes straight into it.
+/// Nothing is allocated per read, and for trivial types like `Int32`, `Float`, `Bool` and `Color`, a read is a call and a load.
+@SlintActor
+public final class Property<T> {
+    /// Slint's handle. Inside `storage`.
+    @usableFromInline let handle: UnsafeMutablePointer<PropertyHandleOpaque>
+    /// The current value. Inside `storage`. Only up to date after `slint_property_update`.
+    @usableFromInline let valuePointer: UnsafeMutablePointer<T>
+
+    private let storage: UnsafeMutablePointer<PropertyStorage<T>>
+
+    /// Initializer. Sets the initial value. Nonisolated, because nothing depends on the property yet.
+    public nonisolated init(_ initialValue: T) {
+        storage = .allocate(capacity: 1)
+        storage.initialize(to: PropertyStorage(handle: PropertyHandleOpaque(), value: initialValue))
+
+        let base = UnsafeMutableRawPointer(storage)
+        handle = (base + MemoryLayout<PropertyStorage<T>>.offset(of: \.handle)!).assumingMemoryBound(to: PropertyHandleOpaque.self)
+        valuePointer = (base + MemoryLayout<PropertyStorage<T>>.offset(of: \.value)!).assumingMemoryBound(to: T.self)
+
+        slint_property_init(handle)
+    }
+
+    /// Deinitializer. Drops the binding, if any, and tells dependents the property is gone.
+    deinit {
+        slint_property_drop(handle)
+        storage.deinitialize(count: 1)
+        storage.deallocate()
+    }
+
+    /// The value. Reading it evaluates the binding if it's dirty, and registers a dependency if a binding is being evaluated.
+    /// Setting it removes the binding, unless it's two-way, and marks dependents dirty. In `Slint.batch`, setting is held until the batch ends.
+    /// For `Equatable` values, setting the value it already has does nothing. See the extension below.
+    @inlinable
+    public var value: T {
+        get { load() }
+        set { set(newValue) }
+    }
+
+    /// Set the value. Same as assigning to `value`.
+    @inlinable
+    public func set(_ newValue: T) {
+        if PropertyBatch.isOpen { stage(newValue) } else { store(newValue) }
+    }
+
+    /// Whether the binding needs evaluating.
+    public var isDirty: Bool {
+        slint_property_is_dirty(handle)
+    }
+
+    /// Mark the property dirty, so dependents are evaluated again, as if it changed.
+    public func markDirty() {
+        slint_property_mark_dirty(handle)
+    }
+
+    /// Bind the property to a closure. It's evaluated lazily, when the property is read while dirty.
+    ///
+    /// Properties read by the closure become dependencies. It should only read properties, not change them.
+    public func setBinding(_ binding: @escaping @SlintActor () -> T) {
+        slint_property_set_binding(
+            handle,
+            AnyPropertyBinding.evaluateCallback,
+            PropertyBinding(binding).retainedPointer(),
+            AnyPropertyBinding.dropCallback,
+            nil,
+            nil
+        )
+    }
+
+    /// Link two properties, so they always have the same value. Setting, or binding, either sets both.
+    ///
+    /// The value starts out as `second`'s. If `second` has a binding, it's kept, and drives both.
+    public static func linkTwoWay(_ first: Property<T>, _ second: Property<T>) {
+        let shared = Property<T>(second.value)
+
+        // Move `second`'s binding over, like the C++ bindings do. Only a handle with a binding can move:
+        // without one, the handle is the head of a list that points back at it.
+        if second.hasBinding {
+            swap(&shared.handle.pointee, &second.handle.pointee)
+        }
+
+        for property in [first, second] {
+            slint_property_set_binding(
+                property.handle,
+                AnyPropertyBinding.evaluateCallback,
+                TwoWayBinding(shared).retainedPointer(),
+                AnyPropertyBinding.dropCallback,
+                AnyPropertyBinding.interceptSetCallback,
+                AnyPropertyBinding.interceptSetBindingCallback
+            )
+        }
+    }
+
+    // MARK: Unchecked access
+
+    /// Whether the property has a binding, two-way or not. A bit in the handle.
+    @inlinable
+    nonisolated var hasBinding: Bool {
+        handle.pointee._0 & 0b10 == 0b10
+    }
+
+    /// Read the value. Only on the event loop thread. For bindings, which Slint calls while something is reading.
+    @inlinable
+    nonisolated func load() -> T {
+        slint_property_update(handle, valuePointer)
+        return valuePointer.pointee
+    }
+
+    /// Set the value. Only on the event loop thread.
+    @inlinable
+    nonisolated func store(_ newValue: T) {
+        valuePointer.pointee = newValue
+        slint_property_set_changed(handle, valuePointer)
+    }
+}
+
+public extension Property where T: Equatable {
+    /// The value. Same as for any other type, except that setting the value it already has does nothing,
+    /// so dependents aren't marked dirty. Declared again here, because the unconstrained setter can't see this `set(_:)`.
+    @inlinable
+    var value: T {
+        get { load() }
+        set { set(newValue) }
+    }
+
+    /// Set the value, unless it's the same. Dependents are only marked dirty by a real change.
+    /// A binding is always replaced, even by the value it last gave.
+    @inlinable
+    func set(_ newValue: T) {
+        if PropertyBatch.isOpen { return stage(newValue) }
+        // Without a binding, the stored value is current. Comparing it directly, rather than after `slint_property_update`,
+        // doesn't make a binding that's being evaluated depend on this property.
+        guard hasBinding || valuePointer.pointee != newValue else { return }
+        store(newValue)
+    }
+}
+
+// MARK: - Animations
+
+public extension PropertyAnimation {
+    /// An animation with linear easing. Set `easing` for anything else.
+    /// - Parameters:
+    ///   - duration: Milliseconds.
+    ///   - delay: Milliseconds before it starts.
+    ///   - iterationCount: Times to run. Negative runs forever.
+    init(duration: Int32, delay: Int32 = 0, iterationCount: Float = 1) {
+        self.init()
+        self.duration = duration
+        self.delay = delay
+        iteration_count = iterationCount
+    }
+}
+
+public extension Property where T == Int32 {
+    /// Animate from the current value to a new one.
+    func setAnimatedValue(_ newValue: Int32, animation: PropertyAnimation) {
+        withUnsafePointer(to: animation) { slint_property_set_animated_value_int(handle, value, newValue, $0) }
+    }
+
+    /// Bind the property to a closure, and animate whenever the result changes.
+    func setBinding(animation: PropertyAnimation, _ binding: @escaping @SlintActor () -> Int32) {
+        withUnsafePointer(to: animation) { animation in
+            slint_property_set_animated_binding_int(
+                handle,
+                { userData, value in value!.pointee = PropertyBinding<Int32>.from(userData).evaluate() },
+                PropertyBinding(binding).retainedPointer(),
+                AnyPropertyBinding.dropCallback,
+                animation,
+                nil
+            )
+        }
+    }
+}
+
+public extension Property where T == Float {
+    /// Animate from the current value to a new one.
+    func setAnimatedValue(_ newValue: Float, animation: PropertyAnimation) {
+        withUnsafePointer(to: animation) { slint_property_set_animated_value_float(handle, value, newValue, $0) }
+    }
+
+    /// Bind the property to a closure, and animate whenever the result changes.
+    func setBinding(animation: PropertyAnimation, _ binding: @escaping @SlintActor () -> Float) {
+        withUnsafePointer(to: animation) { animation in
+            slint_property_set_animated_binding_float(
+                handle,
+                { userData, value in value!.pointee = PropertyBinding<Float>.from(userData).evaluate() },
+                PropertyBinding(binding).retainedPointer(),
+                AnyPropertyBinding.dropCallback,
+                animation,
+                nil
+            )
+        }
+    }
+}
+
+public extension Property where T == Color {
+    /// Animate from the current value to a new one.
+    func setAnimatedValue(_ newValue: Color, animation: PropertyAnimation) {
+        withUnsafePointer(to: animation) { slint_property_set_animated_value_color(handle, value, newValue, $0) }
+    }
+
+    /// Bind the property to a closure, and animate whenever the result changes.
+    func setBinding(animation: PropertyAnimation, _ binding: @escaping @SlintActor () -> Color) {
+        withUnsafePointer(to: animation) { animation in
+            slint_property_set_animated_binding_color(
+                handle,
+                { userData, value in value!.pointee = PropertyBinding<Color>.from(userData).evaluate() },
+                PropertyBinding(binding).retainedPointer(),
+                AnyPropertyBinding.dropCallback,
+                animation,
+                nil
+            )
+        }
+    }
+}
+
+// MARK: - Bindings
+
+/// What Slint holds for a binding. The C callbacks can't be generic, so they call through this, and subclasses know the type.
+class AnyPropertyBinding {
+    /// Write the binding's value to `value`, a `T` that's already initialized.
+    func evaluate(into value: UnsafeMutableRawPointer) { }
+
+    /// Something set the property. True to keep the binding.
+    func interceptSet(_ value: UnsafeRawPointer) -> Bool { false }
+
+    /// Something bound the property. True to keep this binding.
+    func interceptSetBinding(_ binding: UnsafeMutableRawPointer) -> Bool { false }
+
+    /// A retained pointer, for Slint's `user_data`. Released by `dropCallback`.
+    func retainedPointer() -> UnsafeMutableRawPointer {
+        Unmanaged.passRetained(self).toOpaque()
+    }
+
+    static func from(_ userData: UnsafeMutableRawPointer?) -> AnyPropertyBinding {
+        Unmanaged<AnyPropertyBinding>.fromOpaque(userData!).takeUnretainedValue()
+    }
+
+    static let evaluateCallback: (@convention(c) (UnsafeMutableRawPointer?, UnsafeMutableRawPointer?) -> Void)? = { userData, value in
+        AnyPropertyBinding.from(userData).evaluate(into: value!)
+    }
+
+    static let dropCallback: (@convention(c) (UnsafeMutableRawPointer?) -> Void)? = { userData in
+        Unmanaged<AnyPropertyBinding>.fromOpaque(userData!).release()
+    }
+
+    static let interceptSetCallback: (@convention(c) (UnsafeMutableRawPointer?, UnsafeRawPointer?) -> Bool)? = { userData, value in
+        AnyPropertyBinding.from(userData).interceptSet(value!)
+    }
+
+    static let interceptSetBindingCallback: (@convention(c) (UnsafeMutableRawPointer?, UnsafeMutableRawPointer?) -> Bool)? = { userData, binding in
+        AnyPropertyBinding.from(userData).interceptSetBinding(binding!)
+    }
+}
+
+/// A closure binding.
+final class PropertyBinding<T>: AnyPropertyBinding {
+    /// The closure, without its isolation. Slint only evaluates bindings while a property is read, on the event loop,
+    /// so it's dropped once, here, instead of checked on every evaluation.
+    private let binding: () -> T
+
+    init(_ binding: @escaping @SlintActor () -> T) {
+        self.binding = unsafeBitCast(binding, to: (() -> T).self)
+    }
+
+    static func from(_ userData: UnsafeMutableRawPointer?) -> PropertyBinding<T> {
+        Unmanaged<PropertyBinding<T>>.fromOpaque(userData!).takeUnretainedValue()
+    }
+
+    @inline(__always)
+    func evaluate() -> T { binding() }
+
+    override func evaluate(into value: UnsafeMutableRawPointer) {
+        if _isPOD(T.self) {
+            // Nothing to release in the old value, so just overwrite it.
+            value.storeBytes(of: binding(), as: T.self)
+        } else {
+            value.assumingMemoryBound(to: T.self).pointee = binding()
+        }
+    }
+}
+
+/// One side of a two-way link. Both sides read, write, and bind through a shared property.
+final class TwoWayBinding<T>: AnyPropertyBinding {
+    private let shared: Property<T>
+
+    init(_ shared: Property<T>) {
+        self.shared = shared
+    }
+
+    override func evaluate(into value: UnsafeMutableRawPointer) {
+        value.assumingMemoryBound(to: T.self).pointee = shared.load()
+    }
+
+    override func interceptSet(_ value: UnsafeRawPointer) -> Bool {
+        shared.store(value.assumingMemoryBound(to: T.self).pointee)
+        return true
+    }
+
+    override func interceptSetBinding(_ binding: UnsafeMutableRawPointer) -> Bool {
+        slint_property_set_binding_internal(shared.handle, binding)
+        return true
+    }
+}
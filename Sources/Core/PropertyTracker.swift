@@ -0,0 +1,64 @@
+//
+// PropertyTracker.swift
+// slint
+//
+// Created by Matthew Taylor on 2/6/24.
+//
+
+import SlintFFI
+
+/// Records which properties a closure reads, and notices when any of them change.
+///
+/// Same as the C++ `slint::private_api::PropertyTracker`. Slint links each property read during `evaluate(_:)` back to the tracker,
+/// so the handle lives in its own allocation, and never moves.
+///
+/// The prototype passed Slint a pointer to a local variable holding the closure's wrapper, and nothing retained the closure itself.
+/// Here the closure is only borrowed for the duration of the call, which is all Slint needs.
+@SlintActor
+public final class PropertyTracker {
+    private let handle: UnsafeMutablePointer<PropertyTrackerOpaque>
+
+    /// Initializer. Nonisolated, because nothing has been tracked yet.
+    public nonisolated init() {
+        handle = .allocate(capacity: 1)
+        slint_property_tracker_init(handle)
+    }
+
+    /// Deinitializer. Unlinks the tracker from everything it read.
+    deinit {
+        slint_property_tracker_drop(handle)
+        handle.deallocate()
+    }
+
+    /// Whether anything read during the last evaluation has changed since.
+    public var isDirty: Bool {
+        slint_property_tracker_is_dirty(handle)
+    }
+
+    /// Run `body`, and track the properties it reads, replacing whatever was tracked before. Clears `isDirty`.
+    ///
+    /// - Parameters:
+    ///   - asDependencyRoot: If false, and this runs while a binding is being evaluated, the binding depends on what `body` reads too.
+    ///     If true, it doesn't: only this tracker does.
+    ///   - body: The closure. It should only read properties, not change them.
+    public func evaluate<R>(asDependencyRoot: Bool = false, _ body: () -> R) -> R {
+        var result: R?
+        withoutActuallyEscaping(body) { body in
+            var run: () -> Void = { result = body() }
+            withUnsafeMutablePointer(to: &run) { run in
+                if asDependencyRoot {
+                    slint_property_tracker_evaluate_as_dependency_root(handle, Self.evaluateCallback, run)
+                } else {
+                    slint_property_tracker_evaluate(handle, Self.evaluateCallback, run)
+                }
+            }
+        }
+        // Slint always calls back before returning.
+        return result!
+    }
+
+    /// Calls the `() -> Void` that `userData` points to.
+    private static let evaluateCallback: (@convention(c) (UnsafeMutableRawPointer?) -> Void)? = { userData in
+        userData!.assumingMemoryBound(to: (() -> Void).self).pointee()
+    }
+}
@@ -0,0 +1,149 @@
+//
+//  SharedString.swift
+//  slint
+//
+
+// For `NSLock`.
+import Foundation
+
+import SlintFFI
+
+/// Slint's string, imported from C++. Reference counted: Swift copies it through its C++ copy constructor,
+/// which retains the same bytes, rather than copying them.
+///
+/// These let Swift code read the bytes in place, and make one from a Swift `String` with a single copy.
+/// Strings that are written over and over, like labels, can be interned, so they're only made once.
+extension SharedString {
+    /// Make a Slint string from a Swift string. The UTF-8 bytes are copied once, straight into Slint's buffer.
+    /// Native Swift strings are read in place. Only bridged ones, that aren't stored as UTF-8, are made contiguous first.
+    public init(_ string: String) {
+        self.init(contentsOf: string)
+    }
+
+    /// Make a Slint string from part of a Swift string, with one copy.
+    public init(_ substring: Substring) {
+        self.init(contentsOf: substring)
+    }
+
+    private init<S: StringProtocol>(contentsOf string: S) {
+        if string.isEmpty {
+            // Slint's shared empty string. No allocation.
+            self.init()
+        } else if let shared = string.utf8.withContiguousStorageIfAvailable({ Self(utf8: $0) }) {
+            self = shared
+        } else {
+            var string = String(string)
+            self = string.withUTF8 { Self(utf8: $0) }
+        }
+    }
+
+    /// Make a Slint string from UTF-8 bytes, copied once.
+    public init(utf8 bytes: UnsafeBufferPointer<UInt8>) {
+        self = bytes.withMemoryRebound(to: CChar.self) { chars in
+            slint_shared_string_from_utf8(chars.baseAddress, chars.count)
+        }
+    }
+
+    /// The one Slint string with these contents. Made the first time, then shared, so writing the same label again
+    /// retains it, rather than allocating. Interned strings live as long as the interner keeps them.
+    public static func interned<S: StringProtocol>(_ string: S) -> SharedString {
+        SharedStringInterner.shared.intern(string)
+    }
+
+    /// Number of UTF-8 bytes. Counted to the terminator, so it's O(n).
+    public var utf8Count: Int {
+        withUnsafePointer(to: self) { slint_shared_string_len($0) }
+    }
+
+    /// Borrow the UTF-8 bytes, without copying them.
+    /// - Parameter body: Closure that reads the bytes. The buffer must not escape it.
+    public func withUTF8<R>(_ body: (UnsafeBufferPointer<UInt8>) throws -> R) rethrows -> R {
+        try withUnsafePointer(to: self) { pointer in
+            let bytes = UnsafeRawPointer(slint_shared_string_bytes(pointer)!).assumingMemoryBound(to: UInt8.self)
+            return try body(UnsafeBufferPointer(start: bytes, count: slint_shared_string_len(pointer)))
+        }
+    }
+
+    /// The UTF-8 bytes, as a collection. Holds its own reference to the string, so nothing is copied or allocated.
+    public var utf8: UTF8View {
+        UTF8View(self)
+    }
+
+    /// Copy into a Swift string. Strings of up to 15 bytes fit inside `String` itself, so those don't allocate either.
+    public var string: String {
+        withUTF8 { String(decoding: $0, as: UTF8.self) }
+    }
+
+    /// A string's UTF-8 bytes, borrowed. Like a `Substring`, it keeps the string alive, rather than copying out of it.
+    public struct UTF8View: RandomAccessCollection {
+        /// Keeps `bytes` alive. Slint strings aren't changed in place while they're shared, and this is a reference.
+        private let owner: SharedString
+        private let bytes: UnsafeBufferPointer<UInt8>
+
+        init(_ owner: SharedString) {
+            self.owner = owner
+            bytes = withUnsafePointer(to: owner) { pointer in
+                UnsafeBufferPointer(
+                    start: UnsafeRawPointer(slint_shared_string_bytes(pointer)!).assumingMemoryBound(to: UInt8.self),
+                    count: slint_shared_string_len(pointer)
+                )
+            }
+        }
+
+        public var startIndex: Int { 0 }
+        public var endIndex: Int { bytes.count }
+
+        public subscript(position: Int) -> UInt8 {
+            bytes[position]
+        }
+
+        public func withContiguousStorageIfAvailable<R>(_ body: (UnsafeBufferPointer<UInt8>) throws -> R) rethrows -> R? {
+            try withExtendedLifetime(owner) { try body(bytes) }
+        }
+    }
+}
+
+extension SharedString: Equatable, Hashable {
+    /// Same bytes. Compares lengths first, so most different strings are told apart without reading them.
+    public static func == (lhs: SharedString, rhs: SharedString) -> Bool {
+        withUnsafePointer(to: lhs) { lhs in
+            withUnsafePointer(to: rhs) { rhs in slint_shared_string_eq(lhs, rhs) }
+        }
+    }
+
+    public func hash(into hasher: inout Hasher) {
+        withUTF8 { hasher.combine(bytes: UnsafeRawBufferPointer($0)) }
+    }
+}
+
+extension SharedString: ExpressibleByStringLiteral, CustomStringConvertible {
+    /// Literals are interned. There's only so many of them.
+    public init(stringLiteral value: String) {
+        self = Self.interned(value)
+    }
+
+    public var description: String { string }
+}
+
+/// Slint strings, by contents. Bounded: once it's full, it starts over, and strings it dropped live on in whoever holds them.
+final class SharedStringInterner {
+    static let shared = SharedStringInterner()
+
+    /// Distinct strings kept. Enough for every label in a UI, not every value a feed ever sends.
+    static let capacity = 4_096
+
+    private let lock = NSLock()
+    private var strings: [String: SharedString] = [:]
+
+    func intern<S: StringProtocol>(_ string: S) -> SharedString {
+        // Looking up a `String` doesn't copy it. A `Substring` has to become one.
+        let key = String(string)
+        lock.lock()
+        defer { lock.unlock() }
+        if let shared = strings[key] { return shared }
+        if strings.count >= Self.capacity { strings.removeAll(keepingCapacity: true) }
+        let shared = SharedString(key)
+        strings[key] = shared
+        return shared
+    }
+}
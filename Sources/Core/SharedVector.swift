@@ -0,0 +1,297 @@
+//
+// SharedVector.swift
+// slint
+//
+// Created by Matthew Taylor on 2/6/24.
+//
+
+// For `memcpy`.
+import Foundation
+
+import Atomics
+import SlintFFI
+
+/// Slint's reference counted array, laid out like the C++ `slint::SharedVector<T>`: a pointer to a header, with the elements right after it.
+///
+/// A value type, copy-on-write, like `Array`. Copies share the buffer, and a write only copies it if something else holds it,
+/// whether that's another Swift copy, or Slint. The buffer grows geometrically, so appending is amortized O(1).
+///
+/// Unlike the prototype, the header's reference count is Slint's own, updated atomically, so a buffer can be handed to Slint,
+/// and back, without copying.
+///
+/// Elements must be trivial, like `Float`, or a C struct: no references, no strings, nothing that needs destroying.
+/// Slint can drop the last reference, and it frees the buffer without running any Swift code. Making a vector of
+/// anything else traps.
+public struct SharedVector<T> {
+    /// Owns one reference to the header. Swift copies share it, so they only cost a retain of the box.
+    @usableFromInline
+    final class Storage {
+        @usableFromInline var header: UnsafeMutablePointer<SharedVectorHeader>
+
+        init(_ header: UnsafeMutablePointer<SharedVectorHeader>) {
+            // Every vector makes one of these, so this covers every initializer.
+            precondition(_isPOD(T.self), "SharedVector only supports trivial elements, Slint frees buffers without destroying them")
+            self.header = header
+        }
+
+        deinit {
+            SharedVector.release(header)
+        }
+    }
+
+    @usableFromInline var storage: Storage
+
+    /// An empty vector. Shares Slint's static empty header, so it doesn't allocate.
+    public init() {
+        storage = Storage(Self.emptyHeader)
+    }
+
+    /// An empty vector, with room for at least `minimumCapacity` elements.
+    public init(minimumCapacity: Int) {
+        storage = Storage(minimumCapacity > 0 ? Self.allocate(capacity: minimumCapacity) : Self.emptyHeader)
+    }
+
+    /// A vector of the elements of `elements`, in order.
+    public init<S: Sequence>(_ elements: S) where S.Element == T {
+        self.init()
+        append(contentsOf: elements)
+    }
+
+    /// Take over a reference to a header, e.g. one Slint gave out.
+    init(adopting header: UnsafeMutablePointer<SharedVectorHeader>) {
+        storage = Storage(header)
+    }
+
+    /// Give out a reference to the header, e.g. for a C++ `SharedVector<T>`, which is just the pointer.
+    /// Whoever takes it is responsible for releasing it.
+    func retainedHeader() -> UnsafeMutablePointer<SharedVectorHeader> {
+        Self.retain(storage.header)
+        return storage.header
+    }
+
+    // MARK: Size
+
+    @inlinable
+    public var count: Int { storage.header.pointee.size }
+
+    /// Elements the buffer has room for, before it has to grow.
+    @inlinable
+    public var capacity: Int { storage.header.pointee.capacity }
+
+    /// Make sure there's room for at least `minimumCapacity` elements, and that the buffer isn't shared.
+    public mutating func reserveCapacity(_ minimumCapacity: Int) {
+        if capacity < minimumCapacity || count > 0 && !isUnique {
+            reallocate(capacity: Swift.max(minimumCapacity, count))
+        }
+    }
+
+    /// Remove every element. The buffer's kept if it's not shared, and `keepCapacity` is true.
+    public mutating func removeAll(keepingCapacity keepCapacity: Bool = false) {
+        if keepCapacity && isUnique {
+            // Trivial elements, so there's nothing to destroy.
+            storage.header.pointee.size = 0
+        } else {
+            self = keepCapacity ? Self(minimumCapacity: capacity) : Self()
+        }
+    }
+
+    // MARK: Appending
+
+    /// Append an element. Amortized O(1).
+    public mutating func append(_ element: T) {
+        let count = count
+        makeUniqueAndReserve(count + 1)
+        (elements + count).initialize(to: element)
+        storage.header.pointee.size = count + 1
+    }
+
+    /// Append a sequence's elements. The buffer grows at most once, for collections,
+    /// and contiguous elements, like a `[Float]`, are copied with one `memcpy`.
+    public mutating func append<S: Sequence>(contentsOf newElements: S) where S.Element == T {
+        let count = count
+        let copied: Int? = newElements.withContiguousStorageIfAvailable { source in
+            guard let base = source.baseAddress, !source.isEmpty else { return 0 }
+            makeUniqueAndReserve(count + source.count)
+            memcpy(elements + count, base, source.count * MemoryLayout<T>.stride)
+            return source.count
+        }
+        if let copied {
+            if copied > 0 { storage.header.pointee.size = count + copied }
+            return
+        }
+
+        // Not contiguous. Reserve what it promises, then take elements one at a time.
+        makeUniqueAndReserve(count + newElements.underestimatedCount)
+        var iterator = newElements.makeIterator()
+        var size = count
+        while let element = iterator.next() {
+            if size == capacity {
+                storage.header.pointee.size = size
+                makeUniqueAndReserve(size + 1)
+            }
+            (elements + size).initialize(to: element)
+            size += 1
+        }
+        storage.header.pointee.size = size
+    }
+
+    // MARK: Contiguous access
+
+    /// Borrow the elements, without copying them.
+    @inlinable
+    public func withUnsafeBufferPointer<R>(_ body: (UnsafeBufferPointer<T>) throws -> R) rethrows -> R {
+        try withExtendedLifetime(storage) {
+            try body(UnsafeBufferPointer(start: elements, count: count))
+        }
+    }
+
+    /// Borrow the elements, to change them in place. Copies the buffer first, if it's shared.
+    public mutating func withUnsafeMutableBufferPointer<R>(_ body: (inout UnsafeMutableBufferPointer<T>) throws -> R) rethrows -> R {
+        makeUniqueAndReserve(count)
+        let base = elements
+        var buffer = UnsafeMutableBufferPointer(start: base, count: count)
+        defer {
+            precondition(buffer.baseAddress == base && buffer.count == count, "SharedVector.withUnsafeMutableBufferPointer: replacing the buffer is not allowed")
+        }
+        return try withExtendedLifetime(storage) { try body(&buffer) }
+    }
+
+    // MARK: Reference counting
+
+    /// Slint's static empty header. Its reference count is negative, so it's never retained, released, or written.
+    @usableFromInline
+    static var emptyHeader: UnsafeMutablePointer<SharedVectorHeader> {
+        UnsafeMutableRawPointer(mutating: slint_shared_vector_empty()!).assumingMemoryBound(to: SharedVectorHeader.self)
+    }
+
+    /// The header's reference count, which Slint updates atomically too. It's the header's first field.
+    private static func referenceCount(of header: UnsafeMutablePointer<SharedVectorHeader>) -> UnsafeAtomic<Int> {
+        UnsafeAtomic(at: UnsafeMutableRawPointer(header).assumingMemoryBound(to: Int.AtomicRepresentation.self))
+    }
+
+    static func retain(_ header: UnsafeMutablePointer<SharedVectorHeader>) {
+        let refcount = referenceCount(of: header)
+        guard refcount.load(ordering: .relaxed) >= 0 else { return }
+        refcount.wrappingIncrement(ordering: .relaxed)
+    }
+
+    static func release(_ header: UnsafeMutablePointer<SharedVectorHeader>) {
+        let refcount = referenceCount(of: header)
+        guard refcount.load(ordering: .relaxed) >= 0 else { return }
+        guard refcount.loadThenWrappingDecrement(ordering: .acquiringAndReleasing) == 1 else { return }
+        // Trivial elements, so freeing the buffer is all Slint does too.
+        deallocate(header)
+    }
+
+    /// True if nothing else holds the buffer: no other Swift copy, and no reference from Slint.
+    /// The static empty header is never unique, so it's never written.
+    @usableFromInline
+    var isUnique: Bool {
+        mutating get {
+            isKnownUniquelyReferenced(&storage) && Self.referenceCount(of: storage.header).load(ordering: .acquiring) == 1
+        }
+    }
+
+    // MARK: Buffers
+
+    @usableFromInline
+    var elements: UnsafeMutablePointer<T> { Self.elements(of: storage.header) }
+
+    @usableFromInline
+    static func elements(of header: UnsafeMutablePointer<SharedVectorHeader>) -> UnsafeMutablePointer<T> {
+        UnsafeMutableRawPointer(header + 1).assumingMemoryBound(to: T.self)
+    }
+
+    /// Size and alignment of a buffer, the same as the C++ bindings ask for.
+    private static func layout(capacity: Int) -> (size: UInt, alignment: UInt) {
+        // The elements follow the header without padding, so they can't need more alignment than it.
+        precondition(MemoryLayout<T>.alignment <= MemoryLayout<SharedVectorHeader>.alignment, "SharedVector doesn't support over-aligned elements")
+        return (
+            UInt(MemoryLayout<SharedVectorHeader>.stride + capacity * MemoryLayout<T>.stride),
+            UInt(MemoryLayout<SharedVectorHeader>.alignment)
+        )
+    }
+
+    private static func allocate(capacity: Int) -> UnsafeMutablePointer<SharedVectorHeader> {
+        let (size, alignment) = layout(capacity: capacity)
+        let header = UnsafeMutableRawPointer(slint_shared_vector_allocate(size, alignment)!).bindMemory(to: SharedVectorHeader.self, capacity: 1)
+        // Slint doesn't fill in the header. The C++ bindings don't rely on it either.
+        header.initialize(to: SharedVectorHeader(refcount: 1, size: 0, capacity: capacity))
+        return header
+    }
+
+    private static func deallocate(_ header: UnsafeMutablePointer<SharedVectorHeader>) {
+        let (size, alignment) = layout(capacity: header.pointee.capacity)
+        slint_shared_vector_free(UnsafeMutableRawPointer(header).assumingMemoryBound(to: UInt8.self), size, alignment)
+    }
+
+    /// Make the buffer unique, with room for `minimumCapacity` elements, growing it geometrically if it has to.
+    @usableFromInline
+    mutating func makeUniqueAndReserve(_ minimumCapacity: Int) {
+        // Nothing to write, so nothing to copy. Keeps empty vectors on the static header.
+        if minimumCapacity == 0 && count == 0 { return }
+        if capacity >= minimumCapacity && isUnique { return }
+        reallocate(capacity: minimumCapacity > capacity ? Swift.max(minimumCapacity, capacity * 2, 4) : capacity)
+    }
+
+    /// Move, or copy if it's shared, into a new buffer of exactly `capacity`.
+    private mutating func reallocate(capacity: Int) {
+        let count = count
+        let header = Self.allocate(capacity: capacity)
+        if isUnique {
+            // Nothing else can see the old buffer, so the elements move, and the old buffer is freed without them.
+            Self.elements(of: header).moveInitialize(from: elements, count: count)
+            storage.header.pointee.size = 0
+        } else {
+            Self.elements(of: header).initialize(from: elements, count: count)
+        }
+        header.pointee.size = count
+        storage = Storage(header)
+    }
+}
+
+// MARK: - Collection
+
+extension SharedVector: RandomAccessCollection, MutableCollection {
+    @inlinable public var startIndex: Int { 0 }
+    @inlinable public var endIndex: Int { count }
+
+    @inlinable
+    public subscript(position: Int) -> T {
+        get {
+            precondition(position >= 0 && position < count, "SharedVector index out of range")
+            return withExtendedLifetime(storage) { elements[position] }
+        }
+        set {
+            precondition(position >= 0 && position < count, "SharedVector index out of range")
+            makeUniqueAndReserve(count)
+            elements[position] = newValue
+        }
+    }
+
+    @inlinable
+    public func withContiguousStorageIfAvailable<R>(_ body: (UnsafeBufferPointer<T>) throws -> R) rethrows -> R? {
+        try withUnsafeBufferPointer(body)
+    }
+
+    @inlinable
+    public mutating func withContiguousMutableStorageIfAvailable<R>(_ body: (inout UnsafeMutableBufferPointer<T>) throws -> R) rethrows -> R? {
+        try withUnsafeMutableBufferPointer(body)
+    }
+}
+
+extension SharedVector: ExpressibleByArrayLiteral {
+    public init(arrayLiteral elements: T...) {
+        self.init(elements)
+    }
+}
+
+extension SharedVector: Equatable where T: Equatable {
+    public static func == (lhs: SharedVector, rhs: SharedVector) -> Bool {
+        lhs.storage.header == rhs.storage.header || lhs.elementsEqual(rhs)
+    }
+}
+
+extension SharedVector: CustomStringConvertible {
+    public var description: String { Array(self).description }
+}
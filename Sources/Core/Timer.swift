@@ -5,34 +5,34 @@
 //  Created by Matthew Taylor on 2/8/24.
 //
 
-import SlintFFI
-
 /// Timer that can invoke a callback, once or periodically.
-/// 
-/// Note: This will leak if you call `willRun(_:_:)`, but never call 
+///
+/// Timers are multiplexed onto a single native Slint timer by `SlintTimerService`.
+/// Set `leeway` to let a timer share wakeups with others that are due around the same time.
+///
+/// Note: This will leak if you call `willRun(_:_:)`, but never call `drop()`.
+/// The timer keeps itself alive while it can still be restarted.
 @SlintActor
 public class SlintTimer {
-    /// Timer ID. Used a handle for the Slint FFI. 
-    private var id: UInt?
+    /// Handle for the timer service. Kept across starts, so restarting doesn't make a new timer.
+    private var handle: SlintTimerService.Handle?
 
-    /// Initializer. Nonisolated because it doesn't do anything, so it doesn't need to be isolated.
-    nonisolated public init() { }
+    /// Milliseconds the timer may fire late, so it can share a wakeup with other timers.
+    /// Takes effect the next time `willRun(_:_:)` is called.
+    public var leeway: UInt64
 
-    /// Deinitializer
-    deinit {
-        // If the timer exists, destroy it.
-        // This crashes if the timer is destroyed immediately after being created, I suspect.
-        if let id {
-            slint_timer_destroy(id)
-        }
+    /// Initializer. Nonisolated because it doesn't do anything, so it doesn't need to be isolated.
+    /// - Parameter leeway: Milliseconds the timer may fire late.
+    nonisolated public init(leeway: UInt64 = 0) {
+        self.leeway = leeway
     }
-    
+
     /// Sets up a single-shot timer to run after a set number of milliseconds.
     /// - Parameters:
     ///   - duration: Milliseconds until the closure should be called.
     ///   - closure: The closure to call.
     public func willRun(after duration: UInt64, _ closure: @SlintActor @escaping @Sendable () -> Void) {
-        start(mode: TimerMode.SingleShot, duration: duration, closure: closure)
+        start(repeating: false, duration: duration, closure: closure)
     }
 
     /// Sets up a repeating timer to run periodically after a set number of milliseconds.
@@ -40,59 +40,48 @@ public class SlintTimer {
     ///   - duration: Milliseconds until the closure should be called.
     ///   - closure: The closure to call.
     public func willRun(every duration: UInt64, _ closure: @SlintActor @escaping @Sendable () -> Void) {
-        start(mode: TimerMode.Repeated, duration: duration, closure: closure)
+        start(repeating: true, duration: duration, closure: closure)
     }
 
     /// Stop the current timer, if running. Otherwise does nothing.
-    /// 
-    /// Note: I also have found that stopping a timer from another timer's closure doesn't work.
+    /// Works from anywhere, including from another timer's closure, and from this timer's own closure.
     public func stop() {
-        if let id {
-            // Actually, it seems to be doing nothing, regardless.
-            print("Note: stopped timer \(id)")
-            slint_timer_stop(id)
-            print("Note: \(id) running? \(running)")
-        }
+        if let handle { SlintTimerService.shared.stop(handle) }
     }
 
-    /// Drop the current timer, if it exists.
+    /// Drop the current timer, if it exists. This releases the closure, and the timer's hold on itself.
     public func drop() {
-        if let id {
-            slint_timer_destroy(id)
-            self.id = nil
+        if let handle {
+            SlintTimerService.shared.cancel(handle)
+            self.handle = nil
         }
     }
 
-    /// Restart the current timer, if stopped. Otherwise does nothing.
+    /// Restart the current timer from now, whether it's running or stopped. Does nothing if it was dropped, or never started.
     public func restart() {
-        if let id { slint_timer_restart(id) }
+        if let handle { SlintTimerService.shared.restart(handle) }
     }
 
     /// True if the timer is currently running. False otherwise.
+    /// A single-shot timer stops running once it has fired.
     public var running: Bool {
-        if let id {
-            return slint_timer_running(id)
+        if let handle {
+            return SlintTimerService.shared.isRunning(handle)
         } else {
             return false
         }
     }
 
     /// Internal function, starts timer from the Slint event loop context.
-    private func start(mode: TimerMode, duration: UInt64, closure: @SlintActor @escaping @Sendable () -> Void) {
-        // Create a wraper, specifically retaining this object until the timer is dropped by Slint.
-        let wrapper = WrappedClosure {
+    private func start(repeating: Bool, duration: UInt64, closure: @SlintActor @escaping @Sendable () -> Void) {
+        handle = SlintTimerService.shared.start(
+            handle,                         // Reuse the existing timer, if there is one.
+            interval: duration,             // Period, in milliseconds.
+            repeating: repeating,           // Either oneshot or repeating.
+            leeway: leeway
+        ) {
+            // Retain this object until the timer is dropped.
             withExtendedLifetime(self) { closure() }
         }
-
-        id = slint_timer_start(
-            id ?? 0,                        // Assign a new ID if we don't already have one. Docs erroneously say `-1` is the correct value. 
-            mode,                           // Mode, either oneshot or repeating.
-            duration,                       // Period, in milliseconds.
-            WrappedClosure.invokeCallback,  // Callback to invoke the closure.
-            wrapper.getRetainedPointer(),   // Pointer to the wrapper.
-            WrappedClosure.dropCallback     // Callback to release the wrapper.
-        )
-
-        print("Created timer \(id ?? UInt.max)")
     }
 }
@@ -0,0 +1,270 @@
+//
+//  TimerService.swift
+//  slint
+//
+
+import SlintFFI
+
+/// Counters for `SlintTimerService`.
+public struct TimerServiceStatistics {
+    /// Number of times the native Slint timer fired.
+    public internal(set) var wakeups = 0
+
+    /// Number of Swift timers fired.
+    public internal(set) var timersFired = 0
+
+    /// Average number of timers fired per wakeup. Higher means more coalescing.
+    public var timersPerWakeup: Double {
+        guard wakeups > 0 else { return 0 }
+        return Double(timersFired) / Double(wakeups)
+    }
+}
+
+/// Runs any number of Swift timers off a single native Slint timer.
+///
+/// Timers live in a `TimingWheel`, with millisecond ticks. The native timer is always armed
+/// for the earliest deadline, and fires every timer due by then in one go.
+///
+/// Timers can have a leeway: how many milliseconds late they're allowed to fire.
+/// Their deadlines are rounded up to a grid of the largest power of two no bigger than the leeway,
+/// so timers with overlapping windows land on the same tick, and share a wakeup.
+/// Periodic timers are scheduled from their previous deadline, not from when they fired, so leeway doesn't add up.
+///
+/// Starting and cancelling timers doesn't allocate, once the service has grown to the number of live timers.
+@SlintActor
+public final class SlintTimerService {
+    /// Shared instance. Every `SlintTimer` uses it.
+    public static let shared = SlintTimerService()
+
+    /// Handle to a timer. Handles to cancelled timers go stale, and are ignored.
+    public struct Handle: Hashable, Sendable {
+        fileprivate let index: Int
+        fileprivate let generation: UInt32
+    }
+
+    /// Counters.
+    public private(set) var statistics = TimerServiceStatistics()
+
+    /// Number of timers currently scheduled.
+    public var scheduledCount: Int { wheel.count }
+
+    /// State for one timer. Kept after a timer stops, so it can be restarted.
+    private struct Record {
+        /// Bumped every time the record is freed, so old handles stop matching.
+        var generation: UInt32 = 0
+        /// `nil` if the record is free.
+        var closure: (@SlintActor () -> Void)?
+        /// Milliseconds between starting and firing, or between firings.
+        var interval: UInt64 = 0
+        var leeway: UInt64 = 0
+        var repeating = false
+        /// True from being started until it's stopped, or fires for the last time.
+        var running = false
+        /// Deadline before coalescing. Repeats are computed from this, so they don't drift.
+        var deadline: UInt64 = 0
+    }
+
+    private var records: [Record] = []
+    private var freeIndices: [Int] = []
+
+    /// Milliseconds on a monotonic clock. Tests stop it, and move it by hand.
+    private let clock: @Sendable () -> UInt64
+
+    private var wheel: TimingWheel
+
+    /// Reused by `fire()`, so firing doesn't allocate.
+    private var expired: [Int] = []
+
+    /// The native timer. 0 until it's first armed.
+    private var nativeTimer: UInt = 0
+
+    /// Tick the native timer is armed for, or `nil` if it isn't.
+    private var armedDeadline: UInt64?
+
+    /// True while `fire()` is running timers. Arming waits until they've all run.
+    private var firing = false
+
+    /// Invoked by the native timer. One instance for the lifetime of the service, retained again every time it's armed.
+    private let nativeCallback = WrappedClosure { SlintTimerService.shared.fire() }
+
+    /// Initializer. Nonisolated because it doesn't do anything, so it doesn't need to be isolated.
+    /// - Parameter clock: Current time, in milliseconds. Only tests pass anything else.
+    nonisolated init(clock: @escaping @Sendable () -> UInt64 = { monotonicMilliseconds() }) {
+        self.clock = clock
+        wheel = TimingWheel(startingAt: clock())
+    }
+
+    /// Schedule a closure to run once.
+    /// - Parameters:
+    ///   - delay: Milliseconds until the closure should be called.
+    ///   - leeway: Milliseconds the closure may be called late, to share a wakeup with other timers.
+    ///   - closure: The closure to call. Kept until the timer is cancelled, so it can be restarted.
+    /// - Returns: A handle to the timer.
+    @discardableResult
+    public func schedule(after delay: UInt64, leeway: UInt64 = 0, _ closure: @escaping @SlintActor () -> Void) -> Handle {
+        start(nil, interval: delay, repeating: false, leeway: leeway, closure)
+    }
+
+    /// Schedule a closure to run periodically.
+    /// - Parameters:
+    ///   - interval: Milliseconds between calls.
+    ///   - leeway: Milliseconds each call may be late, to share a wakeup with other timers.
+    ///   - closure: The closure to call.
+    /// - Returns: A handle to the timer.
+    @discardableResult
+    public func schedule(every interval: UInt64, leeway: UInt64 = 0, _ closure: @escaping @SlintActor () -> Void) -> Handle {
+        start(nil, interval: interval, repeating: true, leeway: leeway, closure)
+    }
+
+    /// Stop a timer. It keeps its closure, and can be restarted.
+    public func stop(_ handle: Handle) {
+        guard let index = validIndex(handle) else { return }
+        records[index].running = false
+        wheel.cancel(index)
+        disarmIfIdle()
+    }
+
+    /// Restart a timer from now, with its original interval.
+    public func restart(_ handle: Handle) {
+        guard let index = validIndex(handle) else { return }
+        schedule(index, from: clock())
+    }
+
+    /// True if a timer is running.
+    public func isRunning(_ handle: Handle) -> Bool {
+        guard let index = validIndex(handle) else { return false }
+        return records[index].running
+    }
+
+    /// Stop a timer, and release its closure. The handle goes stale.
+    public func cancel(_ handle: Handle) {
+        guard let index = validIndex(handle) else { return }
+        wheel.cancel(index)
+        records[index] = Record(generation: records[index].generation &+ 1)
+        freeIndices.append(index)
+        disarmIfIdle()
+    }
+
+    /// Start a timer. Internal, so `SlintTimer` can keep its handle across starts.
+    /// - Parameter handle: Handle to reuse. If it's `nil` or stale, a new timer is made.
+    func start(
+        _ handle: Handle?,
+        interval: UInt64,
+        repeating: Bool,
+        leeway: UInt64,
+        _ closure: @escaping @SlintActor () -> Void
+    ) -> Handle {
+        let index: Int
+        if let handle, let valid = validIndex(handle) {
+            index = valid
+        } else if let free = freeIndices.popLast() {
+            index = free
+        } else {
+            index = records.count
+            records.append(Record())
+        }
+
+        records[index].closure = closure
+        records[index].interval = interval
+        records[index].repeating = repeating
+        records[index].leeway = leeway
+        schedule(index, from: clock())
+
+        return Handle(index: index, generation: records[index].generation)
+    }
+
+    /// Index of a handle's record, or `nil` if the handle is stale.
+    private func validIndex(_ handle: Handle) -> Int? {
+        guard handle.index < records.count,
+              records[handle.index].generation == handle.generation,
+              records[handle.index].closure != nil
+        else { return nil }
+        return handle.index
+    }
+
+    /// Put a timer in the wheel, one interval after `tick`.
+    private func schedule(_ index: Int, from tick: UInt64) {
+        records[index].running = true
+        records[index].deadline = tick + records[index].interval
+
+        let deadline = Self.coalesce(records[index].deadline, leeway: records[index].leeway)
+        wheel.schedule(index, at: deadline)
+
+        // Only ever re-arm earlier. Finding the true next deadline costs more, and `fire()` does it anyway.
+        if let armedDeadline, armedDeadline <= deadline { return }
+        arm(for: deadline)
+    }
+
+    /// Round a deadline up to a grid of the largest power of two that fits in the leeway.
+    private static func coalesce(_ deadline: UInt64, leeway: UInt64) -> UInt64 {
+        guard leeway > 1 else { return deadline }
+        let grid: UInt64 = 1 << UInt64(63 - leeway.leadingZeroBitCount)
+        let (rounded, overflow) = deadline.addingReportingOverflow(grid - 1)
+        return overflow ? deadline : rounded & ~(grid - 1)
+    }
+
+    /// Arm the native timer to fire at a tick.
+    private func arm(for deadline: UInt64) {
+        guard !firing else { return }
+
+        // The clock rounds down, so the real time is already at or past `now`. Waiting the difference can't fire early.
+        // Capped at about 34 years, like `WakeupScheduler`.
+        let now = clock()
+        let delay = deadline > now ? min(deadline - now, 1 << 40) : 0
+
+        nativeTimer = slint_timer_start(
+            nativeTimer,                            // 0 the first time, for a new timer.
+            TimerMode.SingleShot,                   // Re-armed for the next deadline after every wakeup.
+            delay,
+            WrappedClosure.invokeCallback,
+            nativeCallback.getRetainedPointer(),
+            WrappedClosure.dropCallback
+        )
+        armedDeadline = deadline
+
+        // The native timer may be due sooner than anything else Slint was waiting on.
+        WakeupScheduler.shared.rearm()
+    }
+
+    /// Stop the native timer if nothing is left to wait for.
+    /// Otherwise it's left alone: waking early is cheap, and the next wakeup re-arms for the right deadline.
+    private func disarmIfIdle() {
+        guard wheel.count == 0, armedDeadline != nil, !firing else { return }
+        slint_timer_stop(nativeTimer)
+        armedDeadline = nil
+    }
+
+    /// The native timer fired. Run every timer that's due, then re-arm. Tests call it directly.
+    func fire() {
+        statistics.wakeups += 1
+        armedDeadline = nil
+
+        let now = clock()
+        wheel.advance(to: now, into: &expired)
+
+        firing = true
+        for index in expired {
+            // An earlier closure in this batch may have stopped, restarted or cancelled this timer.
+            guard records[index].running, !wheel.isScheduled(index), let closure = records[index].closure else { continue }
+
+            if records[index].repeating {
+                // Skip any periods that were missed entirely, rather than firing a burst to catch up.
+                let interval = max(records[index].interval, 1)
+                let previous = records[index].deadline
+                let missed = now >= previous + interval ? (now - previous) / interval : 0
+                schedule(index, from: previous + missed * interval)
+            } else {
+                records[index].running = false
+            }
+
+            statistics.timersFired += 1
+            traced(.timer) { closure() }
+        }
+        firing = false
+        expired.removeAll(keepingCapacity: true)
+
+        if let next = wheel.nextDeadline() {
+            arm(for: next)
+        }
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  Compiler.swift
+//  slint
+//
+//  Created by Matthew Taylor on 2/17/24.
+//
+
+import SlintFFI
+
+/// A compiler interprets Slint code and creates component definitions, which can be used to instantiate components.
+///
+/// Every build compiles from scratch. To reuse definitions, use `ComponentDefinitionCache`.
+/// Not isolated, so it can compile off the event loop, but use each compiler from one thread at a time.
+public final class SlintCompiler {
+    /// The wrapped compiler. Heap allocated, because Slint constructs it in place.
+    private let handle: UnsafeMutablePointer<ComponentCompilerOpaque>
+
+    /// Enum to describe error conditions.
+    public enum CompilerError: Error, CustomStringConvertible {
+        /// Compiling failed. Has the errors, and any warnings.
+        case compileFailed([SlintDiagnostic])
+
+        public var description: String {
+            switch self {
+            case .compileFailed(let diagnostics):
+                return (["Compiling Slint code failed:"] + diagnostics.map(\.description)).joined(separator: "\n")
+            }
+        }
+    }
+
+    /// Initializer. Constructs a default compiler instance.
+    public init() {
+        handle = .allocate(capacity: 1)
+        slint_interpreter_component_compiler_new(handle)
+    }
+
+    /// Deinitializer. Destructs the wrapped compiler instance.
+    deinit {
+        slint_interpreter_component_compiler_destructor(handle)
+        handle.deallocate()
+    }
+
+    /// Widget style, e.g. `"fluent"`. Empty for the default.
+    public var style: String {
+        get {
+            var style = SharedString()
+            slint_interpreter_component_compiler_get_style(handle, &style)
+            return style.string
+        }
+        set {
+            newValue.withStrSlice { slint_interpreter_component_compiler_set_style(handle, $0) }
+        }
+    }
+
+    /// Directories searched for imports.
+    public var includePaths: [String] {
+        get {
+            var paths = SharedStringVector()
+            slint_interpreter_component_compiler_get_include_paths(handle, &paths)
+            return paths.strings
+        }
+        set {
+            var paths = SharedStringVector(newValue)
+            slint_interpreter_component_compiler_set_include_paths(handle, &paths)
+        }
+    }
+
+    /// Errors and warnings from the last build.
+    public var diagnostics: [SlintDiagnostic] {
+        var diagnostics = DiagnosticVector()
+        slint_interpreter_component_compiler_get_diagnostics(handle, &diagnostics)
+        return diagnostics.diagnostics
+    }
+
+    /// Compile source code into a component definition.
+    /// - Parameters:
+    ///   - source: The Slint code.
+    ///   - path: Where the code came from. Relative imports are resolved against it, and diagnostics name it.
+    /// - Throws: `CompilerError.compileFailed`, with the diagnostics.
+    public func build(fromSource source: String, path: String = "") throws -> ComponentDefinition {
+        try build { definition in
+            path.withStrSlice { pathSlice in
+                source.withStrSlice { sourceSlice in
+                    slint_interpreter_component_compiler_build_from_source(handle, sourceSlice, pathSlice, definition)
+                }
+            }
+        }
+    }
+
+    /// Compile a `.slint` file into a component definition.
+    /// - Throws: `CompilerError.compileFailed`, with the diagnostics.
+    public func build(fromPath path: String) throws -> ComponentDefinition {
+        try build { definition in
+            path.withStrSlice { slint_interpreter_component_compiler_build_from_path(handle, $0, definition) }
+        }
+    }
+
+    /// Run a build into a new definition. Slint only constructs it if the build succeeds.
+    private func build(_ body: (UnsafeMutablePointer<ComponentDefinitionOpaque>) -> Bool) throws -> ComponentDefinition {
+        let definition = UnsafeMutablePointer<ComponentDefinitionOpaque>.allocate(capacity: 1)
+        guard body(definition) else {
+            definition.deallocate()
+            throw CompilerError.compileFailed(diagnostics)
+        }
+        return ComponentDefinition(owning: definition)
+    }
+}
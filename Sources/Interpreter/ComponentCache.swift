@@ -0,0 +1,222 @@
+//
+//  ComponentCache.swift
+//  slint
+//
+
+// For file modification dates, and finding imports.
+import Foundation
+
+import SlintFFI
+
+/// How well a `ComponentDefinitionCache` is doing.
+public struct ComponentCacheStatistics {
+    public var hits = 0
+    public var misses = 0
+    /// Misses because a file the entry depends on changed.
+    public var invalidations = 0
+    /// Time spent compiling, on misses.
+    public var compileNanoseconds: UInt64 = 0
+    /// Time hits didn't spend compiling. Each hit counts as long as its entry took to compile.
+    public var savedNanoseconds: UInt64 = 0
+
+    /// Fraction of lookups that were hits, from 0 to 1.
+    public var hitRate: Double {
+        hits + misses == 0 ? 0 : Double(hits) / Double(hits + misses)
+    }
+}
+
+/// Compiles each distinct piece of Slint code once, and hands out copies of the definition.
+///
+/// Entries are keyed by a hash of the source (or the path, for files), the style, and the include paths.
+/// Entries built from a string keep the string, and a hit only counts if it's the same, so a hash collision just compiles again.
+/// Copies share the compiled definition, so they're cheap: Slint only bumps a reference count.
+///
+/// Each entry remembers the modification dates of its file and everything it imports.
+/// If any of them change, the next lookup compiles it again. Imports are found by scanning for
+/// `import ... from "..."`, so imports Slint resolves itself, like `std-widgets.slint`, aren't tracked.
+@SlintActor
+public final class ComponentDefinitionCache {
+    /// Shared cache.
+    public static let shared = ComponentDefinitionCache()
+
+    /// What a definition depends on.
+    struct Key: Hashable {
+        enum Origin: Hashable {
+            /// Built from a string. `path` is where relative imports resolve from.
+            case source(digest: UInt64, length: Int, path: String)
+            /// Built from a file.
+            case file(String)
+        }
+
+        let origin: Origin
+        let style: String
+        let includePaths: [String]
+    }
+
+    /// A file an entry depends on, and when it was last modified.
+    struct Dependency {
+        let path: String
+        let modified: Date?
+
+        init(_ path: String) {
+            self.path = path
+            modified = try? FileManager.default.attributesOfItem(atPath: path)[.modificationDate] as? Date
+        }
+
+        var isCurrent: Bool { Dependency(path).modified == modified }
+    }
+
+    final class Entry {
+        let definition: ComponentDefinition
+        let compileNanoseconds: UInt64
+        let dependencies: [Dependency]
+        /// The code it was built from, for entries built from a string. The key only has its digest.
+        let source: String?
+
+        init(_ definition: ComponentDefinition, _ compileNanoseconds: UInt64, _ dependencies: [Dependency], source: String?) {
+            self.definition = definition
+            self.compileNanoseconds = compileNanoseconds
+            self.dependencies = dependencies
+            self.source = source
+        }
+    }
+
+    /// Compilers by style and include paths. Setting those isn't free, so one compiler per combination.
+    private var compilers: [[String]: SlintCompiler] = [:]
+    private var entries: [Key: Entry] = [:]
+
+    /// Hits, misses, and time saved, since the cache was made or `resetStatistics()` was last called.
+    public private(set) var statistics = ComponentCacheStatistics()
+
+    public nonisolated init() { }
+
+    /// Number of cached definitions.
+    public var count: Int { entries.count }
+
+    /// Get a definition for some Slint code, compiling it only if it hasn't been already.
+    /// - Parameters:
+    ///   - source: The Slint code.
+    ///   - path: Where the code came from. Relative imports are resolved against it.
+    ///   - style: Widget style. Empty for the default.
+    ///   - includePaths: Directories searched for imports.
+    /// - Throws: `SlintCompiler.CompilerError.compileFailed`, with the diagnostics. Failures aren't cached.
+    public func definition(fromSource source: String, path: String = "", style: String = "", includePaths: [String] = []) throws -> ComponentDefinition {
+        let origin = Key.Origin.source(digest: Self.digest(source), length: source.utf8.count, path: path)
+        return try definition(Key(origin: origin, style: style, includePaths: includePaths), source: source) { compiler in
+            try compiler.build(fromSource: source, path: path)
+        } dependencies: {
+            let directory = path.isEmpty ? FileManager.default.currentDirectoryPath : directoryOf(path)
+            return Self.imports(of: source, from: directory, includePaths: includePaths)
+        }
+    }
+
+    /// Get a definition for a `.slint` file, compiling it only if it, or anything it imports, changed.
+    /// - Throws: `SlintCompiler.CompilerError.compileFailed`, with the diagnostics. Failures aren't cached.
+    public func definition(fromPath path: String, style: String = "", includePaths: [String] = []) throws -> ComponentDefinition {
+        let path = URL(fileURLWithPath: path).standardizedFileURL.path
+        return try definition(Key(origin: .file(path), style: style, includePaths: includePaths)) { compiler in
+            try compiler.build(fromPath: path)
+        } dependencies: {
+            let source = (try? String(contentsOfFile: path, encoding: .utf8)) ?? ""
+            return [Dependency(path)] + Self.imports(of: source, from: directoryOf(path), includePaths: includePaths)
+        }
+    }
+
+    /// Drop every entry. Definitions already handed out stay valid.
+    public func removeAll() {
+        entries.removeAll()
+        compilers.removeAll()
+    }
+
+    public func resetStatistics() {
+        statistics = ComponentCacheStatistics()
+    }
+
+    /// - Parameter source: The code, if the key was made from its digest. A hit has to match it.
+    private func definition(
+        _ key: Key,
+        source: String? = nil,
+        compile: (SlintCompiler) throws -> ComponentDefinition,
+        dependencies: () -> [Dependency]
+    ) throws -> ComponentDefinition {
+        // A different source under the same key is a digest collision. It's a plain miss, and replaces the entry.
+        if let entry = entries[key], entry.source == source {
+            if entry.dependencies.allSatisfy(\.isCurrent) {
+                statistics.hits += 1
+                statistics.savedNanoseconds += entry.compileNanoseconds
+                return ComponentDefinition(copying: entry.definition)
+            }
+            entries[key] = nil
+            statistics.invalidations += 1
+        }
+        statistics.misses += 1
+
+        // Dated before compiling, so a file saved mid-compile is caught by the next lookup.
+        let dependencies = dependencies()
+
+        let start = monotonicNanoseconds()
+        let definition = try compile(compiler(style: key.style, includePaths: key.includePaths))
+        let elapsed = monotonicNanoseconds() - start
+
+        statistics.compileNanoseconds += elapsed
+        entries[key] = Entry(definition, elapsed, dependencies, source: source)
+        return ComponentDefinition(copying: definition)
+    }
+
+    private func compiler(style: String, includePaths: [String]) -> SlintCompiler {
+        let configuration = [style] + includePaths
+        if let compiler = compilers[configuration] { return compiler }
+
+        let compiler = SlintCompiler()
+        if !style.isEmpty { compiler.style = style }
+        if !includePaths.isEmpty { compiler.includePaths = includePaths }
+        compilers[configuration] = compiler
+        return compiler
+    }
+
+    // MARK: Helpers
+
+    /// 64-bit FNV-1a of the UTF-8 bytes. Stable, unlike `Hasher`. Only narrows the lookup: hits still compare the source.
+    static func digest(_ source: String) -> UInt64 {
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+        for byte in source.utf8 {
+            hash = (hash ^ UInt64(byte)) &* 0x0000_0100_0000_01b3
+        }
+        return hash
+    }
+
+    /// `import { A, B } from "file.slint";` and `import "font.ttf";`
+    private static let importPattern = try! NSRegularExpression(pattern: #"import\s*(?:\{[^}]*\}\s*from\s*)?"([^"]+)""#)
+
+    /// Every file some code imports, directly or not, that can be found on disk.
+    static func imports(of source: String, from directory: String, includePaths: [String]) -> [Dependency] {
+        var found: [Dependency] = []
+        var visited = Set<String>()
+
+        func scan(_ source: String, from directory: String) {
+            let range = NSRange(source.startIndex..., in: source)
+            for match in importPattern.matches(in: source, range: range) {
+                guard let nameRange = Range(match.range(at: 1), in: source) else { continue }
+                let name = String(source[nameRange])
+
+                let candidates = name.hasPrefix("/") ? [URL(fileURLWithPath: name)] : ([directory] + includePaths).map { URL(fileURLWithPath: $0).appendingPathComponent(name) }
+                guard let path = candidates.map(\.standardizedFileURL.path).first(where: FileManager.default.fileExists(atPath:)),
+                      visited.insert(path).inserted
+                else { continue }
+
+                found.append(Dependency(path))
+                if path.hasSuffix(".slint"), let imported = try? String(contentsOfFile: path, encoding: .utf8) {
+                    scan(imported, from: directoryOf(path))
+                }
+            }
+        }
+
+        scan(source, from: directory)
+        return found
+    }
+}
+
+/// Directory a file is in.
+private func directoryOf(_ path: String) -> String {
+    URL(fileURLWithPath: path).deletingLastPathComponent().path
+}
@@ -0,0 +1,113 @@
+//
+//  ComponentDefinition.swift
+//  slint
+//
+//  Created by Matthew Taylor on 2/17/24.
+//
+
+import SlintFFI
+
+/// A compiled component, ready to be instantiated. Made by `SlintCompiler`, or handed out by `ComponentDefinitionCache`.
+///
+/// Slint's definitions are reference counted, so a copy is cheap. But the count isn't atomic:
+/// a definition, and all its copies, must stay on one thread.
+public final class ComponentDefinition {
+    /// The wrapped definition. Heap allocated, because Slint constructs it in place.
+    let handle: UnsafeMutablePointer<ComponentDefinitionOpaque>
+
+    /// Take ownership of a definition Slint has constructed.
+    init(owning handle: UnsafeMutablePointer<ComponentDefinitionOpaque>) {
+        self.handle = handle
+    }
+
+    /// Share another definition. Doesn't compile anything.
+    public init(copying other: ComponentDefinition) {
+        handle = .allocate(capacity: 1)
+        slint_interpreter_component_definition_clone(other.handle, handle)
+    }
+
+    deinit {
+        slint_interpreter_component_definition_destructor(handle)
+        handle.deallocate()
+    }
+
+    /// Name of the component.
+    public var name: String {
+        var name = SharedString()
+        slint_interpreter_component_definition_name(handle, &name)
+        return name.string
+    }
+
+    /// Names of the component's callbacks.
+    public var callbacks: [String] {
+        var names = SharedStringVector()
+        slint_interpreter_component_definition_callbacks(handle, &names)
+        return names.strings
+    }
+
+    /// Names of the exported global singletons.
+    public var globals: [String] {
+        var names = SharedStringVector()
+        slint_interpreter_component_definition_globals(handle, &names)
+        return names.strings
+    }
+
+    /// The component's public properties.
+    public var properties: [SlintPropertyDescriptor] {
+        var descriptors = PropertyDescriptorVector()
+        slint_interpreter_component_definition_properties(handle, &descriptors)
+        return descriptors.descriptors
+    }
+
+    /// An exported global's public properties, or `nil` if there's no such global.
+    public func properties(ofGlobal global: String) -> [SlintPropertyDescriptor]? {
+        var descriptors = PropertyDescriptorVector()
+        guard global.withStrSlice({ slint_interpreter_component_definition_global_properties(handle, $0, &descriptors) }) else { return nil }
+        return descriptors.descriptors
+    }
+
+    /// Names of an exported global's callbacks, or `nil` if there's no such global.
+    public func callbacks(ofGlobal global: String) -> [String]? {
+        var names = SharedStringVector()
+        guard global.withStrSlice({ slint_interpreter_component_definition_global_callbacks(handle, $0, &names) }) else { return nil }
+        return names.strings
+    }
+}
+
+/// A property's name and type, as Slint describes it.
+public struct SlintPropertyDescriptor {
+    public let name: String
+    public let type: ValueType
+}
+
+extension PropertyDescriptorVector {
+    /// Copy every descriptor out.
+    var descriptors: [SlintPropertyDescriptor] {
+        withUnsafePointer(to: self) { vec in
+            (0 ..< slint_property_descriptor_vector_len(vec)).map {
+                SlintPropertyDescriptor(
+                    name: slint_property_descriptor_vector_name_at(vec, $0).pointee.string,
+                    type: slint_property_descriptor_vector_type_at(vec, $0)
+                )
+            }
+        }
+    }
+}
+
+extension SharedStringVector {
+    /// Copy every string out.
+    var strings: [String] {
+        withUnsafePointer(to: self) { vec in
+            (0 ..< slint_shared_string_vector_len(vec)).map { slint_shared_string_vector_at(vec, $0).pointee.string }
+        }
+    }
+
+    /// Make a vector of Slint strings.
+    init(_ strings: [String]) {
+        self.init()
+        for string in strings {
+            let shared = SharedString(string)
+            withUnsafePointer(to: shared) { slint_shared_string_vector_push(&self, $0) }
+        }
+    }
+}
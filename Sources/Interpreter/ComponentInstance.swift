@@ -0,0 +1,82 @@
+//
+//  ComponentInstance.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A live instance of a component. Made with `ComponentDefinition.create()`.
+///
+/// Instances belong to the event loop. Creating one creates its window, through the platform.
+@SlintActor
+public final class SlintComponentInstance {
+    /// The C++ handle. Opaque to Swift.
+    private let handle: UnsafeMutableRawPointer
+
+    /// The erased item tree, for Slint's instance functions.
+    var erased: OpaquePointer { slint_swift_component_instance_erased(handle) }
+
+    init(_ definition: ComponentDefinition) {
+        handle = slint_swift_component_instance_new(definition.handle)
+        // So an animation that starts while the loop is idle still gets its frames.
+        WakeupScheduler.shared.watchAnimations(of: self)
+    }
+
+    deinit {
+        slint_swift_component_instance_drop(handle)
+    }
+
+    /// Show the window.
+    public func show() {
+        slint_interpreter_component_instance_show(erased, true)
+    }
+
+    /// Hide the window.
+    public func hide() {
+        slint_interpreter_component_instance_show(erased, false)
+    }
+
+    /// Resize the window, in physical pixels.
+    public func setSize(width: UInt32, height: UInt32) {
+        slint_swift_component_instance_set_size(handle, width, height)
+    }
+
+    /// Get or set a property. Reading a property that doesn't exist gives `nil`.
+    /// Setting one that doesn't exist, or with the wrong type, does nothing.
+    public subscript(property name: String) -> SlintValue? {
+        get {
+            guard let box = name.withStrSlice({ slint_interpreter_component_instance_get_property(erased, $0) }) else { return nil }
+            return SlintValue(consuming: box)
+        }
+        set {
+            _ = setProperty(name, newValue ?? .void)
+        }
+    }
+
+    /// Set a property. In `Slint.batch`, it's held until the batch ends.
+    /// - Returns: False if there's no such property, or the value has the wrong type.
+    ///   Always true in a batch, since it isn't set yet.
+    @discardableResult
+    public func setProperty(_ name: String, _ value: SlintValue) -> Bool {
+        guard !PropertyBatch.isOpen else {
+            PropertyBatch.stage(StagedInstanceWrite(self, name, value))
+            return true
+        }
+        return applyProperty(name, value)
+    }
+
+    /// Set a property now, batch or not.
+    func applyProperty(_ name: String, _ value: SlintValue) -> Bool {
+        value.withValuePointer { box in
+            name.withStrSlice { slint_interpreter_component_instance_set_property(erased, $0, box) }
+        }
+    }
+}
+
+extension ComponentDefinition {
+    /// Make a new instance. Must be on the event loop, because it creates a window.
+    @SlintActor
+    public func create() -> SlintComponentInstance {
+        SlintComponentInstance(self)
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  Diagnostic.swift
+//  slint
+//
+
+import SlintFFI
+
+/// An error or warning from compiling Slint code.
+public struct SlintDiagnostic: CustomStringConvertible {
+    public enum Level {
+        case error
+        case warning
+    }
+
+    public let level: Level
+    public let message: String
+    /// File the diagnostic is in. Empty for code built from a string without a path.
+    public let sourceFile: String
+    /// 1-based. 0 if unknown.
+    public let line: Int
+    /// 1-based. 0 if unknown.
+    public let column: Int
+
+    init(_ diagnostic: UnsafePointer<Diagnostic>) {
+        level = slint_diagnostic_is_error(diagnostic) ? .error : .warning
+        message = diagnostic.pointee.message.string
+        sourceFile = diagnostic.pointee.source_file.string
+        line = Int(diagnostic.pointee.line)
+        column = Int(diagnostic.pointee.column)
+    }
+
+    /// Formatted like a compiler, e.g. `main.slint:3:5: error: Unknown property`.
+    public var description: String {
+        let location = line > 0 ? "\(sourceFile):\(line):\(column)" : sourceFile
+        let prefix = location.isEmpty ? "" : "\(location): "
+        return "\(prefix)\(level == .error ? "error" : "warning"): \(message)"
+    }
+}
+
+extension DiagnosticVector {
+    /// Copy every diagnostic out.
+    var diagnostics: [SlintDiagnostic] {
+        withUnsafePointer(to: self) { vec in
+            (0 ..< slint_diagnostic_vector_len(vec)).map { SlintDiagnostic(slint_diagnostic_vector_at(vec, $0)) }
+        }
+    }
+}
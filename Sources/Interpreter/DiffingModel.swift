@@ -0,0 +1,137 @@
+//
+//  DiffingModel.swift
+//  slint
+//
+
+/// A model fed with whole snapshots, like a sorted table, or search results, that tells Slint only what changed between them.
+///
+/// Each snapshot is diffed against the last, by `id`, off the event loop. Then, on it, the rows are swapped,
+/// and Slint gets the matching removed, added and changed notifications, rather than a reset, which would rebuild every row it shows.
+/// Rows that moved are removed and added again, since Slint has no notification for a move.
+///
+/// ```swift
+/// let alarms = SlintDiffingModel<Alarm> { .string(SharedString($0.title)) }
+/// instance.setProperty("alarms", .model(alarms))
+/// for await snapshot in backend.alarms {
+///     await alarms.update(to: snapshot.sorted(by: \.severity))
+/// }
+/// ```
+@SlintActor
+public final class SlintDiffingModel<Element: Identifiable & Equatable & Sendable>: SlintModel {
+    public let notifier = SlintModelNotifier()
+
+    /// The current snapshot.
+    public private(set) var rows: [Element]
+
+    private let makeValue: (Element) -> SlintValue
+
+    /// The last update, so updates apply in order, each against the rows the one before left.
+    private var pending: Task<Void, Never>?
+
+    /// - Parameters:
+    ///   - rows: Initial rows.
+    ///   - makeValue: Turns a row into a value, when Slint reads it.
+    public nonisolated init(_ rows: [Element] = [], _ makeValue: @escaping (Element) -> SlintValue) {
+        self.rows = rows
+        self.makeValue = makeValue
+    }
+
+    public var rowCount: Int { rows.count }
+
+    public func rowData(_ row: Int) -> SlintValue? {
+        rows.indices.contains(row) ? makeValue(rows[row]) : nil
+    }
+
+    /// Show a new snapshot. The diff runs on another thread; only the notifications run on the event loop.
+    /// Returns once they have.
+    public func update(to snapshot: [Element]) async {
+        let previous = pending
+        let update = Task { @SlintActor in
+            await previous?.value
+            let old = rows
+            let diff = await Task.detached(priority: .userInitiated) { SnapshotDiff(from: old, to: snapshot) }.value
+            apply(diff, snapshot)
+        }
+        pending = update
+        await update.value
+    }
+
+    /// Swap in a snapshot, and notify. `diff` must be from the current rows to `snapshot`.
+    func apply(_ diff: SnapshotDiff, _ snapshot: [Element]) {
+        // Slint only reads rows after it's been told what changed, so the whole snapshot can go in first.
+        rows = snapshot
+        for range in diff.removals { notifier.rowsRemoved(at: range.lowerBound, count: range.count) }
+        for range in diff.insertions { notifier.rowsAdded(at: range.lowerBound, count: range.count) }
+        for row in diff.changes { notifier.rowChanged(row) }
+    }
+}
+
+/// The fewest row removals and insertions that turn one snapshot into another, plus the rows that stayed, but changed.
+///
+/// Rows are matched by `id`. The rows that stay are the longest run of matched rows that kept their relative order,
+/// found as a longest increasing subsequence of their old positions, in O(N log N). Everything else is removed or inserted.
+/// With unique ids, that's the same minimal script Myers' diff would find, without its worst case.
+public struct SnapshotDiff: Sendable {
+    /// Ranges of old rows to remove, last first, so each range's indices are still right when it's removed.
+    public private(set) var removals: [Range<Int>] = []
+
+    /// Ranges of new rows to insert, first first, after the removals.
+    public private(set) var insertions: [Range<Int>] = []
+
+    /// New rows that stayed, but aren't equal to what they were.
+    public private(set) var changes: [Int] = []
+
+    /// Notifications applying it sends.
+    public var notificationCount: Int { removals.count + insertions.count + changes.count }
+
+    public init<Element: Identifiable & Equatable>(from old: [Element], to new: [Element]) {
+        var oldIndices = [Element.ID: Int](minimumCapacity: old.count)
+        for (index, element) in old.enumerated() { oldIndices[element.id] = index }
+
+        // Each new row's old position, or -1 if it's new.
+        let matched = new.map { oldIndices[$0.id] ?? -1 }
+
+        // Patience sort: `tails[k]` is the new index ending the best increasing run of length k + 1 found so far.
+        var tails: [Int] = []
+        var previous = [Int](repeating: -1, count: new.count)
+        for (index, oldIndex) in matched.enumerated() where oldIndex >= 0 {
+            var low = 0
+            var high = tails.count
+            while low < high {
+                let middle = (low + high) / 2
+                if matched[tails[middle]] < oldIndex { low = middle + 1 } else { high = middle }
+            }
+            if low > 0 { previous[index] = tails[low - 1] }
+            if low == tails.count { tails.append(index) } else { tails[low] = index }
+        }
+
+        var keptNew = [Bool](repeating: false, count: new.count)
+        var keptOld = [Bool](repeating: false, count: old.count)
+        var index = tails.last ?? -1
+        while index >= 0 {
+            keptNew[index] = true
+            keptOld[matched[index]] = true
+            if old[matched[index]] != new[index] { changes.append(index) }
+            index = previous[index]
+        }
+        changes.reverse()
+
+        removals = Self.gaps(in: keptOld).reversed()
+        insertions = Self.gaps(in: keptNew)
+    }
+
+    /// Runs of rows that weren't kept.
+    private static func gaps(in kept: [Bool]) -> [Range<Int>] {
+        var gaps: [Range<Int>] = []
+        var start: Int?
+        for (index, isKept) in kept.enumerated() {
+            if !isKept, start == nil { start = index }
+            if isKept, let gapStart = start {
+                gaps.append(gapStart ..< index)
+                start = nil
+            }
+        }
+        if let start { gaps.append(start ..< kept.count) }
+        return gaps
+    }
+}
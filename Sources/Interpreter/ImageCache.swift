@@ -0,0 +1,210 @@
+//
+//  ImageCache.swift
+//  slint
+//
+
+// For `ProcessInfo`, and reading files.
+import Foundation
+
+import SlintFFI
+
+/// How well an `ImageCache` is doing.
+public struct ImageCacheStatistics {
+    public var hits = 0
+    public var misses = 0
+    /// Requests that waited for a decode another request had already started, rather than starting their own.
+    public var deduplicated = 0
+    /// Images dropped to stay within the byte budget.
+    public var evictions = 0
+    /// Misses that failed: files that couldn't be read, or weren't a PNG or JPEG.
+    public var failures = 0
+    /// Time workers spent reading, decoding and scaling, on misses.
+    public var decodeNanoseconds: UInt64 = 0
+    /// Most bytes of pixels held at once.
+    public var peakResidentBytes = 0
+
+    /// Fraction of lookups that were hits, from 0 to 1. Deduplicated requests don't count either way.
+    public var hitRate: Double {
+        hits + misses == 0 ? 0 : Double(hits) / Double(hits + misses)
+    }
+}
+
+/// Decodes and scales images on worker threads, and keeps the pixels for the event loop, within a budget of bytes.
+///
+/// A miss is read, decoded and scaled on a worker, so the event loop only looks the image up,
+/// and wraps the finished pixels in an image value, which shares them. Requests for an image that's already
+/// being decoded wait for that decode, instead of starting another.
+///
+/// Entries are keyed by path, and the size they're scaled to fit. When the pixels held go over `byteBudget`,
+/// the least recently used are dropped. Images already handed out keep their pixels until Slint lets go of them:
+/// dropping an entry only means the next request decodes it again. Failures aren't cached.
+///
+/// Workers are started once and never exit, so make a cache once, or use `shared`.
+@SlintActor
+public final class ImageCache {
+    /// Shared cache, with 64 MiB of pixels, and a worker per core.
+    public static let shared = ImageCache()
+
+    public enum LoadError: Error {
+        /// The file couldn't be read.
+        case unreadable(path: String)
+        /// The file isn't a PNG or JPEG, it's broken, or it's too big. Every file is, without the image decoders.
+        case undecodable(path: String)
+    }
+
+    struct Key: Hashable {
+        let path: String
+        let maxWidth: Int
+        let maxHeight: Int
+    }
+
+    /// Cached pixels. The dictionary owns entries, and they're linked from most to least recently used.
+    final class Entry {
+        let key: Key
+        let pixels: SlintPixelBuffer
+        weak var newer: Entry?
+        weak var older: Entry?
+
+        init(_ key: Key, _ pixels: SlintPixelBuffer) {
+            self.key = key
+            self.pixels = pixels
+        }
+    }
+
+    private let workers: WorkerPool
+    private var entries: [Key: Entry] = [:]
+    private weak var newest: Entry?
+    private weak var oldest: Entry?
+    /// Decodes under way. Every request for one waits on its channel.
+    private var inFlight: [Key: AsyncChannel<Result<SlintPixelBuffer, Error>>] = [:]
+
+    /// Most bytes of pixels to keep. Lowering it drops entries straight away.
+    /// An image bigger than the whole budget is still decoded and handed out, just not kept.
+    public var byteBudget: Int {
+        didSet { evict() }
+    }
+
+    /// Bytes of pixels held.
+    public private(set) var residentBytes = 0
+
+    /// Hits, misses, and evictions, since the cache was made or `resetStatistics()` was last called.
+    public private(set) var statistics = ImageCacheStatistics()
+
+    /// Make a cache.
+    /// - Parameters:
+    ///   - byteBudget: Most bytes of pixels to keep. Defaults to 64 MiB.
+    ///   - workers: Number of worker threads. Defaults to one per core.
+    public nonisolated init(byteBudget: Int = 64 << 20, workers: Int = ProcessInfo.processInfo.activeProcessorCount) {
+        self.byteBudget = byteBudget
+        self.workers = WorkerPool(name: "Slint image decoder", workers: workers)
+    }
+
+    /// Number of cached images.
+    public var count: Int { entries.count }
+
+    /// Get an image, as a value for an `image` property.
+    /// - Parameters:
+    ///   - path: A PNG or JPEG file.
+    ///   - maxWidth: Scale the image down to fit this wide, keeping its aspect ratio. `nil` for no limit.
+    ///   - maxHeight: Scale the image down to fit this high, keeping its aspect ratio. `nil` for no limit.
+    /// - Throws: `ImageCache.LoadError`.
+    public func image(atPath path: String, maxWidth: Int? = nil, maxHeight: Int? = nil) async throws -> SlintValue {
+        try await .image(pixels(atPath: path, maxWidth: maxWidth, maxHeight: maxHeight))
+    }
+
+    /// Get an image's pixels. Only decoded if they aren't cached, and aren't already being decoded.
+    /// - Throws: `ImageCache.LoadError`.
+    public func pixels(atPath path: String, maxWidth: Int? = nil, maxHeight: Int? = nil) async throws -> SlintPixelBuffer {
+        let key = Key(path: URL(fileURLWithPath: path).standardizedFileURL.path, maxWidth: maxWidth ?? .max, maxHeight: maxHeight ?? .max)
+
+        if let entry = entries[key] {
+            statistics.hits += 1
+            unlink(entry)
+            link(entry)
+            return entry.pixels
+        }
+
+        if let pending = inFlight[key] {
+            statistics.deduplicated += 1
+            return try await pending.value.get()
+        }
+
+        statistics.misses += 1
+        let pending = AsyncChannel(Result<SlintPixelBuffer, Error>.self)
+        inFlight[key] = pending
+        workers.enqueue {
+            let start = monotonicNanoseconds()
+            let result = Result { try Self.load(key) }
+            let elapsed = monotonicNanoseconds() - start
+            // Finished on the event loop, even if every request has been cancelled, so the work isn't wasted.
+            SlintActor.dispatch { self.finish(key, result, elapsed) }
+        }
+        return try await pending.value.get()
+    }
+
+    /// Drop every entry. Images already handed out stay valid, and decodes under way are still cached.
+    public func removeAll() {
+        entries.removeAll()
+        residentBytes = 0
+    }
+
+    public func resetStatistics() {
+        statistics = ImageCacheStatistics()
+        statistics.peakResidentBytes = residentBytes
+    }
+
+    /// Read, decode and scale, on a worker.
+    private nonisolated static func load(_ key: Key) throws -> SlintPixelBuffer {
+        guard let data = FileManager.default.contents(atPath: key.path) else { throw LoadError.unreadable(path: key.path) }
+        guard let pixels = SlintPixelBuffer(decoding: data) else { throw LoadError.undecodable(path: key.path) }
+        return pixels.scaled(toFit: key.maxWidth, key.maxHeight)
+    }
+
+    /// Cache a finished decode, and hand it to every request waiting for it.
+    private func finish(_ key: Key, _ result: Result<SlintPixelBuffer, Error>, _ elapsed: UInt64) {
+        statistics.decodeNanoseconds += elapsed
+
+        switch result {
+        case .success(let pixels) where pixels.byteCount <= byteBudget:
+            let entry = Entry(key, pixels)
+            entries[key] = entry
+            link(entry)
+            residentBytes += pixels.byteCount
+            statistics.peakResidentBytes = max(statistics.peakResidentBytes, residentBytes)
+            evict()
+        case .success:
+            break
+        case .failure:
+            statistics.failures += 1
+        }
+
+        inFlight.removeValue(forKey: key)?.send(result)
+    }
+
+    /// Drop the least recently used entries, until the pixels fit the budget.
+    private func evict() {
+        while residentBytes > byteBudget, let entry = oldest {
+            unlink(entry)
+            entries[entry.key] = nil
+            residentBytes -= entry.pixels.byteCount
+            statistics.evictions += 1
+        }
+    }
+
+    // MARK: Recency
+
+    /// Make an entry the most recently used.
+    private func link(_ entry: Entry) {
+        entry.older = newest
+        newest?.newer = entry
+        newest = entry
+        if oldest == nil { oldest = entry }
+    }
+
+    private func unlink(_ entry: Entry) {
+        if let newer = entry.newer { newer.older = entry.older } else { newest = entry.older }
+        if let older = entry.older { older.newer = entry.newer } else { oldest = entry.newer }
+        entry.newer = nil
+        entry.older = nil
+    }
+}
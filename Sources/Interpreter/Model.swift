@@ -0,0 +1,242 @@
+//
+//  Model.swift
+//  slint
+//
+
+import SlintFFI
+
+/// Rows for a Slint `for` or `ListView`, read straight from Swift storage.
+///
+/// Slint asks for the row count, and then only for the rows it shows, so a model can hold far more rows than are ever turned into `SlintValue`s.
+/// When rows change, tell Slint which ones, through `notifier`, and it updates just those.
+///
+/// ```swift
+/// let log = SlintArrayModel(entries) { .string(SharedString($0.message)) }
+/// instance.setProperty("entries", .model(log))
+/// log.append(entry) // Slint adds one row.
+/// ```
+@SlintActor
+public protocol SlintModel: AnyObject {
+    /// Number of rows.
+    var rowCount: Int { get }
+
+    /// A row's value. Only called for rows Slint needs, e.g. the visible ones.
+    func rowData(_ row: Int) -> SlintValue?
+
+    /// Slint changed a row, e.g. through a two-way binding. Ignored by default.
+    func setRowData(_ row: Int, _ value: SlintValue)
+
+    /// Tells Slint about changes. Every Slint value made from this model listens to it.
+    var notifier: SlintModelNotifier { get }
+}
+
+public extension SlintModel {
+    func setRowData(_ row: Int, _ value: SlintValue) { }
+}
+
+extension SlintValue {
+    /// A value for a model property. Slint reads rows from `model` as it needs them, and the value keeps it alive.
+    @SlintActor
+    public static func model(_ model: any SlintModel) -> SlintValue {
+        let adaptor = ModelAdaptor(model)
+        let box = slint_interpreter_value_new_model(
+            adaptor.retainedPointer().assumingMemoryBound(to: UInt8.self),
+            ModelAdaptor.vtable
+        )
+        return .other(SlintValueBox(owning: box))
+    }
+}
+
+// MARK: - Notifications
+
+/// Tells Slint which rows of a model changed. Same as the C++ `ModelNotify`, and for each Slint value made from the model.
+@SlintActor
+public final class SlintModelNotifier {
+    /// Slint values made from the model. Each removes itself when Slint drops it.
+    fileprivate var adaptors: [ModelAdaptor] = []
+
+    public nonisolated init() { }
+
+    /// `count` rows were inserted at `row`.
+    public func rowsAdded(at row: Int, count: Int) {
+        guard count > 0 else { return }
+        for adaptor in adaptors { slint_interpreter_model_notify_row_added(adaptor.notify, UInt(row), UInt(count)) }
+    }
+
+    /// `count` rows were removed from `row` on.
+    public func rowsRemoved(at row: Int, count: Int) {
+        guard count > 0 else { return }
+        for adaptor in adaptors { slint_interpreter_model_notify_row_removed(adaptor.notify, UInt(row), UInt(count)) }
+    }
+
+    /// The row's value changed.
+    public func rowChanged(_ row: Int) {
+        for adaptor in adaptors { slint_interpreter_model_notify_row_changed(adaptor.notify, UInt(row)) }
+    }
+
+    /// Everything changed. Slint drops every row it made, and starts over. Prefer the precise notifications.
+    public func reset() {
+        for adaptor in adaptors { slint_interpreter_model_notify_reset(adaptor.notify) }
+    }
+}
+
+// MARK: - Adaptor
+
+/// What Slint holds for a model value: the model, and the notify handle Slint listens to.
+/// Slint calls into it through `vtable`, with a retained pointer that `drop` releases.
+final class ModelAdaptor {
+    let model: any SlintModel
+
+    /// Slint keeps pointers to it, so it's allocated once, and never moves.
+    let notify: UnsafeMutablePointer<ModelNotifyOpaque>
+
+    @SlintActor
+    init(_ model: any SlintModel) {
+        self.model = model
+        notify = .allocate(capacity: 1)
+        slint_interpreter_model_notify_new(notify)
+        model.notifier.adaptors.append(self)
+    }
+
+    deinit {
+        slint_interpreter_model_notify_destructor(notify)
+        notify.deallocate()
+    }
+
+    func retainedPointer() -> UnsafeMutableRawPointer {
+        Unmanaged.passRetained(self).toOpaque()
+    }
+
+    static func from(_ instance: UnsafeRawPointer?) -> ModelAdaptor {
+        Unmanaged<ModelAdaptor>.fromOpaque(instance!).takeUnretainedValue()
+    }
+
+    /// One vtable, for every model. Slint only calls it on the event loop.
+    static let vtable: UnsafeMutablePointer<ModelAdaptorVTable> = {
+        let vtable = UnsafeMutablePointer<ModelAdaptorVTable>.allocate(capacity: 1)
+        vtable.initialize(to: ModelAdaptorVTable(
+            row_count: { reference in
+                let model = ModelAdaptor.from(reference.instance).model
+                return UInt(SlintActor.assumeIsolated { model.rowCount })
+            },
+            row_data: { reference, row in
+                let model = ModelAdaptor.from(reference.instance).model
+                // Slint takes ownership of the box.
+                return SlintActor.assumeIsolated { model.rowData(Int(row))?.makeBox() }
+            },
+            set_row_data: { reference, row, box in
+                let model = ModelAdaptor.from(reference.instance).model
+                // We get ownership of the box.
+                let value = SlintValue(consuming: box!)
+                SlintActor.assumeIsolated { model.setRowData(Int(row), value) }
+            },
+            get_notify: { reference in
+                UnsafePointer(ModelAdaptor.from(reference.instance).notify)
+            },
+            drop: { reference in
+                let adaptor = Unmanaged<ModelAdaptor>.fromOpaque(reference.instance!)
+                SlintActor.assumeIsolated {
+                    let notifier = adaptor.takeUnretainedValue().model.notifier
+                    notifier.adaptors.removeAll { $0 === adaptor.takeUnretainedValue() }
+                }
+                adaptor.release()
+            }
+        ))
+        return vtable
+    }()
+}
+
+// MARK: - Array model
+
+/// A model backed by an array, like the C++ `VectorModel`. Rows are only turned into values when Slint reads them.
+///
+/// Changing it through these methods tells Slint exactly which rows changed.
+@SlintActor
+public final class SlintArrayModel<Element>: SlintModel {
+    public let notifier = SlintModelNotifier()
+
+    /// The rows. Change them through the methods, so Slint hears about it.
+    public private(set) var rows: [Element]
+
+    private let makeValue: (Element) -> SlintValue
+    private let makeElement: ((SlintValue) -> Element?)?
+
+    /// - Parameters:
+    ///   - rows: Initial rows.
+    ///   - makeValue: Turns a row into a value, when Slint reads it.
+    ///   - makeElement: Turns a value Slint wrote back into a row. Without it, writes from Slint are ignored.
+    public nonisolated init(
+        _ rows: [Element] = [],
+        makeElement: ((SlintValue) -> Element?)? = nil,
+        _ makeValue: @escaping (Element) -> SlintValue
+    ) {
+        self.rows = rows
+        self.makeValue = makeValue
+        self.makeElement = makeElement
+    }
+
+    public var rowCount: Int { rows.count }
+
+    public func rowData(_ row: Int) -> SlintValue? {
+        rows.indices.contains(row) ? makeValue(rows[row]) : nil
+    }
+
+    public func setRowData(_ row: Int, _ value: SlintValue) {
+        guard rows.indices.contains(row), let element = makeElement?(value) else { return }
+        self[row] = element
+    }
+
+    public subscript(row: Int) -> Element {
+        get { rows[row] }
+        set {
+            rows[row] = newValue
+            notifier.rowChanged(row)
+        }
+    }
+
+    public func append(_ element: Element) {
+        rows.append(element)
+        notifier.rowsAdded(at: rows.count - 1, count: 1)
+    }
+
+    public func append<S: Sequence>(contentsOf elements: S) where S.Element == Element {
+        let start = rows.count
+        rows.append(contentsOf: elements)
+        notifier.rowsAdded(at: start, count: rows.count - start)
+    }
+
+    public func insert(_ element: Element, at row: Int) {
+        rows.insert(element, at: row)
+        notifier.rowsAdded(at: row, count: 1)
+    }
+
+    public func insert<C: Collection>(contentsOf elements: C, at row: Int) where C.Element == Element {
+        rows.insert(contentsOf: elements, at: row)
+        notifier.rowsAdded(at: row, count: elements.count)
+    }
+
+    @discardableResult
+    public func remove(at row: Int) -> Element {
+        let element = rows.remove(at: row)
+        notifier.rowsRemoved(at: row, count: 1)
+        return element
+    }
+
+    public func removeSubrange(_ range: Range<Int>) {
+        rows.removeSubrange(range)
+        notifier.rowsRemoved(at: range.lowerBound, count: range.count)
+    }
+
+    /// Replace every row. Slint starts over, so prefer the precise methods when only some rows changed.
+    public func replaceAll(with rows: [Element]) {
+        self.rows = rows
+        notifier.reset()
+    }
+}
+
+public extension SlintArrayModel where Element == SlintValue {
+    /// A model of values, used as they are.
+    nonisolated convenience init(_ rows: [SlintValue] = []) {
+        self.init(rows, makeElement: { $0 }) { $0 }
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  PixelBuffer.swift
+//  slint
+//
+
+// For `Data`.
+import Foundation
+
+import SlintFFI
+#if canImport(SlintImageDecoders)
+import SlintImageDecoders
+#endif
+
+/// Pixels, ready to show: RGBA, straight alpha, 4 bytes each, rows packed. Decoded by hand, or handed out by `ImageCache`.
+///
+/// The pixels are a Slint pixel buffer, whose count is atomic, so a buffer can be made on one thread and shown on another.
+/// Only write to it before it's first shown. After that, Slint shares the pixels, and writing copies them first.
+public final class SlintPixelBuffer: @unchecked Sendable {
+    /// `SharedPixelBuffer<Rgba8Pixel>`, on the C++ heap.
+    let handle: UnsafeMutableRawPointer
+
+    public let width: Int
+    public let height: Int
+
+    /// Take ownership of a buffer.
+    init(owning handle: UnsafeMutableRawPointer) {
+        self.handle = handle
+        width = Int(slint_swift_pixel_buffer_width(handle))
+        height = Int(slint_swift_pixel_buffer_height(handle))
+    }
+
+    /// A buffer of uninitialized pixels.
+    public convenience init(width: Int, height: Int) {
+        self.init(owning: slint_swift_pixel_buffer_new(UInt32(width), UInt32(height)))
+    }
+
+    /// Decode a PNG or JPEG. `nil` if it's neither, it's broken, or it's over `maxDecodedPixels`.
+    /// Always `nil` if SlintUI was built without libpng and libjpeg. See `canDecode`.
+    public convenience init?(decoding data: Data) {
+        #if canImport(SlintImageDecoders)
+        let handle = data.withUnsafeBytes { bytes in
+            slint_swift_pixel_buffer_decode(bytes.baseAddress?.assumingMemoryBound(to: UInt8.self), bytes.count)
+        }
+        guard let handle else { return nil }
+        self.init(owning: handle)
+        #else
+        return nil
+        #endif
+    }
+
+    /// True if SlintUI was built with the image decoders.
+    public static var canDecode: Bool {
+        #if canImport(SlintImageDecoders)
+        true
+        #else
+        false
+        #endif
+    }
+
+    /// Largest image `init(decoding:)` accepts, in pixels. Bigger ones fail before any pixels are allocated.
+    public static var maxDecodedPixels: Int {
+        #if canImport(SlintImageDecoders)
+        Int(slint_swift_pixel_buffer_max_pixels())
+        #else
+        0
+        #endif
+    }
+
+    deinit {
+        slint_swift_pixel_buffer_drop(handle)
+    }
+
+    /// Size of the pixels.
+    public var byteCount: Int { width * height * 4 }
+
+    public func withUnsafeBytes<R>(_ body: (UnsafeBufferPointer<UInt8>) throws -> R) rethrows -> R {
+        try body(UnsafeBufferPointer(start: slint_swift_pixel_buffer_const_bytes(handle), count: byteCount))
+    }
+
+    public func withUnsafeMutableBytes<R>(_ body: (UnsafeMutableBufferPointer<UInt8>) throws -> R) rethrows -> R {
+        try body(UnsafeMutableBufferPointer(start: slint_swift_pixel_buffer_bytes(handle), count: byteCount))
+    }
+
+    /// Scale down to fit within a size, keeping the aspect ratio. Each new pixel averages the pixels it covers,
+    /// weighted by their alpha, so transparent pixels don't bleed their colour.
+    /// - Returns: A new buffer, or this one, if it already fits. Never scaled up.
+    public func scaled(toFit maxWidth: Int, _ maxHeight: Int) -> SlintPixelBuffer {
+        let scale = min(Double(maxWidth) / Double(width), Double(maxHeight) / Double(height))
+        guard scale < 1 else { return self }
+        let scaledWidth = max(Int((Double(width) * scale).rounded()), 1)
+        let scaledHeight = max(Int((Double(height) * scale).rounded()), 1)
+
+        let scaled = SlintPixelBuffer(width: scaledWidth, height: scaledHeight)
+        withUnsafeBytes { source in
+            scaled.withUnsafeMutableBytes { destination in
+                for y in 0 ..< scaledHeight {
+                    let top = y * height / scaledHeight
+                    let bottom = max((y + 1) * height / scaledHeight, top + 1)
+                    for x in 0 ..< scaledWidth {
+                        let left = x * width / scaledWidth
+                        let right = max((x + 1) * width / scaledWidth, left + 1)
+
+                        var (red, green, blue, alpha) = (0, 0, 0, 0)
+                        for row in top ..< bottom {
+                            var pixel = (row * width + left) * 4
+                            for _ in left ..< right {
+                                let weight = Int(source[pixel + 3])
+                                red += Int(source[pixel]) * weight
+                                green += Int(source[pixel + 1]) * weight
+                                blue += Int(source[pixel + 2]) * weight
+                                alpha += weight
+                                pixel += 4
+                            }
+                        }
+
+                        let out = (y * scaledWidth + x) * 4
+                        let covered = (bottom - top) * (right - left)
+                        destination[out] = alpha == 0 ? 0 : UInt8(red / alpha)
+                        destination[out + 1] = alpha == 0 ? 0 : UInt8(green / alpha)
+                        destination[out + 2] = alpha == 0 ? 0 : UInt8(blue / alpha)
+                        destination[out + 3] = UInt8(alpha / covered)
+                    }
+                }
+            }
+        }
+        return scaled
+    }
+}
+
+extension SlintValue {
+    /// An image showing the pixels. They're shared with Slint, not copied.
+    public static func image(_ pixels: SlintPixelBuffer) -> SlintValue {
+        .other(SlintValueBox(owning: slint_swift_pixel_buffer_new_image_value(pixels.handle)))
+    }
+}
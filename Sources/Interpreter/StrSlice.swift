@@ -0,0 +1,65 @@
+//
+//  StrSlice.swift
+//  slint
+//
+
+// NOTE: Only for `NSLock`.
+import Foundation
+
+import SlintFFI
+
+/// Stands in for the bytes of an empty string. Slint's slices are Rust slices, which must never have a null pointer.
+private let emptyBytes = UnsafeMutablePointer<UInt8>.allocate(capacity: 1)
+
+// Convert string to string slice, for Slint APIs.
+extension String {
+    /// Calls the given closure with the UTF-8 contents of the string, as a Slint `Slice<uint8_t>`. Not null terminated.
+    /// - Parameter body: The closure to run. The slice must not escape it.
+    ///
+    /// Native Swift strings are already contiguous UTF-8, so nothing is copied.
+    func withStrSlice<R>(_ body: (StrSlice) throws -> R) rethrows -> R {
+        var string = self
+        return try string.withUTF8 { bytes in
+            var slice = StrSlice()
+            slice.ptr = UnsafeMutablePointer(mutating: bytes.baseAddress) ?? emptyBytes
+            slice.len = UInt(bytes.count)
+            return try body(slice)
+        }
+    }
+}
+
+/// A name, with a `StrSlice` of its UTF-8 bytes that stays valid forever.
+///
+/// Made by `InternedStrSlice.intern(_:)`. Each distinct name is copied once, and never freed,
+/// so use these for names that come from code (fields, properties, callbacks), not from data.
+struct InternedStrSlice {
+    let name: String
+    let slice: StrSlice
+
+    private static let lock = NSLock()
+    private static var interned: [String: InternedStrSlice] = [:]
+
+    private init(_ name: String) {
+        let utf8 = Array(name.utf8)
+        let bytes = UnsafeMutablePointer<UInt8>.allocate(capacity: max(utf8.count, 1))
+        bytes.initialize(from: utf8, count: utf8.count)
+
+        var slice = StrSlice()
+        slice.ptr = bytes
+        slice.len = UInt(utf8.count)
+
+        self.name = name
+        self.slice = slice
+    }
+
+    /// Get the interned slice for a name, making it the first time.
+    static func intern(_ name: String) -> InternedStrSlice {
+        lock.lock()
+        defer { lock.unlock() }
+
+        if let existing = interned[name] { return existing }
+        let made = InternedStrSlice(name)
+        interned[name] = made
+        return made
+    }
+}
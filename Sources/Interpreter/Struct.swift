@@ -0,0 +1,78 @@
+//
+//  Struct.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A struct for Slint's interpreter. Fields are looked up by name.
+///
+/// Usually you won't touch fields one by one. `SlintStructEncoder` and `SlintStructDecoder`
+/// convert whole `Codable` types, and cache their field names.
+public final class SlintStruct {
+    /// The wrapped struct. Heap allocated, because Slint constructs it in place.
+    let handle: UnsafeMutablePointer<StructOpaque>
+
+    /// Make an empty struct.
+    public init() {
+        handle = .allocate(capacity: 1)
+        slint_interpreter_struct_new(handle)
+    }
+
+    /// Make a copy of a struct owned by someone else. Fields are values, so they're cloned too.
+    init(copying other: UnsafePointer<StructOpaque>) {
+        handle = .allocate(capacity: 1)
+        slint_interpreter_struct_clone(other, handle)
+    }
+
+    deinit {
+        slint_interpreter_struct_destructor(handle)
+        handle.deallocate()
+    }
+
+    /// Make an independent copy.
+    public func copy() -> SlintStruct {
+        SlintStruct(copying: handle)
+    }
+
+    /// Get or set a field. Reading a field that doesn't exist gives `nil`. Setting `nil` stores `.void`,
+    /// because Slint can't remove a field.
+    public subscript(name: String) -> SlintValue? {
+        get { name.withStrSlice { field($0) } }
+        set { name.withStrSlice { setField($0, newValue ?? .void) } }
+    }
+
+    /// Every field, in Slint's order.
+    public var fields: [(name: String, value: SlintValue)] {
+        var iterator = slint_interpreter_struct_make_iter(handle)
+        defer { slint_interpreter_struct_iterator_destructor(&iterator) }
+
+        var fields: [(name: String, value: SlintValue)] = []
+        var name = StrSlice()
+        while let box = slint_interpreter_struct_iterator_next(&iterator, &name) {
+            let bytes = UnsafeBufferPointer(start: name.ptr, count: Int(name.len))
+            fields.append((String(decoding: bytes, as: UTF8.self), SlintValue(consuming: box)))
+        }
+        return fields
+    }
+
+    // MARK: By slice
+
+    /// Read a field.
+    /// - Parameter name: UTF-8 bytes of the field name. Only borrowed.
+    func field(_ name: StrSlice) -> SlintValue? {
+        guard let box = slint_interpreter_struct_get_field(handle, name) else { return nil }
+        return SlintValue(consuming: box)
+    }
+
+    /// Set a field. Slint clones the value.
+    /// - Parameter name: UTF-8 bytes of the field name. Only borrowed.
+    func setField(_ name: StrSlice, _ value: SlintValue) {
+        value.withValuePointer { setField(name, value: $0) }
+    }
+
+    /// Set a field from a borrowed interpreter value. Slint clones it.
+    func setField(_ name: StrSlice, value: OpaquePointer) {
+        slint_interpreter_struct_set_field(handle, name, value)
+    }
+}
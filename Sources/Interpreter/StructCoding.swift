@@ -0,0 +1,600 @@
+//
+//  StructCoding.swift
+//  slint
+//
+//  Convert whole `Codable` types to and from interpreter structs.
+//
+
+// NOTE: Only for `NSLock`.
+import Foundation
+
+import SlintFFI
+
+/// Encodes `Encodable` values into interpreter structs. Nested `Encodable` types become nested structs.
+///
+/// Field names are cached per type, so after the first value of a type, no field name is converted again.
+/// Strings are copied once, into Slint's buffer. Slint clones each value it's given, so there's still a box per field.
+/// A nested struct is built on its own, then wrapped in a value once, and Slint's clone of that value is its one copy.
+/// Arrays aren't supported yet.
+public struct SlintStructEncoder {
+    /// Cache field names between values. Only turned off to measure what the cache saves.
+    var cachesFieldNames = true
+
+    public init() { }
+
+    /// Encode a value into a new struct.
+    public func encode<T: Encodable>(_ value: T) throws -> SlintStruct {
+        let target = SlintStruct()
+        try encode(value, into: target)
+        return target
+    }
+
+    /// Encode a value into an existing struct, overwriting fields it already has. Saves making a struct per value.
+    public func encode<T: Encodable>(_ value: T, into target: SlintStruct) throws {
+        let encoder = _SlintStructEncoder(T.self, codingPath: [], cachesFieldNames: cachesFieldNames, target: target)
+        try value.encode(to: encoder)
+        guard case .struct = try encoder.finish() else {
+            throw EncodingError.invalidValue(value, .init(codingPath: [], debugDescription: "\(T.self) doesn't encode as a struct."))
+        }
+    }
+}
+
+/// Decodes `Decodable` values from interpreter structs.
+///
+/// Field names are cached per type, like `SlintStructEncoder`. Fields of type `SharedString` are retained, not copied.
+public struct SlintStructDecoder {
+    /// Cache field names between values. Only turned off to measure what the cache saves.
+    var cachesFieldNames = true
+
+    public init() { }
+
+    public func decode<T: Decodable>(_ type: T.Type, from source: SlintStruct) throws -> T {
+        try withExtendedLifetime(source) {
+            let decoder = _SlintStructDecoder(T.self, codingPath: [], cachesFieldNames: cachesFieldNames, source: .struct(source.handle))
+            let value = try T(from: decoder)
+            decoder.finish()
+            return value
+        }
+    }
+}
+
+// MARK: - Field names
+
+/// Which type, and which direction. A custom `Codable` conformance might not decode in the order it encodes.
+struct FieldOrderKey: Hashable {
+    let type: ObjectIdentifier
+    let decoding: Bool
+}
+
+/// The order each type visits its fields in, as interned slices.
+enum FieldOrders {
+    private static let lock = NSLock()
+    private static var orders: [FieldOrderKey: [InternedStrSlice]] = [:]
+
+    static func order(for key: FieldOrderKey) -> [InternedStrSlice] {
+        lock.lock()
+        defer { lock.unlock() }
+        return orders[key] ?? []
+    }
+
+    static func record(_ order: [InternedStrSlice], for key: FieldOrderKey) {
+        lock.lock()
+        defer { lock.unlock() }
+        orders[key] = order
+    }
+}
+
+/// Finds the slice for each field name, while one value is encoded or decoded.
+///
+/// `Codable` conformances visit fields in the same order every time. So this walks the recorded order,
+/// and each field costs one string comparison, with no hashing or locking. Fields a value skips, like `nil` optionals,
+/// are stepped over. A name that isn't in the recorded order gets interned, and the order is recorded again.
+struct FieldNameCursor {
+    private let key: FieldOrderKey
+    private let recorded: [InternedStrSlice]
+    private var position = 0
+    /// The last name looked up. `decodeIfPresent` asks for the same one up to three times.
+    private var last: InternedStrSlice?
+    /// Only made when a name is missing from the recorded order.
+    private var learned: [InternedStrSlice]?
+
+    init(_ key: FieldOrderKey) {
+        self.key = key
+        recorded = FieldOrders.order(for: key)
+    }
+
+    mutating func slice(for name: String) -> StrSlice {
+        if let last, last.name == name { return last.slice }
+
+        var index = position
+        while index < recorded.count {
+            if recorded[index].name == name {
+                learned?.append(contentsOf: recorded[position ... index])
+                position = index + 1
+                last = recorded[index]
+                return recorded[index].slice
+            }
+            index += 1
+        }
+
+        if learned == nil { learned = Array(recorded[..<position]) }
+        let interned = InternedStrSlice.intern(name)
+        learned!.append(interned)
+        last = interned
+        return interned.slice
+    }
+
+    /// Record the order, if it changed.
+    func finish() {
+        guard var learned else { return }
+        learned.append(contentsOf: recorded[position...])
+        FieldOrders.record(learned, for: key)
+    }
+}
+
+// MARK: - Encoding
+
+final class _SlintStructEncoder: Encoder {
+    let codingPath: [CodingKey]
+    var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+    private let cachesFieldNames: Bool
+    private var fieldNames: FieldNameCursor?
+
+    /// Where keyed containers write. Made on first use, unless one was passed in.
+    fileprivate var target: SlintStruct?
+    /// Set if the value encoded as a single value, rather than a struct.
+    fileprivate var single: SlintValue?
+    /// Nested containers and super encoders. Slint copies what it's given, so they're set once they're done.
+    fileprivate var pending: [(name: String, encoder: _SlintStructEncoder)] = []
+
+    init(_ type: Any.Type, codingPath: [CodingKey], cachesFieldNames: Bool, target: SlintStruct? = nil) {
+        self.codingPath = codingPath
+        self.cachesFieldNames = cachesFieldNames
+        self.target = target
+        if cachesFieldNames { fieldNames = FieldNameCursor(FieldOrderKey(type: ObjectIdentifier(type), decoding: false)) }
+    }
+
+    /// Calls the given closure with the slice for a field name.
+    fileprivate func withFieldName<R>(_ name: String, _ body: (StrSlice) throws -> R) rethrows -> R {
+        if cachesFieldNames {
+            return try body(fieldNames!.slice(for: name))
+        }
+        // What converting every name costs.
+        return try name.utf8CString.withUnsafeBufferPointer { chars in
+            var slice = StrSlice()
+            slice.ptr = UnsafeMutableRawPointer(mutating: chars.baseAddress!).assumingMemoryBound(to: UInt8.self)
+            slice.len = UInt(chars.count - 1)
+            return try body(slice)
+        }
+    }
+
+    fileprivate func makeTarget() -> SlintStruct {
+        if let target { return target }
+        let made = SlintStruct()
+        target = made
+        return made
+    }
+
+    /// Encode a nested value.
+    fileprivate func encodeNested<T: Encodable>(_ value: T, at key: CodingKey) throws -> SlintValue {
+        switch value {
+        case let value as SlintValue: return value
+        case let value as SharedString: return .string(value)
+        case let value as SlintStruct: return .struct(value)
+        default:
+            let nested = _SlintStructEncoder(T.self, codingPath: codingPath + [key], cachesFieldNames: cachesFieldNames)
+            try value.encode(to: nested)
+            return try nested.finish()
+        }
+    }
+
+    /// Set any pending fields, and record the field order. Returns what was encoded.
+    func finish() throws -> SlintValue {
+        fieldNames?.finish()
+
+        if let single {
+            guard target == nil, pending.isEmpty else {
+                throw EncodingError.invalidValue(single, .init(codingPath: codingPath, debugDescription: "Encoded both a single value and fields."))
+            }
+            return single
+        }
+
+        let target = makeTarget()
+        for (name, encoder) in pending {
+            let value = try encoder.finish()
+            name.withStrSlice { target.setField($0, value) }
+        }
+        pending.removeAll()
+        return .struct(target)
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) -> KeyedEncodingContainer<Key> {
+        KeyedEncodingContainer(KeyedContainer(encoder: self, target: makeTarget()))
+    }
+
+    func unkeyedContainer() -> UnkeyedEncodingContainer {
+        UnsupportedUnkeyedContainer(codingPath: codingPath)
+    }
+
+    func singleValueContainer() -> SingleValueEncodingContainer {
+        SingleValueContainer(encoder: self)
+    }
+
+    struct KeyedContainer<Key: CodingKey>: KeyedEncodingContainerProtocol {
+        let encoder: _SlintStructEncoder
+        let target: SlintStruct
+        var codingPath: [CodingKey] { encoder.codingPath }
+
+        /// Set a field to a new box, then free it. Slint keeps a copy.
+        private func set(_ key: Key, _ box: OpaquePointer) {
+            defer { slint_interpreter_value_destructor(box) }
+            encoder.withFieldName(key.stringValue) { target.setField($0, value: box) }
+        }
+
+        private func setNumber(_ number: Double, _ key: Key) {
+            set(key, slint_interpreter_value_new_double(number))
+        }
+
+        mutating func encodeNil(forKey key: Key) throws { set(key, slint_interpreter_value_new()) }
+        mutating func encode(_ value: Bool, forKey key: Key) throws { set(key, slint_interpreter_value_new_bool(value)) }
+        mutating func encode(_ value: String, forKey key: Key) throws {
+            let string = SharedString(value)
+            set(key, withUnsafePointer(to: string) { slint_interpreter_value_new_string($0) })
+        }
+        mutating func encode(_ value: Double, forKey key: Key) throws { setNumber(value, key) }
+        mutating func encode(_ value: Float, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: Int, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: Int8, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: Int16, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: Int32, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: Int64, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: UInt, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: UInt8, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: UInt16, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: UInt32, forKey key: Key) throws { setNumber(Double(value), key) }
+        mutating func encode(_ value: UInt64, forKey key: Key) throws { setNumber(Double(value), key) }
+
+        mutating func encode<T: Encodable>(_ value: T, forKey key: Key) throws {
+            let nested = try encoder.encodeNested(value, at: key)
+            encoder.withFieldName(key.stringValue) { target.setField($0, nested) }
+        }
+
+        mutating func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type, forKey key: Key) -> KeyedEncodingContainer<NestedKey> {
+            nestedEncoder(key.stringValue, key).container(keyedBy: keyType)
+        }
+
+        mutating func nestedUnkeyedContainer(forKey key: Key) -> UnkeyedEncodingContainer {
+            UnsupportedUnkeyedContainer(codingPath: codingPath + [key])
+        }
+
+        mutating func superEncoder() -> Encoder {
+            nestedEncoder("super", nil)
+        }
+
+        mutating func superEncoder(forKey key: Key) -> Encoder {
+            nestedEncoder(key.stringValue, key)
+        }
+
+        private func nestedEncoder(_ name: String, _ key: Key?) -> _SlintStructEncoder {
+            let nested = _SlintStructEncoder(Key.self, codingPath: codingPath + (key.map { [$0] } ?? []), cachesFieldNames: encoder.cachesFieldNames)
+            encoder.pending.append((name, nested))
+            return nested
+        }
+    }
+
+    struct SingleValueContainer: SingleValueEncodingContainer {
+        let encoder: _SlintStructEncoder
+        var codingPath: [CodingKey] { encoder.codingPath }
+
+        mutating func encodeNil() throws { encoder.single = .void }
+        mutating func encode(_ value: Bool) throws { encoder.single = .bool(value) }
+        mutating func encode(_ value: String) throws { encoder.single = .string(SharedString(value)) }
+        mutating func encode(_ value: Double) throws { encoder.single = .number(value) }
+        mutating func encode(_ value: Float) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: Int) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: Int8) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: Int16) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: Int32) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: Int64) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: UInt) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: UInt8) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: UInt16) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: UInt32) throws { encoder.single = .number(Double(value)) }
+        mutating func encode(_ value: UInt64) throws { encoder.single = .number(Double(value)) }
+
+        mutating func encode<T: Encodable>(_ value: T) throws {
+            switch value {
+            case let value as SlintValue: encoder.single = value
+            case let value as SharedString: encoder.single = .string(value)
+            case let value as SlintStruct: encoder.single = .struct(value)
+            // Same encoder, so a wrapper type encodes as whatever it wraps.
+            default: try value.encode(to: encoder)
+            }
+        }
+    }
+
+    /// Slint's arrays are models, which aren't wrapped yet.
+    struct UnsupportedUnkeyedContainer: UnkeyedEncodingContainer {
+        let codingPath: [CodingKey]
+        var count: Int { 0 }
+
+        private func unsupported(_ value: Any) -> EncodingError {
+            EncodingError.invalidValue(value, .init(codingPath: codingPath, debugDescription: "Arrays aren't supported by SlintStructEncoder yet."))
+        }
+
+        mutating func encodeNil() throws { throw unsupported(()) }
+        mutating func encode<T: Encodable>(_ value: T) throws { throw unsupported(value) }
+
+        mutating func nestedContainer<NestedKey: CodingKey>(keyedBy keyType: NestedKey.Type) -> KeyedEncodingContainer<NestedKey> {
+            _SlintStructEncoder(NestedKey.self, codingPath: codingPath, cachesFieldNames: false).container(keyedBy: keyType)
+        }
+
+        mutating func nestedUnkeyedContainer() -> UnkeyedEncodingContainer { self }
+
+        mutating func superEncoder() -> Encoder {
+            _SlintStructEncoder(Void.self, codingPath: codingPath, cachesFieldNames: false)
+        }
+    }
+}
+
+// MARK: - Decoding
+
+final class _SlintStructDecoder: Decoder {
+    /// What's being decoded. Borrowed, so the owner must outlive decoding.
+    enum Source {
+        case `struct`(UnsafePointer<StructOpaque>)
+        case value(OpaquePointer)
+    }
+
+    let codingPath: [CodingKey]
+    var userInfo: [CodingUserInfoKey: Any] { [:] }
+
+    private let cachesFieldNames: Bool
+    private var fieldNames: FieldNameCursor?
+    private let source: Source
+    /// Keeps the source alive, for decoders that outlive the call that made them.
+    fileprivate var owner: AnyObject?
+
+    init(_ type: Any.Type, codingPath: [CodingKey], cachesFieldNames: Bool, source: Source) {
+        self.codingPath = codingPath
+        self.cachesFieldNames = cachesFieldNames
+        self.source = source
+        if cachesFieldNames { fieldNames = FieldNameCursor(FieldOrderKey(type: ObjectIdentifier(type), decoding: true)) }
+    }
+
+    /// Record the field order, if it changed.
+    func finish() {
+        fieldNames?.finish()
+    }
+
+    fileprivate func withFieldName<R>(_ name: String, _ body: (StrSlice) throws -> R) rethrows -> R {
+        if cachesFieldNames {
+            return try body(fieldNames!.slice(for: name))
+        }
+        return try name.utf8CString.withUnsafeBufferPointer { chars in
+            var slice = StrSlice()
+            slice.ptr = UnsafeMutableRawPointer(mutating: chars.baseAddress!).assumingMemoryBound(to: UInt8.self)
+            slice.len = UInt(chars.count - 1)
+            return try body(slice)
+        }
+    }
+
+    private func mismatch(_ type: Any.Type, _ description: String) -> DecodingError {
+        DecodingError.typeMismatch(type, .init(codingPath: codingPath, debugDescription: description))
+    }
+
+    func container<Key: CodingKey>(keyedBy type: Key.Type) throws -> KeyedDecodingContainer<Key> {
+        switch source {
+        case .struct(let pointer):
+            return KeyedDecodingContainer(KeyedContainer(decoder: self, source: pointer))
+        case .value(let value):
+            guard let pointer = slint_interpreter_value_to_struct(value) else {
+                throw mismatch(Key.self, "Expected a struct, but found \(slint_interpreter_value_type(value)).")
+            }
+            return KeyedDecodingContainer(KeyedContainer(decoder: self, source: pointer))
+        }
+    }
+
+    func unkeyedContainer() throws -> UnkeyedDecodingContainer {
+        throw mismatch([Any].self, "Arrays aren't supported by SlintStructDecoder yet.")
+    }
+
+    func singleValueContainer() throws -> SingleValueDecodingContainer {
+        guard case .value(let value) = source else {
+            throw mismatch(Any.self, "Expected a single value, but found a struct.")
+        }
+        return SingleValueContainer(decoder: self, value: value)
+    }
+
+    // MARK: Reading values
+
+    fileprivate func decodeBool(_ value: OpaquePointer) throws -> Bool {
+        guard let bool = slint_interpreter_value_to_bool(value) else {
+            throw mismatch(Bool.self, "Expected a bool, but found \(slint_interpreter_value_type(value)).")
+        }
+        return bool.pointee
+    }
+
+    fileprivate func decodeNumber(_ value: OpaquePointer) throws -> Double {
+        guard let number = slint_interpreter_value_to_number(value) else {
+            throw mismatch(Double.self, "Expected a number, but found \(slint_interpreter_value_type(value)).")
+        }
+        return number.pointee
+    }
+
+    /// Slint converts numbers to integers by truncating, so this does too.
+    fileprivate func decodeInteger<I: BinaryInteger>(_ value: OpaquePointer) throws -> I {
+        let number = try decodeNumber(value)
+        guard let integer = I(exactly: number.rounded(.towardZero)) else {
+            throw DecodingError.dataCorrupted(.init(codingPath: codingPath, debugDescription: "\(number) doesn't fit in \(I.self)."))
+        }
+        return integer
+    }
+
+    fileprivate func decodeSharedString(_ value: OpaquePointer) throws -> SharedString {
+        guard let string = slint_interpreter_value_to_string(value) else {
+            throw mismatch(String.self, "Expected a string, but found \(slint_interpreter_value_type(value)).")
+        }
+        return string.pointee
+    }
+
+    fileprivate func decodeNested<T: Decodable>(_ type: T.Type, _ value: OpaquePointer, at key: CodingKey?) throws -> T {
+        if T.self == SharedString.self { return try decodeSharedString(value) as! T }
+        if T.self == SlintValue.self { return SlintValue(copying: value) as! T }
+        if T.self == SlintStruct.self {
+            guard let pointer = slint_interpreter_value_to_struct(value) else {
+                throw mismatch(T.self, "Expected a struct, but found \(slint_interpreter_value_type(value)).")
+            }
+            return SlintStruct(copying: pointer) as! T
+        }
+
+        let nested = _SlintStructDecoder(T.self, codingPath: codingPath + (key.map { [$0] } ?? []), cachesFieldNames: cachesFieldNames, source: .value(value))
+        let decoded = try T(from: nested)
+        nested.finish()
+        return decoded
+    }
+
+    struct KeyedContainer<Key: CodingKey>: KeyedDecodingContainerProtocol {
+        let decoder: _SlintStructDecoder
+        let source: UnsafePointer<StructOpaque>
+        var codingPath: [CodingKey] { decoder.codingPath }
+
+        var allKeys: [Key] {
+            var iterator = slint_interpreter_struct_make_iter(source)
+            defer { slint_interpreter_struct_iterator_destructor(&iterator) }
+
+            var keys: [Key] = []
+            var name = StrSlice()
+            while let box = slint_interpreter_struct_iterator_next(&iterator, &name) {
+                slint_interpreter_value_destructor(box)
+                let bytes = UnsafeBufferPointer(start: name.ptr, count: Int(name.len))
+                if let key = Key(stringValue: String(decoding: bytes, as: UTF8.self)) { keys.append(key) }
+            }
+            return keys
+        }
+
+        /// Slint hands back a copy of the field, which is freed after `body`.
+        private func field(_ key: Key) -> OpaquePointer? {
+            decoder.withFieldName(key.stringValue) { slint_interpreter_struct_get_field(source, $0) }
+        }
+
+        private func withField<R>(_ key: Key, _ body: (OpaquePointer) throws -> R) throws -> R {
+            guard let box = field(key) else {
+                throw DecodingError.keyNotFound(key, .init(codingPath: codingPath, debugDescription: "No field named \(key.stringValue)."))
+            }
+            defer { slint_interpreter_value_destructor(box) }
+            return try body(box)
+        }
+
+        func contains(_ key: Key) -> Bool {
+            guard let box = field(key) else { return false }
+            slint_interpreter_value_destructor(box)
+            return true
+        }
+
+        func decodeNil(forKey key: Key) throws -> Bool {
+            guard let box = field(key) else { return true }
+            defer { slint_interpreter_value_destructor(box) }
+            return slint_interpreter_value_type(box) == .Void
+        }
+
+        func decode(_ type: Bool.Type, forKey key: Key) throws -> Bool { try withField(key, decoder.decodeBool) }
+        func decode(_ type: String.Type, forKey key: Key) throws -> String { try withField(key) { try decoder.decodeSharedString($0).string } }
+        func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try withField(key, decoder.decodeNumber) }
+        func decode(_ type: Float.Type, forKey key: Key) throws -> Float { Float(try withField(key, decoder.decodeNumber)) }
+        func decode(_ type: Int.Type, forKey key: Key) throws -> Int { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: Int8.Type, forKey key: Key) throws -> Int8 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: Int16.Type, forKey key: Key) throws -> Int16 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: Int32.Type, forKey key: Key) throws -> Int32 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: Int64.Type, forKey key: Key) throws -> Int64 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: UInt.Type, forKey key: Key) throws -> UInt { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: UInt8.Type, forKey key: Key) throws -> UInt8 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try withField(key, decoder.decodeInteger) }
+        func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try withField(key, decoder.decodeInteger) }
+
+        func decode<T: Decodable>(_ type: T.Type, forKey key: Key) throws -> T {
+            try withField(key) { try decoder.decodeNested(type, $0, at: key) }
+        }
+
+        func nestedContainer<NestedKey: CodingKey>(keyedBy type: NestedKey.Type, forKey key: Key) throws -> KeyedDecodingContainer<NestedKey> {
+            // The container borrows the struct, so it has to be one Swift owns.
+            let nested = try decode(SlintStruct.self, forKey: key)
+            return try SlintStructDecoder.retaining(nested, codingPath: codingPath + [key]).container(keyedBy: type)
+        }
+
+        func nestedUnkeyedContainer(forKey key: Key) throws -> UnkeyedDecodingContainer {
+            try decoder.unkeyedContainer()
+        }
+
+        func superDecoder() throws -> Decoder {
+            try superDecoder(named: "super", codingPath: codingPath)
+        }
+
+        func superDecoder(forKey key: Key) throws -> Decoder {
+            try superDecoder(named: key.stringValue, codingPath: codingPath + [key])
+        }
+
+        private func superDecoder(named name: String, codingPath: [CodingKey]) throws -> Decoder {
+            guard let value = name.withStrSlice({ slint_interpreter_struct_get_field(source, $0) }) else {
+                return SlintStructDecoder.retaining(SlintStruct(), codingPath: codingPath)
+            }
+            return SlintStructDecoder.retaining(SlintValueBox(owning: value), codingPath: codingPath)
+        }
+    }
+
+    struct SingleValueContainer: SingleValueDecodingContainer {
+        let decoder: _SlintStructDecoder
+        let value: OpaquePointer
+        var codingPath: [CodingKey] { decoder.codingPath }
+
+        func decodeNil() -> Bool { slint_interpreter_value_type(value) == .Void }
+        func decode(_ type: Bool.Type) throws -> Bool { try decoder.decodeBool(value) }
+        func decode(_ type: String.Type) throws -> String { try decoder.decodeSharedString(value).string }
+        func decode(_ type: Double.Type) throws -> Double { try decoder.decodeNumber(value) }
+        func decode(_ type: Float.Type) throws -> Float { Float(try decoder.decodeNumber(value)) }
+        func decode(_ type: Int.Type) throws -> Int { try decoder.decodeInteger(value) }
+        func decode(_ type: Int8.Type) throws -> Int8 { try decoder.decodeInteger(value) }
+        func decode(_ type: Int16.Type) throws -> Int16 { try decoder.decodeInteger(value) }
+        func decode(_ type: Int32.Type) throws -> Int32 { try decoder.decodeInteger(value) }
+        func decode(_ type: Int64.Type) throws -> Int64 { try decoder.decodeInteger(value) }
+        func decode(_ type: UInt.Type) throws -> UInt { try decoder.decodeInteger(value) }
+        func decode(_ type: UInt8.Type) throws -> UInt8 { try decoder.decodeInteger(value) }
+        func decode(_ type: UInt16.Type) throws -> UInt16 { try decoder.decodeInteger(value) }
+        func decode(_ type: UInt32.Type) throws -> UInt32 { try decoder.decodeInteger(value) }
+        func decode(_ type: UInt64.Type) throws -> UInt64 { try decoder.decodeInteger(value) }
+
+        func decode<T: Decodable>(_ type: T.Type) throws -> T {
+            try decoder.decodeNested(type, value, at: nil)
+        }
+    }
+}
+
+extension SlintStructDecoder {
+    /// A decoder over something Swift owns, that keeps it alive. For containers that outlive the call that made them.
+    /// These are rare, and have no type to key an order on, so they don't cache field names.
+    fileprivate static func retaining(_ owner: SlintStruct, codingPath: [CodingKey]) -> _SlintStructDecoder {
+        let decoder = _SlintStructDecoder(Void.self, codingPath: codingPath, cachesFieldNames: false, source: .struct(owner.handle))
+        decoder.owner = owner
+        return decoder
+    }
+
+    fileprivate static func retaining(_ owner: SlintValueBox, codingPath: [CodingKey]) -> _SlintStructDecoder {
+        let decoder = _SlintStructDecoder(Void.self, codingPath: codingPath, cachesFieldNames: false, source: .value(owner.handle))
+        decoder.owner = owner
+        return decoder
+    }
+}
+
+/// So `Codable` types can hold Slint strings. Slint's coders pass them straight through, other coders see a `String`.
+extension SharedString: Codable {
+    public init(from decoder: Decoder) throws {
+        self.init(try decoder.singleValueContainer().decode(String.self))
+    }
+
+    public func encode(to encoder: Encoder) throws {
+        var container = encoder.singleValueContainer()
+        try container.encode(string)
+    }
+}
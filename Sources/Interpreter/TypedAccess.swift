@@ -0,0 +1,227 @@
+//
+//  TypedAccess.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A property, callback or global's name, encoded once, as UTF-8 in the binary's static strings.
+///
+/// Accessors generated by `SlintCodegen` keep one per name, so using a property doesn't encode its name again,
+/// the way passing a `String` does.
+public struct SlintName {
+    public let name: StaticString
+    let slice: StrSlice
+
+    public init(_ name: StaticString) {
+        precondition(name.hasPointerRepresentation, "Slint names must be string literals!")
+        self.name = name
+        var slice = StrSlice()
+        slice.ptr = UnsafeMutablePointer(mutating: name.utf8Start)
+        slice.len = UInt(name.utf8CodeUnitCount)
+        self.slice = slice
+    }
+}
+
+/// A Swift type that converts straight to and from interpreter values, without going through `SlintValue`.
+///
+/// Typed accessors call these on the concrete type, so there's no switch over what a value might hold.
+public protocol SlintValueRepresentable {
+    /// Make a new interpreter value. The caller owns it.
+    func makeValueBox() -> OpaquePointer
+
+    /// Read an interpreter value, without taking it. `nil` if it holds another type.
+    init?(borrowingValue value: OpaquePointer)
+
+    /// The same, as a `SlintValue`. Only used for writes held by a batch.
+    var slintValue: SlintValue { get }
+}
+
+extension Double: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { slint_interpreter_value_new_double(self) }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let number = slint_interpreter_value_to_number(value) else { return nil }
+        self = number.pointee
+    }
+    public var slintValue: SlintValue { .number(self) }
+}
+
+extension Float: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { slint_interpreter_value_new_double(Double(self)) }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let number = slint_interpreter_value_to_number(value) else { return nil }
+        self = Float(number.pointee)
+    }
+    public var slintValue: SlintValue { .number(Double(self)) }
+}
+
+/// Slint's `int` is a number. Reading one truncates, like Slint does.
+extension Int: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { slint_interpreter_value_new_double(Double(self)) }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let number = slint_interpreter_value_to_number(value) else { return nil }
+        self = Int(number.pointee.rounded(.towardZero))
+    }
+    public var slintValue: SlintValue { .number(Double(self)) }
+}
+
+extension Bool: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { slint_interpreter_value_new_bool(self) }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let bool = slint_interpreter_value_to_bool(value) else { return nil }
+        self = bool.pointee
+    }
+    public var slintValue: SlintValue { .bool(self) }
+}
+
+extension SharedString: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { withUnsafePointer(to: self) { slint_interpreter_value_new_string($0) } }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let string = slint_interpreter_value_to_string(value) else { return nil }
+        self = string.pointee
+    }
+    public var slintValue: SlintValue { .string(self) }
+}
+
+/// Converted through `SharedString`, so each read and write copies the bytes once.
+extension String: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { SharedString(self).makeValueBox() }
+    public init?(borrowingValue value: OpaquePointer) {
+        guard let string = SharedString(borrowingValue: value) else { return nil }
+        self = string.string
+    }
+    public var slintValue: SlintValue { .string(SharedString(self)) }
+}
+
+extension SlintStruct: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { withExtendedLifetime(self) { slint_interpreter_value_new_struct(handle) } }
+    public convenience init?(borrowingValue value: OpaquePointer) {
+        guard let value = slint_interpreter_value_to_struct(value) else { return nil }
+        self.init(copying: value)
+    }
+    public var slintValue: SlintValue { .struct(self) }
+}
+
+/// For types without a path of their own: models, brushes, images.
+extension SlintValue: SlintValueRepresentable {
+    public func makeValueBox() -> OpaquePointer { makeBox() }
+    public init?(borrowingValue value: OpaquePointer) { self.init(copying: value) }
+    public var slintValue: SlintValue { self }
+}
+
+// MARK: - Typed access
+
+extension SlintComponentInstance {
+    /// Read a property as `T`. `nil` if there's no such property, or it isn't a `T`.
+    public func get<T: SlintValueRepresentable>(_ name: SlintName, as type: T.Type = T.self) -> T? {
+        guard let box = slint_interpreter_component_instance_get_property(erased, name.slice) else { return nil }
+        defer { slint_interpreter_value_destructor(box) }
+        return T(borrowingValue: box)
+    }
+
+    /// Set a property. In `Slint.batch`, it's held until the batch ends, like `setProperty(_:_:)`.
+    /// - Returns: False if there's no such property, or it isn't a `T`.
+    @discardableResult
+    public func set<T: SlintValueRepresentable>(_ name: SlintName, _ value: T) -> Bool {
+        guard !PropertyBatch.isOpen else {
+            PropertyBatch.stage(StagedInstanceWrite(self, name.name.description, value.slintValue))
+            return true
+        }
+        let box = value.makeValueBox()
+        defer { slint_interpreter_value_destructor(box) }
+        return slint_interpreter_component_instance_set_property(erased, name.slice, box)
+    }
+
+    /// Read a global's property as `T`. `nil` if there's no such global or property, or it isn't a `T`.
+    public func get<T: SlintValueRepresentable>(_ global: SlintName, _ name: SlintName, as type: T.Type = T.self) -> T? {
+        guard let box = slint_interpreter_component_instance_get_global_property(erased, global.slice, name.slice) else { return nil }
+        defer { slint_interpreter_value_destructor(box) }
+        return T(borrowingValue: box)
+    }
+
+    /// Set a global's property, now. Batches only hold component properties.
+    /// - Returns: False if there's no such global or property, or it isn't a `T`.
+    @discardableResult
+    public func set<T: SlintValueRepresentable>(_ global: SlintName, _ name: SlintName, _ value: T) -> Bool {
+        let box = value.makeValueBox()
+        defer { slint_interpreter_value_destructor(box) }
+        return slint_interpreter_component_instance_set_global_property(erased, global.slice, name.slice, box)
+    }
+
+    /// Invoke a callback or function. `nil` if there's no such callback, or the arguments don't match.
+    @discardableResult
+    public func invoke(_ name: SlintName, _ arguments: [SlintValue] = []) -> SlintValue? {
+        withValueSlice(arguments) { slint_interpreter_component_instance_invoke(erased, name.slice, $0) }
+    }
+
+    /// Invoke a global's callback or function. `nil` if there's no such global or callback, or the arguments don't match.
+    @discardableResult
+    public func invoke(_ global: SlintName, _ name: SlintName, _ arguments: [SlintValue] = []) -> SlintValue? {
+        withValueSlice(arguments) { slint_interpreter_component_instance_invoke_global(erased, global.slice, name.slice, $0) }
+    }
+
+    /// Handle a callback. Replaces any handler already set.
+    /// - Returns: False if there's no such callback.
+    @discardableResult
+    public func setCallback(_ name: SlintName, _ handler: @escaping @SlintActor ([SlintValue]) -> SlintValue) -> Bool {
+        // If there's no such callback, Slint calls `drop` itself, like the C++ `ComponentInstance::set_callback` expects.
+        slint_interpreter_component_instance_set_callback(
+            erased, name.slice,
+            InterpreterCallbackTrampoline.callback, InterpreterCallbackTrampoline(handler).retainedPointer(), InterpreterCallbackTrampoline.drop
+        )
+    }
+
+    /// Handle a global's callback. Replaces any handler already set.
+    /// - Returns: False if there's no such global or callback.
+    @discardableResult
+    public func setCallback(_ global: SlintName, _ name: SlintName, _ handler: @escaping @SlintActor ([SlintValue]) -> SlintValue) -> Bool {
+        // Slint drops the handler if there's no such global or callback.
+        slint_interpreter_component_instance_set_global_callback(
+            erased, global.slice, name.slice,
+            InterpreterCallbackTrampoline.callback, InterpreterCallbackTrampoline(handler).retainedPointer(), InterpreterCallbackTrampoline.drop
+        )
+    }
+
+    /// Box the arguments, as a slice Slint can read, for the length of `body`. The result is taken, if there is one.
+    private func withValueSlice(_ arguments: [SlintValue], _ body: (ValueSlice) -> OpaquePointer?) -> SlintValue? {
+        var boxes = arguments.map { $0.makeBox() }
+        defer { boxes.forEach { slint_interpreter_value_destructor($0) } }
+
+        let result = boxes.withUnsafeMutableBufferPointer { buffer in
+            var slice = ValueSlice()
+            slice.ptr = buffer.baseAddress ?? noArguments
+            slice.len = UInt(buffer.count)
+            return body(slice)
+        }
+        return result.map { SlintValue(consuming: $0) }
+    }
+}
+
+/// Stands in for the arguments of a call without any. Slint's slices are Rust slices, which must never have a null pointer.
+private let noArguments = UnsafeMutablePointer<OpaquePointer>.allocate(capacity: 1)
+
+/// Handler for an interpreter callback. Slint owns it, through a retained pointer that `drop` releases, even if it wasn't set.
+private final class InterpreterCallbackTrampoline {
+    let handler: @SlintActor ([SlintValue]) -> SlintValue
+
+    init(_ handler: @escaping @SlintActor ([SlintValue]) -> SlintValue) {
+        self.handler = handler
+    }
+
+    func retainedPointer() -> UnsafeMutableRawPointer {
+        Unmanaged.passRetained(self).toOpaque()
+    }
+
+    /// Arguments are borrowed. The result is Slint's.
+    static let callback: @convention(c) (UnsafeMutableRawPointer?, ValueSlice) -> OpaquePointer? = { userData, arguments in
+        let trampoline = Unmanaged<InterpreterCallbackTrampoline>.fromOpaque(userData!).takeUnretainedValue()
+        let values = UnsafeBufferPointer(start: arguments.ptr, count: Int(arguments.len)).map { SlintValue(copying: $0) }
+        // Slint only invokes callbacks on the event loop thread. Same as `WrappedClosure.invokeCallback`.
+        let result = traced(.callback) { SlintActor.assumeIsolated { trampoline.handler(values) } }
+        return result.makeBox()
+    }
+
+    static let drop: @convention(c) (UnsafeMutableRawPointer?) -> Void = { userData in
+        Unmanaged<InterpreterCallbackTrampoline>.fromOpaque(userData!).release()
+    }
+}
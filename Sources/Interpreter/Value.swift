@@ -0,0 +1,135 @@
+//
+//  Value.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A value going to, or coming from, Slint's interpreter.
+///
+/// Numbers and booleans are copied out. Strings are Slint's own, so reading one only retains it.
+/// Anything Swift doesn't have a case for yet (models, brushes, images) stays boxed, untouched.
+public enum SlintValue {
+    case void
+    case number(Double)
+    case string(SharedString)
+    case bool(Bool)
+    case `struct`(SlintStruct)
+    case other(SlintValueBox)
+}
+
+/// An interpreter value Swift doesn't look inside. Owns its box.
+public final class SlintValueBox {
+    /// `Box<Value>`.
+    let handle: OpaquePointer
+
+    /// Take ownership of a box.
+    init(owning handle: OpaquePointer) {
+        self.handle = handle
+    }
+
+    deinit {
+        slint_interpreter_value_destructor(handle)
+    }
+
+    /// What the value is.
+    public var type: ValueType { slint_interpreter_value_type(handle) }
+}
+
+// MARK: Reading
+
+extension SlintValue {
+    /// Read an interpreter value. Doesn't take ownership of it.
+    /// - Parameter value: Pointer to the value. Only borrowed.
+    init(copying value: OpaquePointer) {
+        switch slint_interpreter_value_type(value) {
+        case .Void:
+            self = .void
+        case .Number:
+            self = .number(slint_interpreter_value_to_number(value).pointee)
+        case .String:
+            self = .string(slint_interpreter_value_to_string(value).pointee)
+        case .Bool:
+            self = .bool(slint_interpreter_value_to_bool(value).pointee)
+        case .Struct:
+            self = .struct(SlintStruct(copying: slint_interpreter_value_to_struct(value)))
+        default:
+            self = .other(SlintValueBox(owning: slint_interpreter_value_clone(value)))
+        }
+    }
+
+    /// Read an interpreter value, and take ownership of its box.
+    /// - Parameter box: A box the caller owns, like the ones `get_field` returns. Freed, unless it's kept as `.other`.
+    init(consuming box: OpaquePointer) {
+        switch slint_interpreter_value_type(box) {
+        case .Void, .Number, .String, .Bool, .Struct:
+            self.init(copying: box)
+            slint_interpreter_value_destructor(box)
+        default:
+            self = .other(SlintValueBox(owning: box))
+        }
+    }
+
+    public var number: Double? {
+        if case .number(let number) = self { return number }
+        return nil
+    }
+
+    public var string: SharedString? {
+        if case .string(let string) = self { return string }
+        return nil
+    }
+
+    public var bool: Bool? {
+        if case .bool(let bool) = self { return bool }
+        return nil
+    }
+
+    public var `struct`: SlintStruct? {
+        if case .struct(let value) = self { return value }
+        return nil
+    }
+}
+
+// MARK: Writing
+
+extension SlintValue {
+    /// Make a new interpreter value. The caller owns it, and must free it with `slint_interpreter_value_destructor`.
+    func makeBox() -> OpaquePointer {
+        switch self {
+        case .void:
+            return slint_interpreter_value_new()
+        case .number(let number):
+            return slint_interpreter_value_new_double(number)
+        case .string(let string):
+            return withUnsafePointer(to: string) { slint_interpreter_value_new_string($0) }
+        case .bool(let bool):
+            return slint_interpreter_value_new_bool(bool)
+        case .struct(let value):
+            return withExtendedLifetime(value) { slint_interpreter_value_new_struct(value.handle) }
+        case .other(let box):
+            return slint_interpreter_value_clone(box.handle)
+        }
+    }
+
+    /// Calls the given closure with a pointer to an interpreter value holding this one.
+    /// - Parameter body: Closure to run. The pointer is only borrowed, and must not escape it.
+    func withValuePointer<R>(_ body: (OpaquePointer) throws -> R) rethrows -> R {
+        if case .other(let box) = self {
+            return try withExtendedLifetime(box) { try body(box.handle) }
+        }
+
+        let box = makeBox()
+        defer { slint_interpreter_value_destructor(box) }
+        return try body(box)
+    }
+}
+
+// MARK: Literals
+
+extension SlintValue: ExpressibleByFloatLiteral, ExpressibleByIntegerLiteral, ExpressibleByBooleanLiteral, ExpressibleByStringLiteral {
+    public init(floatLiteral value: Double) { self = .number(value) }
+    public init(integerLiteral value: Int) { self = .number(Double(value)) }
+    public init(booleanLiteral value: Bool) { self = .bool(value) }
+    public init(stringLiteral value: String) { self = .string(SharedString.interned(value)) }
+}
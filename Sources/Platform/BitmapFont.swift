@@ -0,0 +1,167 @@
+//
+//  BitmapFont.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A font pre-rendered by `SlintFontBaker`, at a few pixel sizes, for Slint's software renderer.
+///
+/// Registering one skips parsing and rasterizing a TrueType font at runtime. The baked data is already laid out
+/// the way Slint reads it, so making the font only points Slint's structs into it. Text at a size that wasn't baked
+/// uses the closest size that was. Once any bitmap font is registered, the software renderer draws all text with
+/// bitmap fonts, using the first registered if no family matches.
+///
+/// Slint keeps registered fonts for the rest of the process, so a font, and the data it points into, is never freed.
+/// Make each font once, like the `font` that `slint_swift_bake_font` generates, which points into static data.
+public final class SlintBitmapFont: @unchecked Sendable {
+    /// Read only, once made.
+    let font: UnsafeMutablePointer<BitmapFont>
+
+    public let familyName: String
+    /// The sizes that were baked, smallest first.
+    public let pixelSizes: [Int]
+    /// Characters baked at each size.
+    public let characterCount: Int
+
+    /// Use data baked by `SlintFontBaker`, where it is. Its layout is described at the top of `FontBaker/main.cpp`.
+    /// - Parameter baked: Must stay valid, and unchanged, for the rest of the process, like the static data the baker generates.
+    ///   It's only read. Tables have to be 4-byte aligned.
+    ///
+    /// Every offset and length is checked against `baked` before Slint is pointed at it, and so is everything Slint would
+    /// index with, like glyph indices. Data that doesn't fit stops the process, rather than letting Slint read past it.
+    public init(baked: UnsafeRawBufferPointer) {
+        precondition(baked.count >= 52, "Not a font baked by this version of SlintFontBaker!")
+        // Slint's slices are mutable pointers, but it only reads through them.
+        let data = UnsafeMutableRawPointer(mutating: baked.baseAddress!)
+
+        func u32(_ offset: Int) -> Int { Int(UInt32(littleEndian: data.loadUnaligned(fromByteOffset: offset, as: UInt32.self))) }
+        func i16(_ offset: Int) -> Int16 { Int16(littleEndian: data.loadUnaligned(fromByteOffset: offset, as: Int16.self)) }
+        func f32(_ offset: Int) -> Float { Float(bitPattern: UInt32(u32(offset))) }
+        func pointer(_ offset: Int) -> UnsafeMutablePointer<UInt8> { (data + offset).assumingMemoryBound(to: UInt8.self) }
+        /// Stop unless `count` items of `stride` bytes from `offset` are inside the data. Offsets and counts are 32-bit, so this can't overflow.
+        func checkRange(_ offset: Int, _ count: Int, stride: Int = 1, aligned: Bool = false, _ what: StaticString) {
+            precondition(offset <= baked.count && count * stride <= baked.count - offset, "Baked font's \(what) is outside its data!")
+            precondition(!aligned || offset % 4 == 0, "Baked font's \(what) isn't 4-byte aligned!")
+        }
+
+        precondition(
+            baked.prefix(4).elementsEqual("SLBF".utf8) && u32(4) == 1,
+            "Not a font baked by this version of SlintFontBaker!"
+        )
+        precondition(Int(bitPattern: data) % 4 == 0, "Baked font data must be 4-byte aligned")
+
+        font = .allocate(capacity: 1)
+        // Zeroed first, so any fields not set below are off.
+        UnsafeMutableRawPointer(font).initializeMemory(as: UInt8.self, repeating: 0, count: MemoryLayout<BitmapFont>.size)
+        font.pointee.units_per_em = f32(8)
+        font.pointee.ascent = f32(12)
+        font.pointee.descent = f32(16)
+        font.pointee.weight = UInt16(littleEndian: data.loadUnaligned(fromByteOffset: 20, as: UInt16.self))
+        font.pointee.italic = data.load(fromByteOffset: 22, as: UInt8.self) != 0
+        checkRange(u32(24), u32(28), "family name")
+        font.pointee.family_name.ptr = pointer(u32(24))
+        font.pointee.family_name.len = UInt(u32(28))
+        let familyBytes = UnsafeBufferPointer(start: pointer(u32(24)), count: u32(28))
+        familyName = String(decoding: familyBytes, as: UTF8.self)
+        // Slint reads it as a `str`. Decoding only gives back the same bytes if they were valid UTF-8.
+        precondition(familyName.utf8.elementsEqual(familyBytes), "Baked font's family name isn't UTF-8!")
+
+        // Character map entries are baked in Slint's layout, so Slint reads them where they are.
+        // Their code points are Rust `char`s, and Slint indexes glyphs with them, so both have to be valid.
+        characterCount = u32(36)
+        let glyphCount = u32(40)
+        checkRange(u32(32), characterCount, stride: 8, aligned: true, "character map")
+        for entry in 0 ..< characterCount {
+            let codePoint = u32(u32(32) + entry * 8)
+            precondition(Unicode.Scalar(UInt32(codePoint)) != nil, "Baked font's character map has an invalid code point!")
+            precondition(Int(UInt16(bitPattern: i16(u32(32) + entry * 8 + 4))) < glyphCount, "Baked font's character map has a glyph index out of range!")
+        }
+        font.pointee.character_map.ptr = (data + u32(32)).bindMemory(to: CharacterMapEntry.self, capacity: characterCount)
+        font.pointee.character_map.len = UInt(characterCount)
+
+        // Glyph records have offsets rather than pointers, so they're the only thing made.
+        let sizeCount = u32(44)
+        let sizes = u32(48)
+        checkRange(sizes, sizeCount, stride: 8, aligned: true, "size table")
+        let sets = UnsafeMutablePointer<BitmapGlyphs>.allocate(capacity: sizeCount)
+        var pixelSizes: [Int] = []
+        for index in 0 ..< sizeCount {
+            let table = u32(sizes + index * 8 + 4)
+            checkRange(table, glyphCount, stride: 20, aligned: true, "glyph records")
+            let glyphs = UnsafeMutablePointer<BitmapGlyph>.allocate(capacity: glyphCount)
+            for glyph in 0 ..< glyphCount {
+                let record = table + glyph * 20
+                var bitmap = BitmapGlyph()
+                bitmap.x = i16(record)
+                bitmap.y = i16(record + 2)
+                bitmap.width = i16(record + 4)
+                bitmap.height = i16(record + 6)
+                bitmap.x_advance = i16(record + 8)
+                // The renderer reads `width` by `height` bytes of alpha.
+                precondition(bitmap.width >= 0 && bitmap.height >= 0, "Baked font has a glyph with a negative size!")
+                checkRange(u32(record + 12), u32(record + 16), "glyph data")
+                precondition(Int(bitmap.width) * Int(bitmap.height) <= u32(record + 16), "Baked font has a glyph with too little data for its size!")
+                bitmap.data.ptr = pointer(u32(record + 12))
+                bitmap.data.len = UInt(u32(record + 16))
+                (glyphs + glyph).initialize(to: bitmap)
+            }
+
+            pixelSizes.append(u32(sizes + index * 8))
+            precondition(pixelSizes[index] <= Int(Int16.max), "Baked font has a pixel size out of range!")
+            var set = BitmapGlyphs()
+            set.pixel_size = Int16(pixelSizes[index])
+            set.glyph_data.ptr = glyphs
+            set.glyph_data.len = UInt(glyphCount)
+            (sets + index).initialize(to: set)
+        }
+        font.pointee.glyphs.ptr = sets
+        font.pointee.glyphs.len = UInt(sizeCount)
+        self.pixelSizes = pixelSizes
+    }
+
+    /// Use baked data that's in an array, e.g. read from a file. It's copied once, to memory that's never freed.
+    public convenience init(baked bytes: [UInt8]) {
+        let data = UnsafeMutableRawBufferPointer.allocate(byteCount: bytes.count, alignment: 8)
+        data.copyBytes(from: bytes)
+        self.init(baked: UnsafeRawBufferPointer(data))
+    }
+}
+
+/// Slint couldn't load a font.
+public enum SlintFontError: Error, CustomStringConvertible {
+    case registrationFailed(path: String, message: String)
+
+    public var description: String {
+        switch self {
+        case .registrationFailed(let path, let message):
+            return "Couldn't register the font at \(path): \(message)"
+        }
+    }
+}
+
+extension SlintComponentInstance {
+    /// The instance's window, for Slint's window functions. Borrowed.
+    var window: UnsafePointer<WindowAdapterRcOpaque> {
+        var window: UnsafePointer<WindowAdapterRcOpaque>?
+        slint_interpreter_component_instance_window(erased, &window)
+        return window!
+    }
+
+    /// Register a baked font with the window's renderer, before text is first drawn.
+    /// Only the software renderer has bitmap fonts. Other renderers log, and ignore it.
+    public func register(_ font: SlintBitmapFont) {
+        slint_register_bitmap_font(window, font.font)
+    }
+
+    /// Register a TrueType or OpenType font file with the window's renderer, which parses it now,
+    /// and rasterizes glyphs as text needs them.
+    /// - Throws: `SlintFontError.registrationFailed`, with Slint's message.
+    public func registerFont(fromPath path: String) throws {
+        var error = SharedString()
+        withUnsafePointer(to: SharedString(path)) { slint_register_font_from_path(window, $0, &error) }
+        guard error.string.isEmpty else {
+            throw SlintFontError.registrationFailed(path: path, message: error.string)
+        }
+    }
+}
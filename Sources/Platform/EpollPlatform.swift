@@ -0,0 +1,229 @@
+//
+//  EpollPlatform.swift
+//  slint
+//
+
+#if os(Linux)
+
+// For `epoll`, `eventfd`, and `NSLock`.
+import Foundation
+
+import SlintFFI
+
+/// A Slint platform whose event loop is one `epoll` loop, on the thread that called `EventLoop.start()`.
+///
+/// The loop waits on a single `epoll` descriptor for everything:
+/// - Tasks posted to Slint, including `SlintActor`'s jobs, which wake it through an `eventfd`.
+/// - Slint's next timer deadline, as the `epoll_wait` timeout.
+/// - Any descriptor added with `watch(_:for:_:)`, like sockets and serial ports.
+///
+/// Handlers for watched descriptors run on the loop thread, isolated to `SlintActor`,
+/// so I/O can update the UI directly, without hopping between threads.
+///
+/// Windows are `SoftwareWindowAdapter`s, like `HeadlessPlatform`'s, rendered by the application.
+/// Install it in `start()`, before anything creates a window:
+/// ```swift
+/// let platform = EpollPlatform.install()
+/// platform.watch(socket, for: .readable) { _ in
+///     instance.setProperty("status", .string(SharedString(readStatus(socket))))
+/// }
+/// ```
+public final class EpollPlatform {
+    /// The installed platform. Slint only takes one per process.
+    public private(set) static var shared: EpollPlatform?
+
+    /// Readiness of a watched descriptor.
+    public struct Events: OptionSet {
+        public let rawValue: UInt32
+        public init(rawValue: UInt32) { self.rawValue = rawValue }
+
+        public static let readable = Events(rawValue: EPOLLIN.rawValue)
+        public static let writable = Events(rawValue: EPOLLOUT.rawValue)
+        /// Only reported, never waited for.
+        public static let error = Events(rawValue: EPOLLERR.rawValue)
+        /// Only reported, never waited for.
+        public static let hangUp = Events(rawValue: EPOLLHUP.rawValue)
+    }
+
+    /// Given to the next window Slint creates. If `nil`, Slint gets a 640×480 window.
+    public var nextWindow: SoftwareWindowAdapter?
+
+    private let startedAt = monotonicNanoseconds()
+
+    private let epoll: Int32
+    /// Written to wake the loop for posted tasks, and quitting.
+    private let wakeup: Int32
+
+    /// Tasks posted to the event loop. Posted from any thread.
+    private let lock = NSLock()
+    private var tasks: [PlatformTaskOpaque] = []
+    private var quitRequested = false
+    /// True while an `eventfd` write is unread, so a burst of posts only wakes the loop once.
+    private var wakeupPending = false
+
+    /// Handlers for watched descriptors. Only touched on the loop thread.
+    private var handlers: [Int32: @SlintActor (Events) -> Void] = [:]
+
+    /// Most events taken per `epoll_wait`.
+    private static let maxEvents = 64
+
+    private init() {
+        epoll = epoll_create1(Int32(EPOLL_CLOEXEC))
+        wakeup = eventfd(0, Int32(EFD_CLOEXEC | EFD_NONBLOCK))
+        precondition(epoll >= 0 && wakeup >= 0, "Couldn't create the event loop's descriptors: \(String(cString: strerror(errno))).")
+
+        var event = epoll_event()
+        event.events = EPOLLIN.rawValue
+        event.data.fd = wakeup
+        epoll_ctl(epoll, EPOLL_CTL_ADD, wakeup, &event)
+    }
+
+    deinit {
+        close(wakeup)
+        close(epoll)
+    }
+
+    /// Register the platform with Slint. Call once, before any window is created.
+    @discardableResult
+    public static func install() -> EpollPlatform {
+        precondition(shared == nil, "A platform is already installed.")
+        let platform = EpollPlatform()
+        shared = platform
+
+        slint_platform_register(
+            Unmanaged.passRetained(platform).toOpaque(),
+            { Unmanaged<EpollPlatform>.fromOpaque($0!).release() },
+            { userData, target in
+                let platform = EpollPlatform.from(userData)
+                let window = platform.nextWindow ?? SoftwareWindowAdapter(width: 640, height: 480)
+                platform.nextWindow = nil
+                window.makeWindowAdapter(target!)
+            },
+            { EpollPlatform.from($0).now },
+            // No clipboard.
+            { _, _, _ in },
+            { _, _, _ in false },
+            { EpollPlatform.from($0).run() },
+            { EpollPlatform.from($0).quit() },
+            { EpollPlatform.from($0).post($1) }
+        )
+        return platform
+    }
+
+    private static func from(_ userData: PlatformUserData?) -> EpollPlatform {
+        Unmanaged<EpollPlatform>.fromOpaque(userData!).takeUnretainedValue()
+    }
+
+    /// Milliseconds since the platform was installed.
+    public var now: UInt64 {
+        (monotonicNanoseconds() - startedAt) / 1_000_000
+    }
+
+    // MARK: Watching descriptors
+
+    /// Call a handler on the event loop whenever a descriptor is ready.
+    ///
+    /// Level-triggered: the handler is called again on the next turn, until whatever is ready is read or written.
+    /// The descriptor isn't closed by the platform. Call `unwatch(_:)` before closing it.
+    /// - Parameters:
+    ///   - descriptor: A socket, pipe, serial port, or anything else `epoll` takes. Regular files aren't.
+    ///   - events: What to wait for.
+    ///   - handler: Called with what's ready. Errors and hang-ups are always reported.
+    @SlintActor
+    public func watch(_ descriptor: Int32, for events: Events = .readable, _ handler: @escaping @SlintActor (Events) -> Void) {
+        var event = epoll_event()
+        event.events = events.rawValue
+        event.data.fd = descriptor
+
+        let operation = handlers[descriptor] == nil ? EPOLL_CTL_ADD : EPOLL_CTL_MOD
+        precondition(epoll_ctl(epoll, operation, descriptor, &event) == 0, "Couldn't watch descriptor \(descriptor): \(String(cString: strerror(errno))).")
+        handlers[descriptor] = handler
+    }
+
+    /// Stop watching a descriptor.
+    @SlintActor
+    public func unwatch(_ descriptor: Int32) {
+        guard handlers.removeValue(forKey: descriptor) != nil else { return }
+        epoll_ctl(epoll, EPOLL_CTL_DEL, descriptor, nil)
+    }
+
+    // MARK: Event loop
+
+    private func post(_ task: PlatformTaskOpaque) {
+        lock.lock()
+        tasks.append(task)
+        let wake = !wakeupPending
+        wakeupPending = true
+        lock.unlock()
+
+        if wake { signal() }
+    }
+
+    private func quit() {
+        lock.lock()
+        quitRequested = true
+        lock.unlock()
+        signal()
+    }
+
+    private func signal() {
+        var one: UInt64 = 1
+        _ = write(wakeup, &one, MemoryLayout<UInt64>.size)
+    }
+
+    private func run() {
+        lock.lock()
+        quitRequested = false
+        lock.unlock()
+
+        let events = UnsafeMutablePointer<epoll_event>.allocate(capacity: Self.maxEvents)
+        defer { events.deallocate() }
+
+        // A turn runs from `epoll_wait` returning until it's called again.
+        var turn = traceBegin()
+        while true {
+            updateTimersAndAnimations()
+
+            lock.lock()
+            let idle = tasks.isEmpty && !quitRequested
+            lock.unlock()
+
+            // Don't sleep if there's work. Otherwise, until the next timer, or forever if there isn't one.
+            let delay = slint_platform_duration_until_next_timer_update()
+            let timeout = !idle ? 0 : delay == .max ? -1 : Int32(clamping: delay)
+
+            traceEnd(.eventLoopTurn, turn)
+            let count = epoll_wait(epoll, events, Int32(Self.maxEvents), timeout)
+            turn = traceBegin()
+            if count < 0 && errno != EINTR {
+                preconditionFailure("epoll_wait failed: \(String(cString: strerror(errno))).")
+            }
+
+            for index in 0 ..< max(Int(count), 0) {
+                let descriptor = events[index].data.fd
+                if descriptor == wakeup {
+                    var value: UInt64 = 0
+                    _ = read(wakeup, &value, MemoryLayout<UInt64>.size)
+                } else if let handler = handlers[descriptor] {
+                    let ready = Events(rawValue: events[index].events)
+                    SlintActor.assumeIsolated { handler(ready) }
+                }
+            }
+
+            lock.lock()
+            let ready = tasks
+            tasks.removeAll(keepingCapacity: true)
+            wakeupPending = false
+            let quitting = quitRequested
+            lock.unlock()
+
+            for task in ready { slint_platform_task_run(task) }
+            if quitting {
+                traceEnd(.eventLoopTurn, turn)
+                return
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,139 @@
+//
+//  HeadlessPlatform.swift
+//  slint
+//
+
+// For `NSCondition`.
+import Foundation
+
+import SlintFFI
+
+/// A Slint platform with no display. Windows are `SoftwareWindowAdapter`s, rendered only when asked.
+///
+/// For benchmarks, tests, and devices that push frames somewhere Slint doesn't know about.
+/// Install it in `start()`, before anything creates a window:
+/// ```swift
+/// let platform = HeadlessPlatform.install()
+/// platform.nextWindow = SoftwareWindowAdapter(width: 800, height: 480)
+/// let instance = definition.create()
+/// ```
+///
+/// The event loop is a plain loop: run posted tasks, update timers and animations, then sleep until the next timer.
+/// Time can be real, or advanced by hand with `advance(by:)`, so animations are reproducible.
+public final class HeadlessPlatform {
+    /// The installed platform. Slint only takes one per process.
+    public private(set) static var shared: HeadlessPlatform?
+
+    /// Given to the next window Slint creates. If `nil`, Slint gets a 640×480 window.
+    public var nextWindow: SoftwareWindowAdapter?
+
+    /// Milliseconds, when time is advanced by hand. `nil` for real time.
+    private var manualTime: UInt64?
+    private let startedAt = monotonicNanoseconds()
+
+    /// Tasks posted to the event loop.
+    private let condition = NSCondition()
+    private var tasks: [PlatformTaskOpaque] = []
+    private var quitRequested = false
+
+    private init(manualTime: Bool) {
+        self.manualTime = manualTime ? 0 : nil
+    }
+
+    /// Register the platform with Slint. Call once, before any window is created.
+    /// - Parameter manualTime: Stop the clock. It only moves with `advance(by:)`.
+    @discardableResult
+    public static func install(manualTime: Bool = false) -> HeadlessPlatform {
+        precondition(shared == nil, "A platform is already installed.")
+        let platform = HeadlessPlatform(manualTime: manualTime)
+        shared = platform
+
+        slint_platform_register(
+            Unmanaged.passRetained(platform).toOpaque(),
+            { Unmanaged<HeadlessPlatform>.fromOpaque($0!).release() },
+            { userData, target in
+                let platform = HeadlessPlatform.from(userData)
+                let window = platform.nextWindow ?? SoftwareWindowAdapter(width: 640, height: 480)
+                platform.nextWindow = nil
+                window.makeWindowAdapter(target!)
+            },
+            { HeadlessPlatform.from($0).now },
+            // No clipboard.
+            { _, _, _ in },
+            { _, _, _ in false },
+            { HeadlessPlatform.from($0).run() },
+            { HeadlessPlatform.from($0).quit() },
+            { HeadlessPlatform.from($0).post($1) }
+        )
+        return platform
+    }
+
+    private static func from(_ userData: PlatformUserData?) -> HeadlessPlatform {
+        Unmanaged<HeadlessPlatform>.fromOpaque(userData!).takeUnretainedValue()
+    }
+
+    // MARK: Time
+
+    /// Milliseconds since the platform was installed, as Slint sees it.
+    public var now: UInt64 {
+        manualTime ?? (monotonicNanoseconds() - startedAt) / 1_000_000
+    }
+
+    /// Move the clock forward, then update Slint's timers and animations. Only for manual time.
+    public func advance(by milliseconds: UInt64) {
+        precondition(manualTime != nil, "Time is real. Install with `manualTime: true` to advance it by hand.")
+        manualTime! += milliseconds
+        updateTimersAndAnimations()
+    }
+
+    // MARK: Event loop
+
+    private func post(_ task: PlatformTaskOpaque) {
+        condition.lock()
+        tasks.append(task)
+        condition.signal()
+        condition.unlock()
+    }
+
+    private func quit() {
+        condition.lock()
+        quitRequested = true
+        condition.signal()
+        condition.unlock()
+    }
+
+    private func run() {
+        condition.lock()
+        quitRequested = false
+        condition.unlock()
+
+        // A turn runs from waking until going back to sleep.
+        var turn = traceBegin()
+        while true {
+            updateTimersAndAnimations()
+
+            condition.lock()
+            if tasks.isEmpty && !quitRequested {
+                traceEnd(.eventLoopTurn, turn)
+                // `UInt64.max` if there's no timer. With manual time, only a task or a quit can wake us.
+                let delay = slint_platform_duration_until_next_timer_update()
+                if delay == .max || manualTime != nil {
+                    condition.wait()
+                } else {
+                    condition.wait(until: Date(timeIntervalSinceNow: Double(delay) / 1000))
+                }
+                turn = traceBegin()
+            }
+            let ready = tasks
+            tasks.removeAll(keepingCapacity: true)
+            let quitting = quitRequested
+            condition.unlock()
+
+            for task in ready { slint_platform_task_run(task) }
+            if quitting {
+                traceEnd(.eventLoopTurn, turn)
+                return
+            }
+        }
+    }
+}
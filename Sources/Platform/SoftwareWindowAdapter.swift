@@ -0,0 +1,131 @@
+//
+//  SoftwareWindowAdapter.swift
+//  slint
+//
+
+import SlintFFI
+
+/// A window that renders with Slint's software renderer, into buffers you provide. Nothing is shown on screen.
+///
+/// Hand one to `HeadlessPlatform`, and the next component instance created gets it as its window.
+/// Then call `render(into:stride:)` whenever you want a frame.
+public final class SoftwareWindowAdapter {
+    /// How Slint's software renderer stores pixels.
+    public enum PixelFormat {
+        /// 3 bytes per pixel.
+        case rgb8
+        /// 2 bytes per pixel.
+        case rgb565
+
+        public var bytesPerPixel: Int {
+            switch self {
+            case .rgb8: return 3
+            case .rgb565: return 2
+            }
+        }
+    }
+
+    /// The renderer. Slint owns it, we drop it.
+    private let renderer: SoftwareRendererOpaque
+
+    /// Size, in physical pixels.
+    public private(set) var width: UInt32
+    public private(set) var height: UInt32
+
+    /// Set when Slint asks for a redraw. Cleared by rendering.
+    public private(set) var redrawRequested = false
+    /// Whether Slint has shown the window.
+    public private(set) var isVisible = false
+
+    /// Called when Slint asks for a redraw, e.g. to schedule a frame.
+    public var onRedrawRequested: (() -> Void)?
+
+    /// Make a window.
+    /// - Parameters:
+    ///   - width: Width, in physical pixels.
+    ///   - height: Height, in physical pixels.
+    ///   - bufferAge: How many frames old a buffer is when it's rendered into again.
+    ///     0 repaints everything, every frame. 1 is one buffer, reused. 2 is double buffering.
+    ///     Above 0, Slint only repaints what changed.
+    public init(width: UInt32, height: UInt32, bufferAge: UInt32 = 0) {
+        self.width = width
+        self.height = height
+        renderer = slint_software_renderer_new(bufferAge)
+    }
+
+    deinit {
+        slint_software_renderer_drop(renderer)
+    }
+
+    /// Pixels in a full frame.
+    public var pixelCount: Int { Int(width) * Int(height) }
+
+    /// Render a frame into an RGB8 buffer.
+    /// - Parameters:
+    ///   - buffer: At least `stride * height` pixels.
+    ///   - stride: Pixels per row. Defaults to the width.
+    /// - Returns: The region that was repainted.
+    @discardableResult
+    public func render(into buffer: UnsafeMutableBufferPointer<Rgb8Pixel>, stride: Int? = nil) -> IntRect {
+        redrawRequested = false
+        return slint_software_renderer_render_rgb8(renderer, buffer.baseAddress, UInt(buffer.count), UInt(stride ?? Int(width)))
+    }
+
+    /// Render a frame into an RGB565 buffer.
+    /// - Parameters:
+    ///   - buffer: At least `stride * height` pixels.
+    ///   - stride: Pixels per row. Defaults to the width.
+    /// - Returns: The region that was repainted.
+    @discardableResult
+    public func render(into buffer: UnsafeMutableBufferPointer<UInt16>, stride: Int? = nil) -> IntRect {
+        redrawRequested = false
+        return slint_software_renderer_render_rgb565(renderer, buffer.baseAddress, UInt(buffer.count), UInt(stride ?? Int(width)))
+    }
+
+    // MARK: Window adapter
+
+    /// Make Slint's side of the window, in place. Slint keeps this adapter alive until it drops the window.
+    func makeWindowAdapter(_ target: UnsafeMutablePointer<WindowAdapterRcOpaque>) {
+        slint_window_adapter_new(
+            Unmanaged.passRetained(self).toOpaque(),
+            { Unmanaged<SoftwareWindowAdapter>.fromOpaque($0!).release() },
+            { slint_software_renderer_handle(SoftwareWindowAdapter.from($0).renderer) },
+            { SoftwareWindowAdapter.from($0).isVisible = $1 },
+            {
+                let window = SoftwareWindowAdapter.from($0)
+                window.redrawRequested = true
+                // Once per batch, after its writes are applied.
+                if !PropertyBatch.deferRedraw(window) { window.onRedrawRequested?() }
+                // Whatever changed may have started an animation.
+                WakeupScheduler.rearmSoon()
+            },
+            {
+                let window = SoftwareWindowAdapter.from($0)
+                var size = IntSize()
+                size.width = window.width
+                size.height = window.height
+                return size
+            },
+            {
+                let window = SoftwareWindowAdapter.from($0)
+                window.width = $1.width
+                window.height = $1.height
+            },
+            // Nothing to show the title or background on.
+            { _, _ in },
+            // No position on a screen.
+            { _, _ in false },
+            { _, _ in },
+            target
+        )
+    }
+
+    private static func from(_ userData: WindowAdapterUserData?) -> SoftwareWindowAdapter {
+        Unmanaged<SoftwareWindowAdapter>.fromOpaque(userData!).takeUnretainedValue()
+    }
+}
+
+extension IntRect {
+    /// Area, in pixels.
+    public var area: Int { Int(width) * Int(height) }
+}
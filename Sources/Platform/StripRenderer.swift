@@ -0,0 +1,162 @@
+//
+//  StripRenderer.swift
+//  slint
+//
+
+// For `write` and `POSIXError`.
+import Foundation
+
+import SlintFFI
+
+/// Receives a frame as horizontal strips of RGB565 pixels, e.g. to push over SPI.
+///
+/// For each frame: `begin`, then one `write` per strip, top to bottom, then `end`.
+/// Strips only cover the region that changed, so rows are `region.width` pixels, with no padding.
+public protocol StripSink: AnyObject {
+    /// A frame is starting. Only `region` will be written, e.g. set the display's address window to it.
+    func begin(region: IntRect) throws
+    /// Some rows of the region. Borrowed, only valid during the call.
+    /// - Parameters:
+    ///   - pixels: `rows * region.width` pixels.
+    ///   - y: First row, in window coordinates.
+    ///   - rows: Number of rows.
+    func write(_ pixels: UnsafeBufferPointer<UInt16>, y: Int, rows: Int) throws
+    /// The frame is done.
+    func end() throws
+}
+
+/// Writes raw strips to a file descriptor, like a file or a pipe. Each frame is its pixels, nothing else.
+public final class FileDescriptorStripSink: StripSink {
+    public let descriptor: Int32
+    public private(set) var bytesWritten = 0
+
+    public init(descriptor: Int32) {
+        self.descriptor = descriptor
+    }
+
+    public func begin(region: IntRect) throws { }
+
+    public func write(_ pixels: UnsafeBufferPointer<UInt16>, y: Int, rows: Int) throws {
+        try writeAll(descriptor, UnsafeRawBufferPointer(pixels))
+        bytesWritten += pixels.count * MemoryLayout<UInt16>.size
+    }
+
+    public func end() throws { }
+}
+
+/// `write`, until everything is written. Out here, so `write` isn't the sink's.
+private func writeAll(_ descriptor: Int32, _ bytes: UnsafeRawBufferPointer) throws {
+    var bytes = bytes
+    while !bytes.isEmpty {
+        let written = write(descriptor, bytes.baseAddress, bytes.count)
+        guard written >= 0 else {
+            if errno == EINTR { continue }
+            throw POSIXError(POSIXErrorCode(rawValue: errno) ?? .EIO)
+        }
+        bytes = UnsafeRawBufferPointer(rebasing: bytes[written...])
+    }
+}
+
+/// Stands in for an SPI display. Counts transactions and bytes, and keeps a checksum, so nothing is optimized away.
+public final class MockSPIStripSink: StripSink {
+    public private(set) var frames = 0
+    /// Address window commands, plus one transfer per strip.
+    public private(set) var transactions = 0
+    public private(set) var bytesTransferred = 0
+    public private(set) var checksum: UInt32 = 0
+
+    public init() { }
+
+    public func begin(region: IntRect) throws {
+        transactions += 1
+    }
+
+    public func write(_ pixels: UnsafeBufferPointer<UInt16>, y: Int, rows: Int) throws {
+        transactions += 1
+        bytesTransferred += pixels.count * MemoryLayout<UInt16>.size
+        for pixel in pixels { checksum = checksum &* 31 &+ UInt32(pixel) }
+    }
+
+    public func end() throws {
+        frames += 1
+    }
+}
+
+/// Streams frames to a `StripSink`, a few rows at a time, through one small reusable buffer.
+///
+/// Only the region Slint repainted is streamed, so an unchanged frame sends nothing,
+/// and a blinking cursor sends a few hundred bytes.
+///
+/// Slint renders into a whole frame, kept here between frames. The C FFI this is built on has no way
+/// to render a line at a time, so the frame can't be avoided, only everything downstream of it.
+public final class StripRenderer {
+    public let window: SoftwareWindowAdapter
+    /// Rows per strip.
+    public let stripHeight: Int
+    /// Swap each pixel's bytes. Most SPI displays want RGB565 big-endian.
+    public let byteSwapped: Bool
+
+    /// Slint's frame. Reused, so Slint only repaints what changed.
+    private let frame: UnsafeMutableBufferPointer<UInt16>
+    /// One strip, `stripHeight` rows of the widest possible region.
+    private let strip: UnsafeMutableBufferPointer<UInt16>
+
+    /// Bytes held by the frame and the strip.
+    public var bufferBytes: Int { (frame.count + strip.count) * MemoryLayout<UInt16>.stride }
+
+    /// Make a renderer, and the window it renders.
+    /// - Parameters:
+    ///   - width: Width, in physical pixels.
+    ///   - height: Height, in physical pixels.
+    ///   - stripHeight: Rows per strip. Smaller strips, smaller buffer, more writes.
+    ///   - byteSwapped: Swap each pixel's bytes before streaming it.
+    public init(width: Int, height: Int, stripHeight: Int, byteSwapped: Bool = false) {
+        precondition(stripHeight > 0, "Strips need at least one row.")
+        window = SoftwareWindowAdapter(width: UInt32(width), height: UInt32(height), bufferAge: 1)
+        self.stripHeight = min(stripHeight, height)
+        self.byteSwapped = byteSwapped
+
+        frame = .allocate(capacity: width * height)
+        frame.initialize(repeating: 0)
+        strip = .allocate(capacity: width * self.stripHeight)
+    }
+
+    deinit {
+        frame.deallocate()
+        strip.deallocate()
+    }
+
+    /// Render a frame, and stream what changed.
+    /// - Returns: The region that was streamed. Empty if nothing changed, in which case the sink isn't called.
+    @discardableResult
+    public func render(to sink: StripSink) throws -> IntRect {
+        let width = Int(window.width)
+        let region = window.render(into: frame).clamped(width: width, height: Int(window.height))
+        guard region.area > 0 else { return region }
+
+        try sink.begin(region: region)
+
+        let left = Int(region.x)
+        let columns = Int(region.width)
+        var y = Int(region.y)
+        let bottom = y + Int(region.height)
+
+        while y < bottom {
+            let rows = min(stripHeight, bottom - y)
+            for row in 0 ..< rows {
+                let source = frame.baseAddress! + (y + row) * width + left
+                let target = strip.baseAddress! + row * columns
+                if byteSwapped {
+                    for column in 0 ..< columns { target[column] = source[column].byteSwapped }
+                } else {
+                    target.update(from: source, count: columns)
+                }
+            }
+            try sink.write(UnsafeBufferPointer(start: strip.baseAddress, count: rows * columns), y: y, rows: rows)
+            y += rows
+        }
+
+        try sink.end()
+        return region
+    }
+}
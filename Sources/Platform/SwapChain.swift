@@ -0,0 +1,230 @@
+//
+//  SwapChain.swift
+//  slint
+//
+
+// For `mmap` and `shm_open`.
+import Foundation
+
+import SlintFFI
+
+/// Pixels Slint's software renderer can draw.
+public protocol SoftwarePixel {
+    /// Render a frame of a window into a buffer of these.
+    static func render(_ window: SoftwareWindowAdapter, into buffer: UnsafeMutableBufferPointer<Self>, stride: Int) -> IntRect
+}
+
+extension Rgb8Pixel: SoftwarePixel {
+    public static func render(_ window: SoftwareWindowAdapter, into buffer: UnsafeMutableBufferPointer<Rgb8Pixel>, stride: Int) -> IntRect {
+        window.render(into: buffer, stride: stride)
+    }
+}
+
+/// RGB565.
+extension UInt16: SoftwarePixel {
+    public static func render(_ window: SoftwareWindowAdapter, into buffer: UnsafeMutableBufferPointer<UInt16>, stride: Int) -> IntRect {
+        window.render(into: buffer, stride: stride)
+    }
+}
+
+/// Counters for a `SoftwareSwapChain`.
+public struct SwapChainStatistics {
+    public internal(set) var frames = 0
+    /// Pixels Slint repainted.
+    public internal(set) var pixelsRendered = 0
+    /// Pixels copied from the previous buffer, to bring a buffer up to date before rendering.
+    public internal(set) var pixelsCopied = 0
+}
+
+/// Double or triple buffering for the software renderer, only repainting what changed.
+///
+/// Each buffer is brought up to date with the previous frame, by copying the regions that changed since it was last used,
+/// then Slint repaints only what changed this frame. So every frame is pixel-for-pixel what a full redraw would give,
+/// at the cost of a few small copies.
+///
+/// Buffers are page aligned, and can live in shared memory, under `/dev/shm`, for another process to present.
+public final class SoftwareSwapChain<Pixel: SoftwarePixel> {
+    /// Where the buffers live.
+    public enum Storage {
+        /// Private to this process.
+        case anonymous
+        /// A POSIX shared memory object, e.g. `"/slint-frames"`. Created, and unlinked when the chain is.
+        case sharedMemory(name: String)
+    }
+
+    public enum SwapChainError: Error {
+        case sharedMemoryFailed(errno: Int32)
+        case mapFailed(errno: Int32)
+    }
+
+    /// A rendered frame.
+    public struct Frame {
+        /// Which buffer it's in.
+        public let index: Int
+        /// The whole buffer. `stride` pixels per row.
+        public let pixels: UnsafeMutableBufferPointer<Pixel>
+        /// What changed since the previous frame. Present this much, if the display still shows the previous frame.
+        public let damage: IntRect
+        /// What changed in this buffer since it was last presented. Copy this much, if you mirror each buffer separately.
+        public let bufferDamage: IntRect
+    }
+
+    /// The window to render. Give it to `HeadlessPlatform.nextWindow`, or wrap it in another platform's window.
+    public let window: SoftwareWindowAdapter
+
+    public let width: Int
+    public let height: Int
+    /// Pixels per row.
+    public let stride: Int
+    public var bufferCount: Int { buffers.count }
+
+    public private(set) var statistics = SwapChainStatistics()
+
+    private let storage: Storage
+    private let mapping: UnsafeMutableRawPointer
+    private let mappingSize: Int
+    private let buffers: [UnsafeMutableBufferPointer<Pixel>]
+
+    /// Buffer the next frame goes in.
+    private var next = 0
+    /// Buffer the previous frame went in. `nil` before the first frame.
+    private var previous: Int?
+    /// Frame number each buffer last held. `nil` if it never has.
+    private var heldFrame: [Int?]
+    /// Damage of the most recent frames, oldest first. Only as many as a buffer can fall behind.
+    private var history: [IntRect] = []
+
+    /// Make a swap chain, and the window it renders.
+    /// - Parameters:
+    ///   - width: Width, in physical pixels.
+    ///   - height: Height, in physical pixels.
+    ///   - buffers: 2 for double buffering, 3 for triple.
+    ///   - storage: Where the buffers live.
+    public init(width: Int, height: Int, buffers count: Int = 2, storage: Storage = .anonymous) throws {
+        precondition(count >= 1, "A swap chain needs at least one buffer.")
+
+        self.width = width
+        self.height = height
+        self.stride = width
+        self.storage = storage
+
+        let pageSize = Int(sysconf(Int32(_SC_PAGESIZE)))
+        let bufferBytes = (width * height * MemoryLayout<Pixel>.stride + pageSize - 1) / pageSize * pageSize
+        mappingSize = bufferBytes * count
+
+        let base: UnsafeMutableRawPointer
+        switch storage {
+        case .anonymous:
+            let mapped = mmap(nil, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)
+            guard let mapped, mapped != MAP_FAILED else { throw SwapChainError.mapFailed(errno: errno) }
+            base = mapped
+
+        case .sharedMemory(let name):
+            let descriptor = shm_open(name, O_CREAT | O_RDWR, 0o600)
+            guard descriptor >= 0 else { throw SwapChainError.sharedMemoryFailed(errno: errno) }
+            defer { close(descriptor) }
+            guard ftruncate(descriptor, off_t(mappingSize)) == 0 else {
+                let error = errno
+                shm_unlink(name)
+                throw SwapChainError.sharedMemoryFailed(errno: error)
+            }
+            let mapped = mmap(nil, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0)
+            guard let mapped, mapped != MAP_FAILED else {
+                let error = errno
+                shm_unlink(name)
+                throw SwapChainError.mapFailed(errno: error)
+            }
+            base = mapped
+        }
+        mapping = base
+
+        buffers = (0 ..< count).map { index in
+            let start = (base + index * bufferBytes).bindMemory(to: Pixel.self, capacity: width * height)
+            return UnsafeMutableBufferPointer(start: start, count: width * height)
+        }
+        heldFrame = Array(repeating: nil, count: count)
+
+        // Each buffer is brought up to date before rendering, so to Slint it's always the same buffer, reused.
+        window = SoftwareWindowAdapter(width: UInt32(width), height: UInt32(height), bufferAge: 1)
+    }
+
+    deinit {
+        munmap(mapping, mappingSize)
+        if case .sharedMemory(let name) = storage { shm_unlink(name) }
+    }
+
+    /// Render the next frame, into the next buffer.
+    public func render() -> Frame {
+        let index = next
+        next = (next + 1) % buffers.count
+        let frameNumber = statistics.frames
+
+        // Bring the buffer up to date with the previous frame.
+        var catchUp: IntRect?
+        if let previous, previous != index {
+            if let held = heldFrame[index] {
+                catchUp = history.suffix(frameNumber - held - 1).reduce(nil as IntRect?) { $0?.union($1) ?? $1 }
+            } else {
+                catchUp = fullFrame
+            }
+            if let catchUp {
+                copy(catchUp, from: buffers[previous], to: buffers[index])
+                statistics.pixelsCopied += catchUp.area
+            }
+        }
+
+        let damage = Pixel.render(window, into: buffers[index], stride: stride)
+
+        history.append(damage)
+        if history.count > buffers.count - 1 { history.removeFirst() }
+        heldFrame[index] = frameNumber
+        previous = index
+        statistics.frames += 1
+        statistics.pixelsRendered += damage.area
+
+        return Frame(index: index, pixels: buffers[index], damage: damage, bufferDamage: catchUp.map { $0.union(damage) } ?? damage)
+    }
+
+    private var fullFrame: IntRect {
+        var rect = IntRect()
+        rect.width = Int32(width)
+        rect.height = Int32(height)
+        return rect
+    }
+
+    /// Copy a region between buffers, row by row.
+    private func copy(_ region: IntRect, from source: UnsafeMutableBufferPointer<Pixel>, to target: UnsafeMutableBufferPointer<Pixel>) {
+        let region = region.clamped(width: width, height: height)
+        guard region.area > 0 else { return }
+
+        for row in Int(region.y) ..< Int(region.y + region.height) {
+            let offset = row * stride + Int(region.x)
+            (target.baseAddress! + offset).update(from: source.baseAddress! + offset, count: Int(region.width))
+        }
+    }
+}
+
+extension IntRect {
+    /// Smallest rectangle holding both. An empty rectangle adds nothing.
+    public func union(_ other: IntRect) -> IntRect {
+        if area == 0 { return other }
+        if other.area == 0 { return self }
+
+        var rect = IntRect()
+        rect.x = min(x, other.x)
+        rect.y = min(y, other.y)
+        rect.width = max(x + width, other.x + other.width) - rect.x
+        rect.height = max(y + height, other.y + other.height) - rect.y
+        return rect
+    }
+
+    /// The part inside `0, 0, width, height`.
+    func clamped(width: Int, height: Int) -> IntRect {
+        var rect = IntRect()
+        rect.x = Swift.max(x, 0)
+        rect.y = Swift.max(y, 0)
+        rect.width = Swift.max(Swift.min(x + self.width, Int32(width)) - rect.x, 0)
+        rect.height = Swift.max(Swift.min(y + self.height, Int32(height)) - rect.y, 0)
+        return rect
+    }
+}
@@ -15,24 +15,205 @@
 /// See: [How `@MainActor` works](https://oleb.net/2022/how-mainactor-works/)
 /// See: [swiftwasm/JavaScriptKit: `JavaScriptEventLoop.swift`](https://github.com/swiftwasm/JavaScriptKit/blob/main/Sources/JavaScriptEventLoop/JavaScriptEventLoop.swift)
 
+// NOTE: Only for `Thread.isMainThread`, `pthread_self()`, `NSCondition`, and the main queue.
+import Foundation
+
+import Atomics
+
 import SlintFFI
 
-/// Executor that takes queued jobs and posts them to Slint's event loop.
+/// Executor that takes queued jobs and runs them in Slint's event loop.
+///
+/// Jobs are pushed onto a lock-free queue, and a single "drain" event is posted to Slint while the queue is not empty.
+/// The drain event runs queued jobs until the queue is empty, or until `drainBudgetNanoseconds` has passed.
+/// If it runs out of time, it posts another drain event, so Slint gets a turn to handle input and rendering.
+///
+/// A burst of jobs therefore costs one `slint_post_event` and one event loop wakeup, instead of one of each per job.
+///
+/// Before the loop runs, jobs can't be posted. Where they go instead depends on `phase`, which only moves forward.
 final class SlintEventLoopExecutor: SerialExecutor {
+    /// Where jobs go, as the event loop starts.
+    enum Phase: Int {
+        /// Jobs run on the main actor, so `start()` can run before the loop, on the thread that will run it.
+        case mainActor
+        /// Jobs are held, and run once the loop starts, or by `runHeldJobs(until:)`.
+        case beforeLoop
+        /// Jobs are posted to the running loop.
+        case eventLoop
+    }
+
+    /// How jobs get from `enqueue(_:)` to the event loop.
+    enum Mode {
+        /// Jobs are queued and drained in batches. The default.
+        case batched
+        /// Every job is wrapped and posted as its own event. The original design, kept for comparison.
+        case perJob
+    }
+
     /// Private initializer.
     private init() { }
 
     /// A singleton instance of this Executor.
     public static let shared = SlintEventLoopExecutor()
 
+    /// How jobs are delivered. Only change this while no jobs are in flight.
+    var mode: Mode = .batched
+
+    /// Longest a single drain event may run jobs for, before yielding back to the event loop.
+    /// Checked between jobs, so one long job can still overrun it.
+    var drainBudgetNanoseconds: UInt64 = 4_000_000
+
+    /// Queued jobs, waiting for the next drain event.
+    private let queue = JobQueue<UnownedJob>(minimumCapacity: 16_384)
+
+    /// Set while a drain event is posted, or running. Guarantees only one is in flight.
+    private let drainPending = DrainHandshake()
+
+    /// Thread the event loop runs on, as a `pthread_t` bit pattern. 0 until the loop starts.
+    private let eventLoopThread = ManagedAtomic<UInt>(0)
+
+    /// A `Phase`. Read on every enqueue, so it's atomic; changed under `heldCondition`, so held jobs can't be stranded.
+    private let phase = ManagedAtomic<Int>(Phase.mainActor.rawValue)
+
+    /// Jobs enqueued in the `beforeLoop` phase.
+    private let heldCondition = NSCondition()
+    private var heldJobs: [UnownedJob] = []
+
     /// Execute the job in the Slint event loop. Required by `SerialExecutor`.
-    @inlinable
     public func enqueue(_ job: consuming ExecutorJob) {
-
         let unownedJob = UnownedJob(job)
 
+        switch Phase(rawValue: phase.load(ordering: .acquiring))! {
+        case .mainActor:
+            DispatchQueue.main.async { unownedJob.runSynchronously(on: self.asUnownedSerialExecutor()) }
+            return
+        case .beforeLoop:
+            if hold(unownedJob) { return }
+        case .eventLoop:
+            break
+        }
+
+        guard mode == .batched, queue.push(unownedJob) else {
+            // Either batching is off, or the queue is full because the event loop is falling behind.
+            // Posting the job on its own is slower, but never drops it.
+            postSingle(unownedJob)
+            return
+        }
+
+        // Only the producer that sets the flag posts. Everyone else piggybacks on that drain.
+        if drainPending.producerPushed() {
+            postDrain()
+        }
+    }
+
+    /// Get an unowned reference to the shared instance.
+    /// Complex equality, so the runtime asks `isSameExclusiveExecutionContext(other:)` instead of only comparing identities.
+    @inlinable
+    public func asUnownedSerialExecutor() -> UnownedSerialExecutor {
+        return UnownedSerialExecutor(complexEquality: self)
+    }
+
+    /// Every job this executor runs, runs on the event loop thread, one at a time. So any other instance is the same context.
+    /// There is only ever the shared instance, but the runtime may still ask.
+    public func isSameExclusiveExecutionContext(other: SlintEventLoopExecutor) -> Bool {
+        true
+    }
+
+    /// Crash unless called on the event loop thread.
+    /// Newer runtimes call this from `assumeIsolated` and `preconditionIsolated`, when the current task isn't running a job here.
+    /// Slint's callbacks and timers aren't jobs, but they are on the event loop thread, which is all isolation needs.
+    public func checkIsolated() {
+        precondition(isIsolatingCurrentContext, "Not on the Slint event loop thread!")
+    }
+
+    /// True if the current thread is the one `SlintActor` runs on. Costs one atomic load, and `pthread_self()`.
+    ///
+    /// Until the event loop starts, `SlintActor` runs on the main actor, so that's the main thread.
+    var isIsolatingCurrentContext: Bool {
+        let thread = eventLoopThread.load(ordering: .acquiring)
+        return thread == 0 ? Thread.isMainThread : thread == currentThreadID()
+    }
+
+    /// Record the current thread as the event loop's. Called by `EventLoop.start()`, just before the loop runs.
+    /// Tests call it to stand in for a running event loop.
+    func bindToCurrentThread() {
+        eventLoopThread.store(currentThreadID(), ordering: .releasing)
+    }
+
+    /// Forget the event loop thread. For tests.
+    func unbindThread() {
+        eventLoopThread.store(0, ordering: .releasing)
+    }
+
+    // MARK: Starting the loop
+
+    /// Stop sending jobs to the main actor, and hold them until the loop starts. Called by `SlintApp.main()`.
+    func holdUntilLoopStarts() {
+        heldCondition.lock()
+        if phase.load(ordering: .relaxed) == Phase.mainActor.rawValue {
+            phase.store(Phase.beforeLoop.rawValue, ordering: .releasing)
+        }
+        heldCondition.unlock()
+    }
+
+    /// The loop is running. Post jobs from now on, and run the ones held until now, in order.
+    /// Only ever called on the event loop thread, by `EventLoop`.
+    func loopStarted() {
+        heldCondition.lock()
+        phase.store(Phase.eventLoop.rawValue, ordering: .releasing)
+        let jobs = heldJobs
+        heldJobs = []
+        heldCondition.unlock()
+
+        let executor = asUnownedSerialExecutor()
+        for job in jobs { job.runSynchronously(on: executor) }
+    }
+
+    /// Run held jobs on this thread as they arrive, until `isDone` returns true.
+    ///
+    /// How `start()` runs on a dedicated event loop thread, before the loop: this thread is bound,
+    /// so the jobs are isolated, and Slint sees them on the thread that will run its loop.
+    /// - Parameter isDone: Checked after each batch of jobs. Call `wakeHeldJobRunner()` after it changes.
+    func runHeldJobs(until isDone: () -> Bool) {
+        let executor = asUnownedSerialExecutor()
+        heldCondition.lock()
+        while !isDone() {
+            if heldJobs.isEmpty {
+                heldCondition.wait()
+                continue
+            }
+            let jobs = heldJobs
+            heldJobs = []
+            heldCondition.unlock()
+
+            for job in jobs { job.runSynchronously(on: executor) }
+
+            heldCondition.lock()
+        }
+        heldCondition.unlock()
+    }
+
+    /// Wake `runHeldJobs(until:)`, to check if it's done.
+    func wakeHeldJobRunner() {
+        heldCondition.lock()
+        heldCondition.signal()
+        heldCondition.unlock()
+    }
+
+    /// Hold a job for later. False if the loop started since the phase was read, so the job should be posted.
+    private func hold(_ job: UnownedJob) -> Bool {
+        heldCondition.lock()
+        defer { heldCondition.unlock() }
+        guard phase.load(ordering: .relaxed) == Phase.beforeLoop.rawValue else { return false }
+        heldJobs.append(job)
+        heldCondition.signal()
+        return true
+    }
+
+    /// Post one job as its own event.
+    private func postSingle(_ unownedJob: UnownedJob) {
         let wrapper = WrappedClosure {
-            unownedJob.runSynchronously(on: self.asUnownedSerialExecutor())
+            traced(.executorJob) { unownedJob.runSynchronously(on: self.asUnownedSerialExecutor()) }
         }
 
         // Post as an event
@@ -43,10 +224,36 @@ final class SlintEventLoopExecutor: SerialExecutor {
         )
     }
 
-    /// Get an unowned reference to the shared instance.
-    @inlinable
-    public func asUnownedSerialExecutor() -> UnownedSerialExecutor {
-        return UnownedSerialExecutor(ordinary: self)
+    /// Post a drain event. No user data, because the executor is a singleton, so nothing is allocated or retained.
+    private func postDrain() {
+        slint_post_event(Self.drainCallback, nil, nil)
+    }
+
+    /// Callback for the drain event.
+    private static let drainCallback: WrappedClosure.GenericInvokeCallback = { _ in
+        traced(.drain) { SlintEventLoopExecutor.shared.drain() }
+    }
+
+    /// Run queued jobs. Only ever called from the drain event, on the event loop.
+    private func drain() {
+        let executor = asUnownedSerialExecutor()
+        let deadline = monotonicNanoseconds() + drainBudgetNanoseconds
+        traceCounter(.executorQueueDepth, self.queue.approximateCount)
+
+        while true {
+            while let job = queue.pop() {
+                traced(.executorJob) { job.runSynchronously(on: executor) }
+
+                if monotonicNanoseconds() >= deadline {
+                    // Out of time. `drainPending` stays set, so producers keep piggybacking on the next drain.
+                    postDrain()
+                    return
+                }
+            }
+
+            // Looks empty. Either keep going, or a producer will post the next drain.
+            guard drainPending.consumerFoundEmpty(queue) else { return }
+        }
     }
 }
 
@@ -65,24 +272,65 @@ final class SlintEventLoopExecutor: SerialExecutor {
 public struct SlintActor {
     /// Actor that uses the `SlintEventLoopExecutor` singleton to serialize access.
     public actor SlintEventLoop {
-        // Get the value from the file private global variable, so it can be swapped at runtime.
-        public nonisolated var unownedExecutor: UnownedSerialExecutor { _executor }
+        // Always the same executor. Where it sends jobs changes as the loop starts, not the executor itself.
+        public nonisolated var unownedExecutor: UnownedSerialExecutor {
+            SlintEventLoopExecutor.shared.asUnownedSerialExecutor()
+        }
     }
 
     public static var shared = SlintEventLoop()
 }
 
-// Global variables? Oof.
-fileprivate var _executor = MainActor.sharedUnownedExecutor
+/// Fast path for code that's already on the event loop thread, like Slint callbacks and timers.
+public extension SlintActor {
+    /// Run an isolated closure synchronously, on the assumption that the caller is already on the event loop thread.
+    /// Crashes if it isn't.
+    ///
+    /// Slint's callbacks, timers and posted events all run on the event loop thread, but Swift can't tell they're isolated,
+    /// because they aren't running as a job on `SlintEventLoopExecutor`. This is how to tell it.
+    /// The check is one atomic load and `pthread_self()`. Nothing is posted or allocated.
+    ///
+    /// Same as `MainActor.assumeIsolated`, down to the bit cast that drops the isolation from the closure's type.
+    @_unavailableFromAsync(message: "await the call to the @SlintActor closure directly")
+    static func assumeIsolated<T>(
+        _ operation: @SlintActor () throws -> T,
+        file: StaticString = #fileID,
+        line: UInt = #line
+    ) rethrows -> T {
+        typealias Isolated = @SlintActor () throws -> T
+        typealias Nonisolated = () throws -> T
 
-// Switching executor mid-flight seems to work, but this may actually be really stupid and dangerous
-// 💀 YOU HAVE BEEN WARNED 💀
-@MainActor
-func SwitchToMainActorExecutor() {
-    _executor = MainActor.sharedUnownedExecutor
+        precondition(SlintEventLoopExecutor.shared.isIsolatingCurrentContext, "Not on the Slint event loop thread!", file: file, line: line)
+
+        return try withoutActuallyEscaping(operation) { (_ operation: @escaping Isolated) throws -> T in
+            try unsafeBitCast(operation, to: Nonisolated.self)()
+        }
+    }
+
+    /// True if the current thread is the event loop thread, so `assumeIsolated(_:file:line:)` would succeed.
+    static var isIsolated: Bool {
+        SlintEventLoopExecutor.shared.isIsolatingCurrentContext
+    }
+
+    /// Run a closure on the event loop. Inline, before returning, if already on the event loop thread.
+    /// Otherwise it's enqueued on `SlintActor`, and runs on a later turn of the loop.
+    ///
+    /// Unlike `Task { @SlintActor in … }`, this doesn't make a task when it can run inline.
+    static func dispatch(_ work: @escaping @SlintActor @Sendable () -> Void) {
+        if isIsolated {
+            assumeIsolated(work)
+        } else {
+            Task { @SlintActor in work() }
+        }
+    }
 }
 
-@MainActor
-func SwitchToEventLoopExecutor() {
-    _executor = SlintEventLoopExecutor.shared.asUnownedSerialExecutor()
-}
\ No newline at end of file
+/// Current thread's `pthread_t`, as an integer. Never 0.
+@inline(__always)
+fileprivate func currentThreadID() -> UInt {
+    #if canImport(Darwin)
+    UInt(bitPattern: pthread_self())
+    #else
+    UInt(pthread_self())
+    #endif
+}
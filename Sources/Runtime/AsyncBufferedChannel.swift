@@ -0,0 +1,261 @@
+//
+//  AsyncBufferedChannel.swift
+//  slint
+//
+
+// NOTE: Only for `NSLock`.
+import Foundation
+
+/// Asynchronous channel for a stream of values, with a bounded buffer.
+///
+/// Any number of producers, one consumer. Iterate it with `for await`, or call `next()`.
+/// Producers in async code use `send(_:)`, which suspends while the buffer is full. Synchronous code,
+/// like Slint callbacks, uses `trySend(_:)`, which gives up instead.
+///
+/// A producer suspended on a full buffer leaves its element with the channel. As soon as the consumer takes an element,
+/// the oldest suspended producer's element moves into the freed space, so producers are served in order,
+/// and never have to retry. A consumer waiting on an empty buffer gets the next element handed straight to it.
+///
+/// State is guarded by a mutex that's only held for a few instructions, never across a suspension.
+/// Nothing allocates per element, except when producers queue up on a full buffer.
+///
+/// For a single value, see `AsyncChannel`.
+public final class AsyncBufferedChannel<Element>: AsyncSequence {
+    public typealias AsyncIterator = Iterator
+
+    /// Ring buffer of elements.
+    private let buffer: UnsafeMutablePointer<Element>
+    private let capacity: Int
+    private var head = 0
+    private var count = 0
+
+    /// True once `finish()` is called. Buffered elements are still delivered, then iteration ends.
+    private var finished = false
+
+    /// The consumer, if it's waiting on an empty buffer.
+    private var consumer: UnsafeContinuation<Element?, Never>?
+
+    /// A producer waiting on a full buffer, with the element it's trying to send.
+    private struct Producer {
+        let token: Int
+        let element: Element
+        let continuation: UnsafeContinuation<Bool, Error>
+    }
+
+    /// Producers waiting on a full buffer, oldest first, from `producersHead` on.
+    private var producers: [Producer] = []
+    private var producersHead = 0
+    private var nextToken = 0
+
+    /// Guards everything above.
+    private let mutex = NSLock()
+
+    /// Initializer.
+    /// - Parameter capacity: Number of elements that can be buffered before producers have to wait. At least 1.
+    public init(_ elementType: Element.Type = Element.self, capacity: Int) {
+        precondition(capacity > 0, "AsyncBufferedChannel needs room for at least one element!")
+        self.capacity = capacity
+        buffer = .allocate(capacity: capacity)
+    }
+
+    deinit {
+        for i in 0 ..< count {
+            (buffer + (head + i) % capacity).deinitialize(count: 1)
+        }
+        buffer.deallocate()
+    }
+
+    // MARK: Producing
+
+    /// Send an element, suspending while the buffer is full.
+    /// - Returns: True if the element was delivered, or buffered. False if the channel was finished.
+    ///
+    /// Throws `CancellationError` if the task is cancelled while waiting for space. The element is dropped.
+    @discardableResult
+    public func send(_ element: Element) async throws -> Bool {
+        lock()
+        if let delivered = offer(element) {
+            unlock()
+            return delivered
+        }
+        let token = nextToken
+        nextToken += 1
+        unlock()
+
+        return try await withTaskCancellationHandler(operation: {
+            try await withUnsafeThrowingContinuation { continuation in
+                lock()
+
+                // Things may have changed, since the lock was released.
+                if let delivered = offer(element) {
+                    unlock()
+                    continuation.resume(returning: delivered)
+                    return
+                }
+
+                // Same as `AsyncChannel`: the cancellation handler marks the task cancelled before it runs.
+                guard !Task.isCancelled else {
+                    unlock()
+                    continuation.resume(throwing: CancellationError())
+                    return
+                }
+
+                producers.append(Producer(token: token, element: element, continuation: continuation))
+                unlock()
+            }
+        }, onCancel: {
+            cancelProducer(token)
+        })
+    }
+
+    /// Send an element without waiting.
+    /// - Returns: True if the element was delivered, or buffered. False if the buffer was full, or the channel was finished.
+    @discardableResult
+    public func trySend(_ element: Element) -> Bool {
+        lock()
+        let delivered = offer(element) ?? false
+        unlock()
+        return delivered
+    }
+
+    /// End the stream. The consumer gets everything already buffered, then `nil`.
+    /// Producers waiting for space are resumed with `false`, and their elements are dropped.
+    public func finish() {
+        lock()
+        finished = true
+        let waitingConsumer = consumer
+        consumer = nil
+        let waitingProducers = producers[producersHead...]
+        producers = []
+        producersHead = 0
+        unlock()
+
+        waitingConsumer?.resume(returning: nil)
+        for producer in waitingProducers { producer.continuation.resume(returning: false) }
+    }
+
+    /// Try to deliver an element without waiting. Must hold the lock.
+    /// - Returns: Whether it was delivered, or `nil` if the buffer is full, and the caller has to wait.
+    private func offer(_ element: Element) -> Bool? {
+        if finished { return false }
+
+        // The consumer only waits on an empty buffer, so handing over directly keeps elements in order.
+        if let waitingConsumer = consumer {
+            consumer = nil
+            waitingConsumer.resume(returning: element)
+            return true
+        }
+
+        // Anyone already waiting goes first.
+        guard count < capacity, producersHead == producers.count else { return nil }
+
+        (buffer + (head + count) % capacity).initialize(to: element)
+        count += 1
+        return true
+    }
+
+    /// Resume a waiting producer with `CancellationError`, if it's still waiting.
+    private func cancelProducer(_ token: Int) {
+        lock()
+        var found: Producer?
+        if let index = producers[producersHead...].firstIndex(where: { $0.token == token }) {
+            found = producers.remove(at: index)
+        }
+        unlock()
+        found?.continuation.resume(throwing: CancellationError())
+    }
+
+    // MARK: Consuming
+
+    /// Receive the next element, suspending while the buffer is empty.
+    /// - Returns: The element, or `nil` once the channel is finished and drained, or the task is cancelled.
+    ///
+    /// Must only be called from one task at a time.
+    public func next() async -> Element? {
+        lock()
+        if let element = take() {
+            unlock()
+            return element
+        }
+        if finished {
+            unlock()
+            return nil
+        }
+        unlock()
+
+        return await withTaskCancellationHandler(operation: {
+            await withUnsafeContinuation { continuation in
+                lock()
+                precondition(consumer == nil, "AsyncBufferedChannel only supports one consumer!")
+
+                if let element = take() {
+                    unlock()
+                    continuation.resume(returning: element)
+                } else if finished || Task.isCancelled {
+                    unlock()
+                    continuation.resume(returning: nil)
+                } else {
+                    consumer = continuation
+                    unlock()
+                }
+            }
+        }, onCancel: {
+            lock()
+            let waitingConsumer = consumer
+            consumer = nil
+            unlock()
+            waitingConsumer?.resume(returning: nil)
+        })
+    }
+
+    /// Take the oldest buffered element, and let the oldest waiting producer into the freed space. Must hold the lock.
+    private func take() -> Element? {
+        guard count > 0 else { return nil }
+
+        let element = (buffer + head).move()
+        head = (head + 1) % capacity
+        count -= 1
+
+        if producersHead < producers.count {
+            let producer = producers[producersHead]
+            producersHead += 1
+            (buffer + (head + count) % capacity).initialize(to: producer.element)
+            count += 1
+
+            // Resuming only enqueues the producer's task, so it's fine under the lock.
+            producer.continuation.resume(returning: true)
+
+            // Compact once the queue drains, so it doesn't grow forever.
+            if producersHead == producers.count {
+                producers.removeAll(keepingCapacity: true)
+                producersHead = 0
+            }
+        }
+
+        return element
+    }
+
+    // MARK: Locking
+
+    private func lock() {
+        mutex.lock()
+    }
+
+    private func unlock() {
+        mutex.unlock()
+    }
+
+    // MARK: AsyncSequence
+
+    public struct Iterator: AsyncIteratorProtocol {
+        fileprivate let channel: AsyncBufferedChannel
+
+        public mutating func next() async -> Element? {
+            await channel.next()
+        }
+    }
+
+    public func makeAsyncIterator() -> Iterator {
+        Iterator(channel: self)
+    }
+}
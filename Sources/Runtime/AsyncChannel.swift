@@ -4,20 +4,61 @@
 //
 //  Borrowed by Matthew Taylor on 2/13/24.
 //  Original: https://github.com/alexito4/AsyncChannel
+//
+//  Rewritten without the actor: reads and sends used to spawn a `Task` each, and allocate a `UUID` per read.
+//
 
+// NOTE: Only for `NSLock`.
 import Foundation
 
+import Atomics
+
 /// Asynchronous channel, allowing synchronous code to pass values to async code.
 /// This is used for passing values from the Slint event loop back to the main Swift code before
 /// the event loop is running and `SlintActor` is available.
 ///
 /// See: https://alejandromp.com/blog/building-a-channel-with-swift-concurrency-continuations/
 ///
+/// The phase hangs off one atomic state word:
+///
+///     bits 0–1    phase: pending, fulfilled, or cancelled
+///     bits 2–63   counter, for tokens that identify waiters
+///
+/// Reading a value that's already been sent is a single acquiring load, and taking a token is one atomic add.
+/// Only waiting, sending and cancelling take a mutex, to change the waiters and the phase together.
+/// It parks rather than spins, so a contended channel doesn't burn an oversubscribed CPU.
+/// The first waiter is stored inline, so the common case of one reader doesn't allocate.
+/// `send(_:)` resumes waiters synchronously, on the sending thread.
+///
+/// For a stream of values, see `AsyncBufferedChannel`.
 public final class AsyncChannel<T> {
-    private let buffer = Buffer()
+    /// State word. See the type's documentation for the layout.
+    private let state = ManagedAtomic<Int>(0)
+
+    private static var phaseMask: Int { 0b11 }
+    private static var pending: Int { 0b00 }
+    private static var fulfilled: Int { 0b01 }
+    private static var cancelled: Int { 0b10 }
+    private static var tokenShift: Int { 2 }
+
+    /// Guards the waiters. The phase only changes while it's held.
+    private let mutex = NSLock()
+
+    /// The value. Written once under the lock, before the phase is published as fulfilled. Never written again.
+    private var storedValue: T?
+
+    /// A suspended `value` read, and the token its cancellation handler uses to find it.
+    private struct Waiter {
+        let token: Int
+        let continuation: UnsafeContinuation<T, Error>
+    }
+
+    /// Waiters. Guarded by the lock. The first is inline, so a single reader doesn't allocate.
+    private var firstWaiter: Waiter?
+    private var moreWaiters: [Waiter] = []
 
     /// Initializer. Allows you to specify the type as an argument to the constructor.
-    /// 
+    ///
     /// ```swift
     /// let channel = AsyncChannel(Int.self)
     /// ```
@@ -25,21 +66,49 @@ public final class AsyncChannel<T> {
 
     /// Get the value asynchronously.
     /// This returns the value immediatly if already available, or will await until it's received.
+    ///
+    /// Throws `CancellationError` if the task is cancelled before the value arrives, or the channel is cancelled.
     public var value: T {
         get async throws {
-            let id = UUID()
+            try Task.checkCancellation()
+
+            // Fast path. Pairs with the releasing publish in `send(_:)`.
+            if state.load(ordering: .acquiring) & Self.phaseMask == Self.fulfilled {
+                return storedValue!
+            }
+
+            // Taking a token doesn't need the lock. It only adds to the counter bits.
+            let token = state.loadThenWrappingIncrement(by: 1 << Self.tokenShift, ordering: .relaxed) >> Self.tokenShift
+
             return try await withTaskCancellationHandler(operation: {
-                try Task.checkCancellation()
-                return try await withCheckedThrowingContinuation { continuation in
-                    guard !Task.isCancelled else { return }
-                    Task {
-                        await buffer.addContinuationIfNeeded(continuation, id)
+                try await withUnsafeThrowingContinuation { continuation in
+                    switch lock() {
+                    case Self.fulfilled:
+                        unlock()
+                        continuation.resume(returning: storedValue!)
+                    case Self.cancelled:
+                        unlock()
+                        continuation.resume(throwing: CancellationError())
+                    default:
+                        // The cancellation handler may have run already, and found nothing to cancel.
+                        // It marks the task cancelled before it runs, so checking under the lock can't miss it.
+                        guard !Task.isCancelled else {
+                            unlock()
+                            continuation.resume(throwing: CancellationError())
+                            return
+                        }
+
+                        let waiter = Waiter(token: token, continuation: continuation)
+                        if firstWaiter == nil {
+                            firstWaiter = waiter
+                        } else {
+                            moreWaiters.append(waiter)
+                        }
+                        unlock()
                     }
                 }
             }, onCancel: {
-                Task {
-                    await buffer.cancelContinuation(id)
-                }
+                cancelWaiter(token)
             })
         }
     }
@@ -49,85 +118,84 @@ public final class AsyncChannel<T> {
     /// It will also cache it internally so any subsequent `get` receives it immediatly.
     /// - Note: Only 1 value should be provided.
     public func send(_ v: T) {
-        Task {
-            await buffer.send(v)
+        let phase = lock()
+        guard phase != Self.cancelled else {
+            unlock()
+            return
         }
+        assert(phase == Self.pending, "AsyncChannel should only receive 1 value.")
+        guard phase == Self.pending else {
+            unlock()
+            return
+        }
+
+        storedValue = v
+        let (first, more) = takeWaiters()
+        unlock(publishing: Self.fulfilled, over: phase)
+
+        // Resume outside the lock. Resuming only enqueues each task, it doesn't run it here.
+        first?.continuation.resume(returning: v)
+        for waiter in more { waiter.continuation.resume(returning: v) }
     }
 
     /// Removes every awaiting method and stops sending any values.
     public func cancel() {
-        Task {
-            await buffer.cancel()
+        let phase = lock()
+        guard phase == Self.pending else {
+            unlock()
+            return
         }
-    }
-}
-
-// MARK: Internal Buffer
 
-extension AsyncChannel {
-    actor Buffer {
-        enum State {
-            case pending
-            case fulfilled(T)
-            case cancelled
-
-            var isPending: Bool {
-                if case .pending = self {
-                    return true
-                }
-                return false
-            }
+        let (first, more) = takeWaiters()
+        unlock(publishing: Self.cancelled, over: phase)
 
-            var isCancelled: Bool {
-                if case .cancelled = self {
-                    return true
-                }
-                return false
-            }
-
-            var value: T? {
-                if case let .fulfilled(value) = self {
-                    return value
-                }
-                return nil
-            }
-        }
+        first?.continuation.resume(throwing: CancellationError())
+        for waiter in more { waiter.continuation.resume(throwing: CancellationError()) }
+    }
 
-        private var continuations = [UUID: CheckedContinuation<T, Error>]()
-        private var state: State = .pending
+    // MARK: Locking
 
-        func addContinuationIfNeeded(_ continuation: CheckedContinuation<T, Error>, _ id: UUID) {
-            assert(!state.isCancelled)
+    /// Take the lock. Never held across a suspension.
+    /// - Returns: The phase, as of taking the lock. It only changes under the lock, so a relaxed load is enough.
+    private func lock() -> Int {
+        mutex.lock()
+        return state.load(ordering: .relaxed) & Self.phaseMask
+    }
 
-            if let value = state.value {
-                continuation.resume(returning: value)
-                return
-            }
+    /// Release the lock, without changing the phase.
+    private func unlock() {
+        mutex.unlock()
+    }
 
-            continuations[id] = continuation
-        }
+    /// Change the phase, then release the lock.
+    /// Adding, rather than storing, leaves the token counter alone, in case someone took a token meanwhile.
+    private func unlock(publishing phase: Int, over previous: Int) {
+        state.wrappingIncrement(by: phase - previous, ordering: .releasing)
+        mutex.unlock()
+    }
 
-        func cancelContinuation(_ id: UUID) {
-            continuations[id]?.resume(throwing: CancellationError())
-            continuations[id] = nil
-        }
+    /// Remove every waiter. Must hold the lock.
+    private func takeWaiters() -> (Waiter?, [Waiter]) {
+        let taken = (firstWaiter, moreWaiters)
+        firstWaiter = nil
+        moreWaiters = []
+        return taken
+    }
 
-        func send(_ v: T) {
-            guard !state.isCancelled else { return }
-            assert(state.isPending, "AsyncChannel should only receive 1 value.")
+    /// Resume a single waiter with `CancellationError`, if it's still waiting.
+    private func cancelWaiter(_ token: Int) {
+        _ = lock()
 
-            state = .fulfilled(v)
-            continuations.values.forEach { $0.resume(returning: v) }
-            continuations.removeAll()
+        var found: Waiter?
+        if firstWaiter?.token == token {
+            found = firstWaiter
+            firstWaiter = moreWaiters.isEmpty ? nil : moreWaiters.removeFirst()
+        } else if let index = moreWaiters.firstIndex(where: { $0.token == token }) {
+            found = moreWaiters.remove(at: index)
         }
 
-        func cancel() {
-            state = .cancelled
-            continuations.values.forEach { continuation in
-                continuation.resume(throwing: CancellationError())
-            }
-            continuations.removeAll()
-        }
+        unlock()
+        found?.continuation.resume(throwing: CancellationError())
     }
 }
 
@@ -147,6 +215,6 @@ extension AsyncChannel {
 extension AsyncChannel where T == Void {
     // Convience method for when the value is unimportant.
     public func send() {
-        Task { await buffer.send(()) }
+        send(())
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,19 @@
+//
+//  Clock.swift
+//  slint
+//
+
+// DispatchTime is backed by the monotonic clock on every platform we care about.
+import Dispatch
+
+/// Monotonic time in nanoseconds. Cheap enough to call once per job.
+@inline(__always)
+func monotonicNanoseconds() -> UInt64 {
+    DispatchTime.now().uptimeNanoseconds
+}
+
+/// Monotonic time in milliseconds. Slint measures all of its timers in milliseconds.
+@inline(__always)
+func monotonicMilliseconds() -> UInt64 {
+    monotonicNanoseconds() / 1_000_000
+}
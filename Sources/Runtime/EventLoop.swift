@@ -31,27 +31,49 @@ class EventLoop {
     // Signal that the event loop is now running.
     private var started = AsyncChannel(Void.self)
 
+    // Signal that the event loop has stopped.
+    private var stopped = AsyncChannel(Void.self)
+
     /// Await this value to suspend until the event loop is running.
     public static var ready: Void {
         get async { try! await shared.started.value }
     }
+
+    /// Await this value to suspend until the event loop has stopped.
+    public static var finished: Void {
+        get async { try! await shared.stopped.value }
+    }
     
     /// Start the main event loop. This WILL block the main thread for the rest of the program!
     @MainActor
     public static func start() {
+        run()
+    }
+
+    /// Run the event loop on the current thread, until it stops.
+    /// Slint's state is per thread, so everything Slint must be on this thread, including `start()`.
+    static func run() {
+        // The loop runs on this thread. From here on, `SlintActor.assumeIsolated` checks for it.
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+
         startBeforeLoopRunning {
+            SlintEventLoopExecutor.shared.loopStarted()
             shared.started.send()
         }
 
-        print("Starting event loop.")
+        traceInstant(.eventLoop)
         slint_run_event_loop(false)
+        traceInstant(.eventLoop)
+
+        // Still on the loop's thread, but nothing posted from here on will run, so stop the scheduler inline.
+        SlintActor.assumeIsolated { WakeupScheduler.shared.stop() }
+        shared.stopped.send()
     }
 
     /// Stop the event loop. Currently crashes, IDK.
     @SlintActor
     public static func stop() {
         slint_quit_event_loop()
-        print("Event loop has stopped.")
     }
 }
 
@@ -0,0 +1,161 @@
+//
+//  JobQueue.swift
+//  slint
+//
+
+/// See: [Bounded MPMC queue, by Dmitry Vyukov](https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+
+import Atomics
+
+/// Bounded, lock-free queue with many producers and a single consumer.
+///
+/// Producers (any thread) claim a slot with one compare-exchange, write the element, then publish it by bumping the slot's
+/// sequence number. The consumer (the Slint event loop) reads slots in order without any atomic read-modify-write.
+///
+/// Storage is allocated once, up front. Pushing and popping never allocate.
+///
+/// Note: `pop()` may return `nil` while a producer is half-way through a `push(_:)`.
+/// Callers must not treat `nil` as "nothing will ever arrive". See `SlintEventLoopExecutor` for how that's handled.
+final class JobQueue<Element> {
+    /// Number of slots. Always a power of two.
+    let capacity: Int
+
+    /// `capacity - 1`, for turning positions into slot indices.
+    private let mask: Int
+
+    /// Per-slot sequence numbers. A slot is free for position `p` when its sequence is `p`,
+    /// and holds the element for position `p` when its sequence is `p + 1`.
+    private let sequences: UnsafeMutablePointer<UnsafeAtomic<Int>.Storage>
+
+    /// Per-slot element storage. Only initialized between a push and the matching pop.
+    private let elements: UnsafeMutablePointer<Element>
+
+    /// Next position a producer will claim. Shared between producers.
+    private let enqueuePosition = ManagedAtomic<Int>(0)
+
+    /// Next position the consumer will read. Only touched by the consumer.
+    private var dequeuePosition = 0
+
+    /// Initializer. Allocates all storage.
+    /// - Parameter minimumCapacity: Minimum number of elements that can be queued. Rounded up to a power of two.
+    init(minimumCapacity: Int) {
+        precondition(minimumCapacity > 0, "JobQueue needs room for at least one element!")
+
+        var capacity = 1
+        while capacity < minimumCapacity { capacity <<= 1 }
+
+        self.capacity = capacity
+        self.mask = capacity - 1
+
+        sequences = .allocate(capacity: capacity)
+        for index in 0 ..< capacity {
+            (sequences + index).initialize(to: UnsafeAtomic<Int>.Storage(index))
+        }
+
+        elements = .allocate(capacity: capacity)
+    }
+
+    /// Deinitializer. Drops anything still queued and frees storage.
+    deinit {
+        while pop() != nil { }
+
+        for index in 0 ..< capacity {
+            _ = (sequences + index).move().dispose()
+        }
+        sequences.deallocate()
+        elements.deallocate()
+    }
+
+    /// Atomic view of a slot's sequence number.
+    @inline(__always)
+    private func sequence(_ slot: Int) -> UnsafeAtomic<Int> {
+        UnsafeAtomic(at: sequences + slot)
+    }
+
+    /// Add an element. Safe to call from any thread.
+    /// - Returns: `false` if the queue is full. The element is not queued in that case.
+    func push(_ element: Element) -> Bool {
+        var position = enqueuePosition.load(ordering: .relaxed)
+
+        while true {
+            let slot = position & mask
+            let difference = sequence(slot).load(ordering: .acquiring) - position
+
+            if difference == 0 {
+                // Slot is free for this position. Try to claim it.
+                let (claimed, current) = enqueuePosition.weakCompareExchange(
+                    expected: position,
+                    desired: position + 1,
+                    ordering: .relaxed
+                )
+                if claimed { break }
+                position = current
+            } else if difference < 0 {
+                // The consumer hasn't freed this slot from the previous lap. Full.
+                return false
+            } else {
+                // Another producer got here first.
+                position = enqueuePosition.load(ordering: .relaxed)
+            }
+        }
+
+        let slot = position & mask
+        (elements + slot).initialize(to: element)
+        sequence(slot).store(position + 1, ordering: .releasing)
+        return true
+    }
+
+    /// Remove the oldest published element. Only the single consumer may call this.
+    /// - Returns: The element, or `nil` if nothing is published yet.
+    func pop() -> Element? {
+        let position = dequeuePosition
+        let slot = position & mask
+
+        guard sequence(slot).load(ordering: .acquiring) == position + 1 else { return nil }
+
+        let element = (elements + slot).move()
+        sequence(slot).store(position + capacity, ordering: .releasing)
+        dequeuePosition = position + 1
+        return element
+    }
+
+    /// Number of elements claimed, but not yet popped, including any still being written. Only meaningful on the consumer.
+    var approximateCount: Int {
+        enqueuePosition.load(ordering: .relaxed) - dequeuePosition
+    }
+
+    /// True if an element is published and ready to pop. Only meaningful on the consumer.
+    var hasPublishedElement: Bool {
+        let position = dequeuePosition
+        return sequence(position & mask).load(ordering: .acquiring) == position + 1
+    }
+}
+
+/// The flag that keeps exactly one drain of a `JobQueue` in flight, without ever stranding a pushed element.
+///
+/// Set while a drain is posted, or running. A producer that sets it posts a drain; everyone else piggybacks on that one.
+/// Both sides use sequentially consistent exchanges, so a push can't be reordered with the producer's exchange,
+/// and the consumer's clear can't be reordered with its last look at the queue.
+struct DrainHandshake {
+    private let pending = ManagedAtomic<Bool>(false)
+
+    /// Call after pushing.
+    /// - Returns: True if this producer set the flag, and has to post a drain.
+    func producerPushed() -> Bool {
+        !pending.exchange(true, ordering: .sequentiallyConsistent)
+    }
+
+    /// Call once the consumer has popped everything it could.
+    ///
+    /// A producer may have pushed after the last `pop()`, but seen the flag still set, and not posted.
+    /// So the flag's cleared, then the queue's checked again: either the consumer sees that element here,
+    /// or the producer sees the cleared flag, and posts a new drain itself.
+    /// - Returns: True if the consumer should keep draining. False if it's done, and the flag is clear,
+    ///   or a producer has taken it, and posted the next drain.
+    func consumerFoundEmpty<Element>(_ queue: JobQueue<Element>) -> Bool {
+        _ = pending.exchange(false, ordering: .sequentiallyConsistent)
+        guard queue.hasPublishedElement else { return false }
+        // Something arrived. Take the flag back, unless a producer already did, and posted a drain.
+        return !pending.exchange(true, ordering: .sequentiallyConsistent)
+    }
+}
@@ -0,0 +1,273 @@
+//
+//  TimingWheel.swift
+//  slint
+//
+
+/// See: [Hashed and Hierarchical Timing Wheels, by Varghese & Lauck](http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf)
+
+/// Hierarchical timing wheel. Tracks deadlines for integer IDs, and reports which ones have expired.
+///
+/// Time is measured in ticks (`SlintTimerService` uses milliseconds). There are 11 levels of 64 slots,
+/// enough to cover the whole `UInt64` range. A deadline goes in the lowest level where it shares
+/// every higher digit (base 64) with the current tick. When the wheel reaches the start of a slot on a higher level,
+/// that slot's entries are cascaded down, until they land on level 0, where they expire.
+///
+/// Scheduling and cancelling are O(1). Advancing skips empty stretches using a bitmap per level,
+/// so idle time costs nothing, no matter how long it is.
+///
+/// Entries are linked through arrays indexed by ID, so nothing is allocated per entry once the arrays have grown.
+struct TimingWheel {
+    /// Number of levels. 11 × 6 bits covers all 64 bits of a tick.
+    static let levels = 11
+
+    /// Slots per level, and bits of the tick each level covers.
+    static let slotsPerLevel = 64
+    static let bitsPerLevel = 6
+
+    /// Sentinel for "no entry".
+    private static let none = -1
+
+    /// Next tick to process. Everything before this has been processed.
+    private(set) var current: UInt64
+
+    /// Number of scheduled IDs.
+    private(set) var count = 0
+
+    /// Per-ID state. Indexed by ID. Grown on demand.
+    private var deadlines: [UInt64] = []
+    private var nextInSlot: [Int] = []
+    private var previousInSlot: [Int] = []
+    /// Slot an ID is linked into, or `none` if it isn't scheduled.
+    private var slotOf: [Int] = []
+
+    /// First ID in each slot, or `none`. Indexed by `level * slotsPerLevel + index`.
+    private var heads = [Int](repeating: none, count: levels * slotsPerLevel)
+
+    /// Bit `i` of `occupancy[level]` is set if slot `i` on that level is non-empty.
+    private var occupancy = [UInt64](repeating: 0, count: levels)
+
+    /// Initializer.
+    /// - Parameter tick: The current tick. Deadlines before this expire on the next `advance(to:into:)`.
+    init(startingAt tick: UInt64) {
+        current = tick
+    }
+
+    /// True if an ID is scheduled.
+    func isScheduled(_ id: Int) -> Bool {
+        id < slotOf.count && slotOf[id] != Self.none
+    }
+
+    /// Deadline an ID is scheduled for, or `nil` if it isn't.
+    func deadline(of id: Int) -> UInt64? {
+        isScheduled(id) ? deadlines[id] : nil
+    }
+
+    /// Schedule an ID. If it's already scheduled, it's moved to the new deadline.
+    /// - Parameters:
+    ///   - id: Non-negative ID. IDs should be dense, as storage grows to the largest ID.
+    ///   - deadline: Tick at which the ID expires. Deadlines in the past expire on the next advance.
+    mutating func schedule(_ id: Int, at deadline: UInt64) {
+        precondition(id >= 0, "TimingWheel IDs must be non-negative!")
+
+        if id >= slotOf.count {
+            let grown = max(id + 1, slotOf.count * 2, 64)
+            let extra = grown - slotOf.count
+            deadlines.append(contentsOf: repeatElement(0, count: extra))
+            nextInSlot.append(contentsOf: repeatElement(Self.none, count: extra))
+            previousInSlot.append(contentsOf: repeatElement(Self.none, count: extra))
+            slotOf.append(contentsOf: repeatElement(Self.none, count: extra))
+        }
+
+        if slotOf[id] != Self.none {
+            unlink(id)
+        } else {
+            count += 1
+        }
+
+        deadlines[id] = max(deadline, current)
+        link(id)
+    }
+
+    /// Unschedule an ID. Does nothing if it isn't scheduled.
+    mutating func cancel(_ id: Int) {
+        guard isScheduled(id) else { return }
+        unlink(id)
+        count -= 1
+    }
+
+    /// Earliest scheduled deadline, or `nil` if nothing is scheduled.
+    func nextDeadline() -> UInt64? {
+        // Lower levels always expire before higher ones, so the first level with a pending slot holds the answer.
+        for level in 0 ..< Self.levels {
+            guard let (slot, start) = nextSlot(on: level) else { continue }
+
+            // Everything on level 0 expires exactly at its slot's start.
+            guard level > 0 else { return start }
+
+            // Higher slots span many ticks. Find the earliest entry in this one.
+            var earliest = UInt64.max
+            var id = heads[slot]
+            while id != Self.none {
+                earliest = min(earliest, deadlines[id])
+                id = nextInSlot[id]
+            }
+            return earliest
+        }
+        return nil
+    }
+
+    /// Process every tick up to and including `tick`.
+    /// - Parameters:
+    ///   - tick: Tick to advance to.
+    ///   - expired: Expired IDs are appended to this, in deadline order. They are no longer scheduled.
+    mutating func advance(to tick: UInt64, into expired: inout [Int]) {
+        while let next = nextEvent(), next <= tick {
+            move(to: next)
+
+            // Everything in the current level 0 slot has expired.
+            var id = detach(Self.slot(for: current, on: 0))
+            while id != Self.none {
+                let following = nextInSlot[id]
+                slotOf[id] = Self.none
+                count -= 1
+                expired.append(id)
+                id = following
+            }
+        }
+
+        // Nothing else is due by `tick`, so skipping ahead doesn't pass the start of any occupied slot.
+        if tick >= current && tick < .max { move(to: tick + 1) }
+    }
+
+    /// Set the current tick, and cascade every higher slot that starts there.
+    ///
+    /// This keeps an invariant `nextDeadline()` relies on: no higher slot that starts at or before `current` holds anything.
+    /// Otherwise, an entry from an earlier lap could sit in a level 1 slot starting at `current`,
+    /// while a later entry sits on level 0.
+    private mutating func move(to tick: UInt64) {
+        current = tick
+
+        // From the top down, so entries can fall through several levels in one go.
+        for level in stride(from: Self.levels - 1, to: 0, by: -1) where Self.isSlotStart(current, level) {
+            var id = detach(Self.slot(for: current, on: level))
+            while id != Self.none {
+                let following = nextInSlot[id]
+                link(id)
+                id = following
+            }
+        }
+    }
+
+    // MARK: Slot arithmetic
+
+    /// Shift for a level's digit.
+    @inline(__always)
+    private static func shift(_ level: Int) -> UInt64 {
+        UInt64(level * bitsPerLevel)
+    }
+
+    /// Mask of the tick bits below a level's digit.
+    @inline(__always)
+    private static func lowMask(_ level: Int) -> UInt64 {
+        level == 0 ? 0 : (1 << shift(level)) - 1
+    }
+
+    /// Mask of the tick bits up to and including a level's digit.
+    @inline(__always)
+    private static func blockMask(_ level: Int) -> UInt64 {
+        let bits = shift(level) + UInt64(bitsPerLevel)
+        return bits >= 64 ? .max : (1 << bits) - 1
+    }
+
+    /// True if a tick is the first tick of a slot on a level.
+    @inline(__always)
+    private static func isSlotStart(_ tick: UInt64, _ level: Int) -> Bool {
+        tick & lowMask(level) == 0
+    }
+
+    /// Slot a tick falls into, on a level.
+    @inline(__always)
+    private static func slot(for tick: UInt64, on level: Int) -> Int {
+        level * slotsPerLevel + Int((tick >> shift(level)) & UInt64(slotsPerLevel - 1))
+    }
+
+    /// Level a deadline belongs on: the highest base 64 digit where it differs from the current tick.
+    @inline(__always)
+    private func level(for deadline: UInt64) -> Int {
+        let difference = deadline ^ current
+        guard difference != 0 else { return 0 }
+        return (63 - difference.leadingZeroBitCount) / Self.bitsPerLevel
+    }
+
+    /// First occupied slot on a level whose start hasn't been processed yet.
+    /// - Returns: The slot, and the tick it starts at.
+    private func nextSlot(on level: Int) -> (slot: Int, start: UInt64)? {
+        let bits = occupancy[level]
+        guard bits != 0 else { return nil }
+
+        // The slot `current` is in has already been processed, unless `current` is exactly its start.
+        // (On higher levels, `move(to:)` cascades it straight away, so it's empty anyway.)
+        let index = Int((current >> Self.shift(level)) & UInt64(Self.slotsPerLevel - 1))
+        let first = Self.isSlotStart(current, level) ? index : index + 1
+        guard first < Self.slotsPerLevel else { return nil }
+
+        let pending = bits & (UInt64.max << UInt64(first))
+        guard pending != 0 else { return nil }
+
+        let found = pending.trailingZeroBitCount
+        let start = (current & ~Self.blockMask(level)) | (UInt64(found) << Self.shift(level))
+        return (level * Self.slotsPerLevel + found, start)
+    }
+
+    /// Next tick where something expires or cascades.
+    private func nextEvent() -> UInt64? {
+        var earliest: UInt64?
+        for level in 0 ..< Self.levels {
+            if let (_, start) = nextSlot(on: level) {
+                earliest = min(earliest ?? .max, start)
+            }
+        }
+        return earliest
+    }
+
+    // MARK: Linking
+
+    /// Link a scheduled ID into the slot for its deadline.
+    private mutating func link(_ id: Int) {
+        let level = level(for: deadlines[id])
+        let slot = Self.slot(for: deadlines[id], on: level)
+
+        let head = heads[slot]
+        nextInSlot[id] = head
+        previousInSlot[id] = Self.none
+        if head != Self.none { previousInSlot[head] = id }
+        heads[slot] = id
+        slotOf[id] = slot
+
+        occupancy[level] |= 1 << UInt64(slot % Self.slotsPerLevel)
+    }
+
+    /// Unlink an ID from its slot.
+    private mutating func unlink(_ id: Int) {
+        let slot = slotOf[id]
+        let next = nextInSlot[id]
+        let previous = previousInSlot[id]
+
+        if previous != Self.none { nextInSlot[previous] = next } else { heads[slot] = next }
+        if next != Self.none { previousInSlot[next] = previous }
+
+        slotOf[id] = Self.none
+        if heads[slot] == Self.none {
+            occupancy[slot / Self.slotsPerLevel] &= ~(1 << UInt64(slot % Self.slotsPerLevel))
+        }
+    }
+
+    /// Empty a slot.
+    /// - Returns: The first ID that was in it. The rest follow through `nextInSlot`.
+    private mutating func detach(_ slot: Int) -> Int {
+        let head = heads[slot]
+        heads[slot] = Self.none
+        occupancy[slot / Self.slotsPerLevel] &= ~(1 << UInt64(slot % Self.slotsPerLevel))
+        return head
+    }
+}
@@ -0,0 +1,303 @@
+//
+//  Tracing.swift
+//  slint
+//
+
+/// See: [Trace Event Format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU)
+
+// For `NSLock`, `pthread_key_t`, and `String(format:)`.
+import Foundation
+
+import Atomics
+
+import SlintFFI
+
+/// Opt-in tracing of what the event loop spends its time on.
+///
+/// While enabled, each thread records into its own ring buffer: event loop turns, executor jobs and queue depth,
+/// closure and callback trampolines, timer fires, and Slint's timer and animation updates.
+/// Recording takes two clock reads and a store, with no locks. Disabled, each trace point is one relaxed atomic load.
+///
+/// ```swift
+/// SlintTracing.start()
+/// // … use the app …
+/// SlintTracing.stop()
+/// try SlintTracing.chromeTraceJSON().write(toFile: "trace.json", atomically: true, encoding: .utf8)
+/// print(SlintTracing.summary())
+/// ```
+///
+/// Open the JSON in `chrome://tracing`, or Perfetto. Buffers are fixed size, so only the newest events are kept.
+/// Reading while threads are still recording is safe, but drops events that were overwritten while being read.
+public enum SlintTracing {
+    /// What a trace event measured.
+    public enum Category: UInt8, CaseIterable, CustomStringConvertible {
+        /// One turn of the event loop, from waking until it sleeps again. Only from `HeadlessPlatform` and `EpollPlatform`,
+        /// which own their loops. With Slint's own backends, `drain` events stand in for turns.
+        case eventLoopTurn
+        /// One drain event of `SlintEventLoopExecutor`, running a batch of jobs.
+        case drain
+        /// One job run by `SlintEventLoopExecutor`.
+        case executorJob
+        /// Jobs waiting in the executor's queue, when a drain starts. A counter, not a duration.
+        case executorQueueDepth
+        /// A `WrappedClosure` invoked by Slint, e.g. a posted event.
+        case closure
+        /// A `SlintCallback` handler invoked by Slint.
+        case callback
+        /// A `SlintTimer`, or a timer scheduled on `SlintTimerService`, firing.
+        case timer
+        /// `slint_platform_update_timers_and_animations`.
+        case updateTimersAndAnimations
+        /// The event loop starting, or stopping. Instants.
+        case eventLoop
+
+        public var description: String {
+            switch self {
+            case .eventLoopTurn: "event loop turn"
+            case .drain: "executor drain"
+            case .executorJob: "executor job"
+            case .executorQueueDepth: "executor queue depth"
+            case .closure: "closure"
+            case .callback: "callback"
+            case .timer: "timer"
+            case .updateTimersAndAnimations: "update timers and animations"
+            case .eventLoop: "event loop"
+            }
+        }
+    }
+
+    /// One recorded event.
+    public struct Event {
+        public enum Kind: UInt8 { case span, counter, instant }
+
+        public var category: Category
+        public var kind: Kind
+        /// Monotonic nanoseconds, when it started.
+        public var start: UInt64
+        /// Nanoseconds for a span, the value for a counter, or 0.
+        public var value: UInt64
+    }
+
+    /// Percentiles of one category. Durations in nanoseconds; for counters, the counted values.
+    public struct Summary: CustomStringConvertible {
+        public var count: Int
+        public var p50: UInt64
+        public var p99: UInt64
+        public var max: UInt64
+        public var total: UInt64
+
+        public var description: String {
+            "count \(count), p50 \(p50), p99 \(p99), max \(max)"
+        }
+    }
+
+    /// Events each thread keeps. Takes effect for threads that record their first event after it's set.
+    public static var bufferCapacity: Int {
+        get { TraceBuffer.capacity.load(ordering: .relaxed) }
+        set { TraceBuffer.capacity.store(newValue, ordering: .relaxed) }
+    }
+
+    public static var isEnabled: Bool {
+        tracingEnabled.load(ordering: .relaxed)
+    }
+
+    /// Start recording, from any thread. Events recorded earlier are kept, unless `reset()` is called.
+    public static func start() {
+        tracingEnabled.store(true, ordering: .releasing)
+    }
+
+    /// Stop recording. Recorded events are kept.
+    public static func stop() {
+        tracingEnabled.store(false, ordering: .releasing)
+    }
+
+    /// Forget every recorded event.
+    public static func reset() {
+        for buffer in TraceBuffer.all { buffer.clear() }
+    }
+
+    /// Recorded events, per thread, oldest first.
+    public static func events() -> [(thread: Int, events: [Event])] {
+        TraceBuffer.all.map { ($0.thread, $0.snapshot()) }
+    }
+
+    /// Recorded events, as Chrome trace event JSON. Spans are complete ("X") events, counters "C", and instants "i",
+    /// with one track per thread. Timestamps are microseconds since the earliest event.
+    public static func chromeTraceJSON() -> String {
+        let threads = events()
+        let eventLoopThread = TraceBuffer.all.first { $0.isEventLoop }?.thread
+        let origin = threads.lazy.compactMap { $0.events.first?.start }.min() ?? 0
+        func microseconds(_ nanoseconds: UInt64) -> String {
+            String(format: "%.3f", Double(nanoseconds) / 1_000)
+        }
+
+        var lines: [String] = []
+        for (thread, events) in threads {
+            let name = thread == eventLoopThread ? "Slint event loop" : "thread \(thread)"
+            lines.append(#"{"name":"thread_name","ph":"M","pid":1,"tid":\#(thread),"args":{"name":"\#(name)"}}"#)
+            for event in events {
+                let common = #""name":"\#(event.category)","cat":"slint","pid":1,"tid":\#(thread),"ts":\#(microseconds(event.start - origin))"#
+                switch event.kind {
+                case .span:
+                    lines.append(#"{\#(common),"ph":"X","dur":\#(microseconds(event.value))}"#)
+                case .counter:
+                    lines.append(#"{\#(common),"ph":"C","args":{"value":\#(event.value)}}"#)
+                case .instant:
+                    lines.append(#"{\#(common),"ph":"i","s":"t"}"#)
+                }
+            }
+        }
+        return "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" + lines.joined(separator: ",\n") + "\n]}\n"
+    }
+
+    /// Percentiles per category, over every thread. Instants are only counted.
+    public static func summary() -> [Category: Summary] {
+        var values: [Category: [UInt64]] = [:]
+        for (_, events) in events() {
+            for event in events { values[event.category, default: []].append(event.value) }
+        }
+
+        return values.mapValues { values in
+            let sorted = values.sorted()
+            func at(_ p: Double) -> UInt64 { sorted[Int((Double(sorted.count - 1) * p / 100).rounded())] }
+            return Summary(count: sorted.count, p50: at(50), p99: at(99), max: sorted.last!, total: sorted.reduce(0, +))
+        }
+    }
+}
+
+// MARK: - Trace points
+
+/// Whether trace points record. Checked on every one, so it's a plain relaxed load.
+let tracingEnabled = ManagedAtomic<Bool>(false)
+
+/// Start of a span: the time, if tracing is enabled, or 0. Pass it to `traceEnd(_:_:)`.
+@inline(__always)
+func traceBegin() -> UInt64 {
+    tracingEnabled.load(ordering: .relaxed) ? monotonicNanoseconds() : 0
+}
+
+/// End a span started with `traceBegin()`. Does nothing if tracing was disabled when it began.
+@inline(__always)
+func traceEnd(_ category: SlintTracing.Category, _ start: UInt64) {
+    if start != 0 {
+        TraceBuffer.current.record(SlintTracing.Event(category: category, kind: .span, start: start, value: monotonicNanoseconds() - start))
+    }
+}
+
+/// Record how long `body` takes.
+@inline(__always)
+func traced<R>(_ category: SlintTracing.Category, _ body: () throws -> R) rethrows -> R {
+    let start = traceBegin()
+    defer { traceEnd(category, start) }
+    return try body()
+}
+
+/// Record a counter's value.
+@inline(__always)
+func traceCounter(_ category: SlintTracing.Category, _ value: @autoclosure () -> Int) {
+    if tracingEnabled.load(ordering: .relaxed) {
+        TraceBuffer.current.record(SlintTracing.Event(category: category, kind: .counter, start: monotonicNanoseconds(), value: UInt64(max(value(), 0))))
+    }
+}
+
+/// Record that something happened.
+@inline(__always)
+func traceInstant(_ category: SlintTracing.Category) {
+    if tracingEnabled.load(ordering: .relaxed) {
+        TraceBuffer.current.record(SlintTracing.Event(category: category, kind: .instant, start: monotonicNanoseconds(), value: 0))
+    }
+}
+
+/// `slint_platform_update_timers_and_animations`, traced. Every platform calls this instead.
+@inline(__always)
+func updateTimersAndAnimations() {
+    traced(.updateTimersAndAnimations) { slint_platform_update_timers_and_animations() }
+}
+
+// MARK: - Buffers
+
+/// One thread's events. Only that thread writes; any thread may read.
+///
+/// `written` counts every event ever recorded, and the newest `capacity` are in `events`, at `written % capacity`.
+/// A reader copies what's there, then reads `written` again, and drops whatever the writer may have overwritten meanwhile.
+final class TraceBuffer {
+    static let capacity = ManagedAtomic<Int>(65_536)
+
+    /// Every thread's buffer, including threads that have exited, so their events can still be read.
+    private static let lock = NSLock()
+    private static var buffers: [TraceBuffer] = []
+
+    static var all: [TraceBuffer] {
+        lock.lock()
+        defer { lock.unlock() }
+        return buffers
+    }
+
+    /// Small number that names the thread in traces. The first thread to record is 0.
+    let thread: Int
+
+    /// Made on the event loop thread.
+    let isEventLoop = SlintActor.isIsolated
+
+    private let capacity: Int
+    private let events: UnsafeMutablePointer<SlintTracing.Event>
+    private let written = ManagedAtomic<Int>(0)
+
+    /// Events before this were cleared.
+    private let cleared = ManagedAtomic<Int>(0)
+
+    private init(thread: Int) {
+        self.thread = thread
+        var capacity = 1
+        while capacity < Self.capacity.load(ordering: .relaxed) { capacity <<= 1 }
+        self.capacity = capacity
+        events = .allocate(capacity: capacity)
+    }
+
+    // Never deinitialized: the registry holds every buffer.
+
+    /// This thread's buffer. Made the first time the thread records.
+    static var current: TraceBuffer {
+        if let buffer = pthread_getspecific(key) {
+            return Unmanaged<TraceBuffer>.fromOpaque(buffer).takeUnretainedValue()
+        }
+
+        lock.lock()
+        let buffer = TraceBuffer(thread: buffers.count)
+        buffers.append(buffer)
+        lock.unlock()
+
+        // The registry keeps it alive, so the thread's reference needn't be retained.
+        pthread_setspecific(key, Unmanaged.passUnretained(buffer).toOpaque())
+        return buffer
+    }
+
+    private static let key: pthread_key_t = {
+        var key = pthread_key_t()
+        pthread_key_create(&key, nil)
+        return key
+    }()
+
+    /// Only called on the buffer's own thread.
+    @inline(__always)
+    func record(_ event: SlintTracing.Event) {
+        let index = written.load(ordering: .relaxed)
+        events[index & (capacity - 1)] = event
+        written.store(index + 1, ordering: .releasing)
+    }
+
+    func clear() {
+        cleared.store(written.load(ordering: .acquiring), ordering: .relaxed)
+    }
+
+    func snapshot() -> [SlintTracing.Event] {
+        let end = written.load(ordering: .acquiring)
+        let start = max(end - capacity, cleared.load(ordering: .relaxed), 0)
+        var copied = (start ..< end).map { events[$0 & (capacity - 1)] }
+
+        // Anything the writer lapped while we copied is garbage.
+        let overwritten = written.load(ordering: .acquiring) - capacity
+        if overwritten > start { copied.removeFirst(min(overwritten - start, copied.count)) }
+        return copied
+    }
+}
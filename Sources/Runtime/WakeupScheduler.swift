@@ -0,0 +1,194 @@
+//
+//  WakeupScheduler.swift
+//  slint
+//
+
+import SlintFFI
+
+/// Counters for `WakeupScheduler`. Useful for checking an idle UI really is idle.
+public struct WakeupStatistics {
+    /// Number of times the scheduler woke up and updated Slint's timers and animations.
+    public internal(set) var wakeups = 0
+
+    /// Nanoseconds since the scheduler started.
+    public internal(set) var uptimeNanoseconds: UInt64 = 0
+
+    /// Sum of how late each wakeup was, compared to the deadline it was armed for.
+    public internal(set) var totalLatenessNanoseconds: UInt64 = 0
+
+    /// Latest any single wakeup has been.
+    public internal(set) var maxLatenessNanoseconds: UInt64 = 0
+
+    /// Average wakeups per second since the scheduler started.
+    public var wakeupsPerSecond: Double {
+        guard uptimeNanoseconds > 0 else { return 0 }
+        return Double(wakeups) / (Double(uptimeNanoseconds) / 1_000_000_000)
+    }
+
+    /// Average lateness of a wakeup, in nanoseconds.
+    public var averageLatenessNanoseconds: UInt64 {
+        guard wakeups > 0 else { return 0 }
+        return totalLatenessNanoseconds / UInt64(wakeups)
+    }
+}
+
+/// Wakes up exactly when Slint next needs its timers and animations updated, and not otherwise.
+///
+/// At most one wakeup is armed at a time, for the deadline Slint reports through
+/// `slint_platform_duration_until_next_timer_update()`. While something is animating, that deadline is capped to one frame.
+/// With no timers and no animations, nothing is armed at all, and the scheduler sleeps until `rearm()` is called.
+///
+/// `SlintTimer` re-arms whenever it starts a timer, and windows when they ask for a redraw.
+/// Every instance's window is watched for animations from when it's created.
+/// Anything else that can create work for Slint should call `rearm()` too.
+@SlintActor
+public final class WakeupScheduler {
+    /// Shared instance, started by `SlintApp.main()`.
+    public static let shared = WakeupScheduler()
+
+    /// Milliseconds between wakeups while an animation is running.
+    public var animationFrameInterval: UInt64 = 16
+
+    /// Counters. `uptimeNanoseconds` is brought up to date on every read.
+    public var statistics: WakeupStatistics {
+        var current = _statistics
+        if let startedAt { current.uptimeNanoseconds = monotonicNanoseconds() - startedAt }
+        return current
+    }
+
+    private var _statistics = WakeupStatistics()
+
+    /// When `start()` was called. `nil` while not started.
+    private var startedAt: UInt64?
+
+    /// The armed wakeup: its deadline on the monotonic clock, and the task sleeping until then.
+    private var armed: (deadline: UInt64, task: Task<Void, Never>)?
+
+    /// Things that might be animating, e.g. windows. Keyed by an ID so they can be removed.
+    /// A source returns `nil` once it's gone, and is dropped.
+    private var animationSources: [Int: @SlintActor () -> Bool?] = [:]
+    private var nextAnimationSourceID = 0
+
+    /// Initializer. Nonisolated because it doesn't do anything, so it doesn't need to be isolated.
+    nonisolated init() { }
+
+    /// Start scheduling wakeups. Must only be called once the event loop is running.
+    func start() {
+        guard startedAt == nil else { return }
+        startedAt = monotonicNanoseconds()
+        rearm()
+    }
+
+    /// Stop scheduling wakeups, and cancel the armed one.
+    func stop() {
+        armed?.task.cancel()
+        armed = nil
+        startedAt = nil
+    }
+
+    /// Watch a source of animations, so wakeups happen every frame while it's animating.
+    /// - Parameter hasActiveAnimations: Returns true while the source is animating.
+    /// - Returns: An ID for `stopWatchingAnimations(_:)`.
+    @discardableResult
+    public func watchAnimations(_ hasActiveAnimations: @escaping @SlintActor () -> Bool) -> Int {
+        addAnimationSource(hasActiveAnimations)
+    }
+
+    /// Watch a window's animations.
+    /// - Parameter window: The window. Must stay valid until `stopWatchingAnimations(_:)` is called.
+    /// - Returns: An ID for `stopWatchingAnimations(_:)`.
+    @discardableResult
+    public func watchAnimations(of window: UnsafePointer<WindowAdapterRcOpaque>) -> Int {
+        watchAnimations { slint_windowrc_has_active_animations(window) }
+    }
+
+    /// Watch a component instance's window, for as long as the instance is alive. Called when it's created.
+    func watchAnimations(of instance: SlintComponentInstance) {
+        _ = addAnimationSource { [weak instance] in
+            instance.map { slint_windowrc_has_active_animations($0.window) }
+        }
+    }
+
+    /// Stop watching a source of animations.
+    public func stopWatchingAnimations(_ id: Int) {
+        animationSources[id] = nil
+    }
+
+    private func addAnimationSource(_ hasActiveAnimations: @escaping @SlintActor () -> Bool?) -> Int {
+        let id = nextAnimationSourceID
+        nextAnimationSourceID += 1
+        animationSources[id] = hasActiveAnimations
+        rearm()
+        return id
+    }
+
+    /// `rearm()`, from callbacks Swift can't tell are isolated, like a window's redraw request.
+    /// Inline on the event loop thread, so a redraw is scheduled before the callback returns.
+    nonisolated static func rearmSoon() {
+        SlintActor.dispatch { WakeupScheduler.shared.rearm() }
+    }
+
+    /// True if any source is animating. Drops sources that are gone.
+    private func isAnimating() -> Bool {
+        var animating = false
+        for (id, hasActiveAnimations) in animationSources {
+            switch hasActiveAnimations() {
+            case true?: animating = true
+            case false?: break
+            case nil: animationSources[id] = nil
+            }
+        }
+        return animating
+    }
+
+    /// Re-compute the next deadline, and arm a wakeup for it if it's sooner than the armed one.
+    /// Call this after anything that may have given Slint new work, like starting a timer.
+    public func rearm() {
+        guard startedAt != nil else { return }
+
+        // Slint reports `UInt64.max` if there's nothing to wake up for.
+        var delay = slint_platform_duration_until_next_timer_update()
+        if delay > animationFrameInterval && isAnimating() {
+            delay = animationFrameInterval
+        }
+
+        guard delay != UInt64.max else {
+            // Nothing pending. Sleep until someone calls `rearm()`.
+            armed?.task.cancel()
+            armed = nil
+            return
+        }
+
+        // Capped at about 34 years, so converting to nanoseconds can't overflow.
+        let deadline = monotonicNanoseconds() + min(delay, 1 << 40) * 1_000_000
+
+        // An earlier wakeup will re-compute the deadline when it fires anyway.
+        if let armed, armed.deadline <= deadline { return }
+
+        armed?.task.cancel()
+        armed = (deadline, Task.detached {
+            let now = monotonicNanoseconds()
+            if deadline > now {
+                do { try await Task.sleep(nanoseconds: deadline - now) } catch { return }
+            }
+            await WakeupScheduler.shared.fire(deadline)
+        })
+    }
+
+    /// The armed wakeup fired.
+    private func fire(_ deadline: UInt64) {
+        // Ignore wakeups that were superseded after they started hopping over here.
+        guard let armed, armed.deadline == deadline else { return }
+        self.armed = nil
+
+        let now = monotonicNanoseconds()
+        let lateness = now > deadline ? now - deadline : 0
+        _statistics.wakeups += 1
+        _statistics.totalLatenessNanoseconds += lateness
+        _statistics.maxLatenessNanoseconds = max(_statistics.maxLatenessNanoseconds, lateness)
+
+        updateTimersAndAnimations()
+
+        rearm()
+    }
+}
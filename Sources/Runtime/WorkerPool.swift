@@ -0,0 +1,60 @@
+//
+//  WorkerPool.swift
+//  slint
+//
+
+// For `Thread` and `NSCondition`.
+import Foundation
+
+/// Threads that take closures off one queue, oldest first. For work that would stall the event loop.
+///
+/// Workers are started once and never exit, and they keep the pool alive. So make a pool once, and keep it.
+final class WorkerPool: @unchecked Sendable {
+    private let condition = NSCondition()
+    private var jobs: [() -> Void] = []
+    private var nextJob = 0
+
+    /// Number of worker threads.
+    let workerCount: Int
+
+    /// Start a pool.
+    /// - Parameters:
+    ///   - name: Threads are named this, and their index.
+    ///   - workers: Number of worker threads. At least one is started.
+    ///   - stackSize: Each worker's stack size, in bytes, or `nil` for the default.
+    init(name: String, workers: Int, stackSize: Int? = nil) {
+        workerCount = max(workers, 1)
+        for index in 0 ..< workerCount {
+            let thread = Thread { self.work() }
+            thread.name = "\(name) \(index)"
+            if let stackSize { thread.stackSize = stackSize }
+            thread.start()
+        }
+    }
+
+    /// Run a closure on the next free worker.
+    func enqueue(_ job: @escaping () -> Void) {
+        condition.lock()
+        jobs.append(job)
+        condition.signal()
+        condition.unlock()
+    }
+
+    /// Worker thread body. Takes jobs, oldest first, forever.
+    private func work() {
+        while true {
+            condition.lock()
+            while nextJob == jobs.count { condition.wait() }
+            let job = jobs[nextJob]
+            nextJob += 1
+            // Compact once everything queued has been taken, so the array doesn't grow forever.
+            if nextJob == jobs.count {
+                jobs.removeAll(keepingCapacity: true)
+                nextJob = 0
+            }
+            condition.unlock()
+
+            job()
+        }
+    }
+}
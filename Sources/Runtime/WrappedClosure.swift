@@ -5,9 +5,6 @@
 //  Created by Matthew Taylor on 2/14/24.
 //
 
-// NOTE: Only for Thread.current.isMainThread
-import Foundation
-
 /// Wrapper around a Swift closure, allowing it to be invoked by Slint.
 /// There are different version specialized for specific APIs.
 /// This one is meant for the most common use case.
@@ -23,10 +20,7 @@ class WrappedClosure {
     /// 
     /// If you need to save the value, use `withResult(_:)` or `withResultThrowing(_:)`.
     init(_ closure: @SlintActor @escaping @Sendable () -> Void) {
-        invoke = {
-            assert(Thread.current.isMainThread, "Closure not running on main thread!")
-            closure()
-        }
+        invoke = closure
     }
    
     /// Factory function. Creates a wrapped closure that captures a value.
@@ -41,7 +35,6 @@ class WrappedClosure {
 
         // Create wrapper with a closure that sends the result through the channel.
         let wrapper = WrappedClosure {
-            assert(Thread.current.isMainThread, "Closure not running on main thread!")
             channel.send(closure())
         }
         
@@ -61,7 +54,6 @@ class WrappedClosure {
 
         // Create wrapper with a closure that sends the result through the channel using `Result`.
         let wrapper = WrappedClosure {
-            assert(Thread.current.isMainThread, "Closure not running on main thread!")
             channel.send( Result { try closure() } )
         }
         
@@ -94,15 +86,9 @@ class WrappedClosure {
         // Get a reference to this instance from an opaque pointer.
         let wrapper = Unmanaged<WrappedClosure>.fromOpaque(userDataPtr!).takeUnretainedValue()
 
-        // This is nasty and quite gross, but necessary.
-        // We _are_ in the SlintActor isolation context, but Swift does not let us tell it so!
-        // See here: https://github.com/apple/swift-evolution/blob/main/proposals/0392-custom-actor-executors.md#assuming-actor-executors
-        
-        // Inspired by: https://forums.swift.org/t/se-0392-custom-actor-executors/63599/26
-        // Basically, make Swift ignore the `@SlintActor` isolation by FORCING a type cast.
-
-        // Sometimes, you just need a sledgehammer 🔨
-        unsafeBitCast(wrapper.invoke, to: (() -> Void).self)()
+        // We _are_ in the SlintActor isolation context, because Slint only calls this on the event loop thread.
+        // `assumeIsolated` checks that, and lets us call the isolated closure.
+        traced(.closure) { SlintActor.assumeIsolated(wrapper.invoke) }
     }
 
     /// Drop user data callback. Releases the wrapper.
@@ -5,9 +5,25 @@
 //  Created by Matthew Taylor on 2/10/24.
 //
 
+// For `Thread`.
+import Foundation
+
+import Atomics
+
 import SlintFFI
 
 
+/// Which thread runs the Slint event loop.
+public enum SlintEventLoopThread {
+    /// The main thread. It's blocked for as long as the loop runs, so `@MainActor` code waits until it stops.
+    case main
+    /// A thread of its own. The main actor stays free for the application's own work.
+    ///
+    /// Slint's backend has to support running off the main thread. `HeadlessPlatform` and `EpollPlatform` do,
+    /// and so do Slint's Linux backends. macOS only allows windows on the main thread.
+    case dedicated
+}
+
 /// Protocol for Slint applications.
 /// 
 /// Usage:
@@ -27,49 +43,64 @@ public protocol SlintApp {
     /// 
     /// Note: `async` is optional. Synchronous functions can fulfill asynchronous requirements.
     @SlintActor static func start() async
+
+    /// Which thread runs the event loop. Defaults to `.main`.
+    ///
+    /// Either way, `start()` runs on that thread, before the loop starts.
+    static var eventLoopThread: SlintEventLoopThread { get }
 }
 
 public extension SlintApp {
+    static var eventLoopThread: SlintEventLoopThread { .main }
+
     /// Implementation for `main()`.
     @MainActor
     static func main() async {
-        // Execute start.
-        await Self.start()
+        // Start scheduling timer and animation updates, once the event loop is running.
+        let wakeupTask = Task.detached {
+            await EventLoop.ready
+            await WakeupScheduler.shared.start()
+        }
 
-        // Setup idle task.
-        let idleTask = Task.detached { await idle() }
+        switch eventLoopThread {
+        case .main:
+            // `SlintActor` jobs run on the main actor, until `start()` is done.
+            await Self.start()
 
-        // Switch Slint actor into 'event loop mode'
-        SwitchToEventLoopExecutor()
+            // From here, they're held until the loop is running.
+            SlintEventLoopExecutor.shared.holdUntilLoopStarts()
 
-        // Start the event loop
-        EventLoop.start()
+            // Start the event loop
+            EventLoop.start()
 
-        // If that returns, cancel the idle task.
-        idleTask.cancel()
-    }
-}
+        case .dedicated:
+            SlintEventLoopExecutor.shared.holdUntilLoopStarts()
+
+            let thread = Thread {
+                // Run `start()` here, on the loop's thread, before the loop. Its jobs are held, so run them as they come.
+                SlintEventLoopExecutor.shared.bindToCurrentThread()
+                let started = ManagedAtomic<Bool>(false)
+                Task { @SlintActor in
+                    await Self.start()
+                    started.store(true, ordering: .releasing)
+                    SlintEventLoopExecutor.shared.wakeHeldJobRunner()
+                }
+                SlintEventLoopExecutor.shared.runHeldJobs { started.load(ordering: .acquiring) }
 
-/// Idle task. Makes Slint update its state, then sleeps for as long as Slint thinks it should.
-/// Or 100ms. Whichever is shorter.
-func idle() async {
-    await EventLoop.ready
-
-    while !Task.isCancelled {
-        // How long until the next update?
-        var durationUntilUpdate: UInt64 = 1
-
-        await { @SlintActor in
-            // Make Slint do something
-            slint_platform_update_timers_and_animations()
-        
-            // How long until we should update again?
-            durationUntilUpdate = slint_platform_duration_until_next_timer_update()
-        }()
-
-        // Wait that duration or 100ms, whichever is less.
-        // Slint will set the value to UInt64.max if there is nothing waking it up.
-        durationUntilUpdate = durationUntilUpdate > 100 ? 100 : durationUntilUpdate
-        try! await Task.sleep(nanoseconds: durationUntilUpdate * 1_000_000)
+                EventLoop.run()
+            }
+            thread.name = "Slint event loop"
+            thread.stackSize = eventLoopStackSize
+            thread.start()
+
+            // Suspended, not blocked, so the main actor is free.
+            await EventLoop.finished
+        }
+
+        // The loop stopped the scheduler as it returned. This only matters if it stopped before the scheduler started.
+        wakeupTask.cancel()
     }
 }
+
+/// Stack for a dedicated event loop thread. Same as the main thread's, usually. Layout and rendering recurse.
+private let eventLoopStackSize = 8 << 20
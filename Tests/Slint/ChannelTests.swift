@@ -0,0 +1,186 @@
+// `AsyncChannel` and `AsyncBufferedChannel`: every waiter resumed exactly once, and every element delivered exactly once, in order.
+// Neither needs the event loop, so these run on the cooperative pool.
+import XCTest
+
+@testable import SlintUI
+
+final class ChannelTests: XCTestCase {
+    // MARK: AsyncChannel
+
+    func testValueSentBeforeReading() async throws {
+        let channel = AsyncChannel(Int.self)
+        channel.send(42)
+        let first = try await channel.value
+        let second = try await channel.value
+        XCTAssertEqual(first, 42)
+        XCTAssertEqual(second, 42)
+    }
+
+    func testEveryWaiterGetsTheValue() async throws {
+        let channel = AsyncChannel(Int.self)
+        let values = try await withThrowingTaskGroup(of: Int.self) { group in
+            for _ in 0 ..< 50 { group.addTask { try await channel.value } }
+            // Most of the readers are suspended by now, the rest take the fast path. Both have to see the value.
+            try await Task.sleep(nanoseconds: 10_000_000)
+            channel.send(7)
+            return try await group.reduce(into: []) { $0.append($1) }
+        }
+        XCTAssertEqual(values, [Int](repeating: 7, count: 50))
+    }
+
+    func testCancelResumesEveryWaiter() async throws {
+        let channel = AsyncChannel(Int.self)
+        let failures = await withTaskGroup(of: Bool.self) { group in
+            for _ in 0 ..< 20 {
+                group.addTask {
+                    do {
+                        _ = try await channel.value
+                        return false
+                    } catch {
+                        return error is CancellationError
+                    }
+                }
+            }
+            try? await Task.sleep(nanoseconds: 10_000_000)
+            channel.cancel()
+            return await group.reduce(into: 0) { $0 += $1 ? 1 : 0 }
+        }
+        XCTAssertEqual(failures, 20)
+
+        // Sending after cancelling does nothing, and later reads fail too.
+        channel.send(1)
+        do {
+            _ = try await channel.value
+            XCTFail("Read a value from a cancelled channel.")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+    }
+
+    func testCancellingATaskOnlyCancelsItsOwnRead() async throws {
+        let channel = AsyncChannel(Int.self)
+        let cancelled = Task { try await channel.value }
+        let kept = Task { try await channel.value }
+        try await Task.sleep(nanoseconds: 10_000_000)
+
+        cancelled.cancel()
+        do {
+            _ = try await cancelled.value
+            XCTFail("A cancelled read returned a value.")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+
+        channel.send(3)
+        let value = try await kept.value
+        XCTAssertEqual(value, 3)
+    }
+
+    // MARK: AsyncBufferedChannel
+
+    /// A sent element: which producer sent it, and how many it had sent before.
+    typealias Message = (producer: Int, index: Int)
+
+    static let producers = 4
+    static let messagesPerProducer = 5_000
+
+    /// Drain `channel` until it's finished.
+    /// - Returns: How many messages each producer got through, or `nil` if any arrived out of that producer's order.
+    private static func consume(_ channel: AsyncBufferedChannel<Message>) async -> [Int]? {
+        var next = [Int](repeating: 0, count: producers)
+        var inOrder = true
+        for await message in channel {
+            inOrder = inOrder && message.index == next[message.producer]
+            next[message.producer] = message.index + 1
+        }
+        return inOrder ? next : nil
+    }
+
+    func testManyProducersDeliverEveryElementOnceInOrder() async throws {
+        // Small, so producers keep waiting on it, and get let in by the consumer.
+        let channel = AsyncBufferedChannel(Message.self, capacity: 8)
+        async let consumed = Self.consume(channel)
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for producer in 0 ..< Self.producers {
+                group.addTask {
+                    for index in 0 ..< Self.messagesPerProducer {
+                        let delivered = try await channel.send((producer, index))
+                        XCTAssertTrue(delivered)
+                    }
+                }
+            }
+            try await group.waitForAll()
+        }
+        channel.finish()
+
+        let next = await consumed
+        XCTAssertEqual(next, [Int](repeating: Self.messagesPerProducer, count: Self.producers), "Lost, repeated, or reordered a message.")
+    }
+
+    func testTrySendRefusesWhenFull() async throws {
+        let channel = AsyncBufferedChannel(Int.self, capacity: 2)
+        XCTAssertTrue(channel.trySend(1))
+        XCTAssertTrue(channel.trySend(2))
+        XCTAssertFalse(channel.trySend(3))
+
+        let first = await channel.next()
+        XCTAssertEqual(first, 1)
+        XCTAssertTrue(channel.trySend(3))
+
+        // Finishing still delivers what's buffered, then ends.
+        channel.finish()
+        XCTAssertFalse(channel.trySend(4))
+        var rest: [Int] = []
+        for await value in channel { rest.append(value) }
+        XCTAssertEqual(rest, [2, 3])
+    }
+
+    func testFinishReleasesWaitingProducers() async throws {
+        let channel = AsyncBufferedChannel(Int.self, capacity: 1)
+        XCTAssertTrue(channel.trySend(0))
+        let waiting = Task { try await channel.send(1) }
+        try await Task.sleep(nanoseconds: 10_000_000)
+
+        channel.finish()
+        let delivered = try await waiting.value
+        XCTAssertFalse(delivered)
+
+        let first = await channel.next()
+        let second = await channel.next()
+        XCTAssertEqual(first, 0)
+        XCTAssertNil(second)
+    }
+
+    func testCancelledProducerDropsItsElement() async throws {
+        let channel = AsyncBufferedChannel(Int.self, capacity: 1)
+        XCTAssertTrue(channel.trySend(0))
+        let waiting = Task { try await channel.send(1) }
+        waiting.cancel()
+        do {
+            _ = try await waiting.value
+            XCTFail("A cancelled send was delivered.")
+        } catch {
+            XCTAssertTrue(error is CancellationError)
+        }
+
+        let first = await channel.next()
+        XCTAssertEqual(first, 0)
+        XCTAssertTrue(channel.trySend(2))
+        let second = await channel.next()
+        XCTAssertEqual(second, 2)
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testValueSentBeforeReading", asyncTest(testValueSentBeforeReading)),
+        ("testEveryWaiterGetsTheValue", asyncTest(testEveryWaiterGetsTheValue)),
+        ("testCancelResumesEveryWaiter", asyncTest(testCancelResumesEveryWaiter)),
+        ("testCancellingATaskOnlyCancelsItsOwnRead", asyncTest(testCancellingATaskOnlyCancelsItsOwnRead)),
+        ("testManyProducersDeliverEveryElementOnceInOrder", asyncTest(testManyProducersDeliverEveryElementOnceInOrder)),
+        ("testTrySendRefusesWhenFull", asyncTest(testTrySendRefusesWhenFull)),
+        ("testFinishReleasesWaitingProducers", asyncTest(testFinishReleasesWaitingProducers)),
+        ("testCancelledProducerDropsItsElement", asyncTest(testCancelledProducerDropsItsElement)),
+    ]
+#endif
+}
@@ -0,0 +1,181 @@
+// `SlintComputed` must run its closure again exactly when something it read has changed, and only when it's read.
+// Properties don't need the event loop, so the test thread stands in for it.
+import XCTest
+
+import SlintFFI
+@testable import SlintUI
+
+final class ComputedTests: XCTestCase {
+    override func setUp() {
+        super.setUp()
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+    }
+
+    override func tearDown() {
+        SlintEventLoopExecutor.shared.unbindThread()
+        super.tearDown()
+    }
+
+    func testComputesLazilyAndCaches() {
+        SlintActor.assumeIsolated {
+            let source = Property<Int32>(2)
+            let squared = SlintComputed { source.value * source.value }
+
+            XCTAssertEqual(squared.recomputations, 0)
+            XCTAssertTrue(squared.isStale)
+
+            XCTAssertEqual(squared.value, 4)
+            XCTAssertEqual(squared.value, 4)
+            XCTAssertEqual(squared.recomputations, 1)
+            XCTAssertFalse(squared.isStale)
+        }
+    }
+
+    func testChangeInvalidatesOnNextRead() {
+        SlintActor.assumeIsolated {
+            let source = Property<Int32>(2)
+            let squared = SlintComputed { source.value * source.value }
+            _ = squared.value
+
+            source.value = 3
+            source.value = 4
+            // Stale, but not recomputed until read.
+            XCTAssertTrue(squared.isStale)
+            XCTAssertEqual(squared.recomputations, 1)
+
+            XCTAssertEqual(squared.value, 16)
+            XCTAssertEqual(squared.recomputations, 2)
+        }
+    }
+
+    func testUnrelatedChangeKeepsCache() {
+        SlintActor.assumeIsolated {
+            let source = Property<Int32>(1)
+            let unrelated = Property<Int32>(0)
+            let doubled = SlintComputed { source.value * 2 }
+            _ = doubled.value
+
+            for tick in 1 ... 10 { unrelated.value = tick }
+            XCTAssertEqual(doubled.value, 2)
+            XCTAssertEqual(doubled.recomputations, 1)
+        }
+    }
+
+    func testSettingSameValueKeepsCache() {
+        SlintActor.assumeIsolated {
+            let source = Property<String>("bolt")
+            let upper = SlintComputed { source.value.uppercased() }
+            _ = upper.value
+
+            source.value = "bolt"
+            XCTAssertEqual(upper.value, "BOLT")
+            XCTAssertEqual(upper.recomputations, 1)
+        }
+    }
+
+    /// Dependencies are whatever the last run read, so they follow branches.
+    func testDependenciesFollowBranches() {
+        SlintActor.assumeIsolated {
+            let useFirst = Property<Bool>(true)
+            let first = Property<Int32>(1)
+            let second = Property<Int32>(2)
+            let chosen = SlintComputed { useFirst.value ? first.value : second.value }
+
+            XCTAssertEqual(chosen.value, 1)
+            second.value = 20
+            XCTAssertFalse(chosen.isStale)
+
+            useFirst.value = false
+            XCTAssertEqual(chosen.value, 20)
+            XCTAssertEqual(chosen.recomputations, 2)
+
+            first.value = 10
+            XCTAssertFalse(chosen.isStale)
+            second.value = 30
+            XCTAssertEqual(chosen.value, 30)
+            XCTAssertEqual(chosen.recomputations, 3)
+        }
+    }
+
+    /// A change to a binding's source reaches through the binding.
+    func testChangeThroughBinding() {
+        SlintActor.assumeIsolated {
+            let source = Property<Int32>(1)
+            let bound = Property<Int32>(0)
+            bound.setBinding { source.value + 100 }
+            let label = SlintComputed { "\(bound.value)" }
+
+            XCTAssertEqual(label.value, "101")
+            source.value = 2
+            XCTAssertEqual(label.value, "102")
+            XCTAssertEqual(label.recomputations, 2)
+        }
+    }
+
+    /// A computed value read by another only runs when its own sources change.
+    func testNestedComputed() {
+        SlintActor.assumeIsolated {
+            let items = Property<[Int32]>([5, 3, 8, 1])
+            let threshold = Property<Int32>(2)
+            let filtered = SlintComputed { items.value.filter { $0 > threshold.value } }
+            let sorted = SlintComputed { filtered.value.sorted() }
+
+            XCTAssertEqual(sorted.value, [3, 5, 8])
+            XCTAssertEqual(sorted.value, [3, 5, 8])
+            XCTAssertEqual(filtered.recomputations, 1)
+            XCTAssertEqual(sorted.recomputations, 1)
+
+            threshold.value = 4
+            XCTAssertEqual(sorted.value, [5, 8])
+            XCTAssertEqual(filtered.recomputations, 2)
+            XCTAssertEqual(sorted.recomputations, 2)
+        }
+    }
+
+    /// Batched writes are applied at once, so they only make it stale once.
+    func testBatchedWritesRecomputeOnce() {
+        SlintActor.assumeIsolated {
+            let width = Property<Int32>(1)
+            let height = Property<Int32>(1)
+            let area = SlintComputed { width.value * height.value }
+            _ = area.value
+
+            Slint.batch {
+                width.value = 3
+                height.value = 4
+                // Writes are held until the batch ends.
+                XCTAssertEqual(area.value, 1)
+            }
+            XCTAssertEqual(area.value, 12)
+            XCTAssertEqual(area.recomputations, 2)
+        }
+    }
+
+    func testInvalidate() {
+        SlintActor.assumeIsolated {
+            var untracked = 1
+            let computed = SlintComputed { untracked }
+            XCTAssertEqual(computed.value, 1)
+
+            untracked = 2
+            XCTAssertEqual(computed.value, 1)
+            computed.invalidate()
+            XCTAssertEqual(computed.value, 2)
+            XCTAssertEqual(computed.recomputations, 2)
+        }
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testComputesLazilyAndCaches", testComputesLazilyAndCaches),
+        ("testChangeInvalidatesOnNextRead", testChangeInvalidatesOnNextRead),
+        ("testUnrelatedChangeKeepsCache", testUnrelatedChangeKeepsCache),
+        ("testSettingSameValueKeepsCache", testSettingSameValueKeepsCache),
+        ("testDependenciesFollowBranches", testDependenciesFollowBranches),
+        ("testChangeThroughBinding", testChangeThroughBinding),
+        ("testNestedComputed", testNestedComputed),
+        ("testBatchedWritesRecomputeOnce", testBatchedWritesRecomputeOnce),
+        ("testInvalidate", testInvalidate),
+    ]
+#endif
+}
@@ -0,0 +1,104 @@
+// `SlintActor.assumeIsolated` and `SlintActor.dispatch`.
+// There's no event loop here, so the test thread stands in for it, through `bindToCurrentThread()`.
+import XCTest
+
+@testable import SlintUI
+
+/// Isolated state, to prove the closures really are treated as isolated.
+@SlintActor
+final class IsolatedLog {
+    var entries: [String] = []
+
+    nonisolated init() { }
+}
+
+final class IsolationTests: XCTestCase {
+    override func tearDown() {
+        SlintEventLoopExecutor.shared.unbindThread()
+        super.tearDown()
+    }
+
+    /// Run a closure on a fresh thread, and wait for it.
+    private func onOtherThread(_ body: @escaping @Sendable () -> Void) {
+        let done = expectation(description: "other thread")
+        Thread {
+            body()
+            done.fulfill()
+        }.start()
+        wait(for: [done], timeout: 5)
+    }
+
+    func testAssumeIsolatedRunsInline() throws {
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        let log = IsolatedLog()
+
+        let count = SlintActor.assumeIsolated {
+            log.entries.append("inside")
+            return log.entries.count
+        }
+
+        XCTAssertEqual(count, 1)
+        XCTAssertEqual(SlintActor.assumeIsolated { log.entries }, ["inside"])
+    }
+
+    func testAssumeIsolatedRethrows() throws {
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+
+        XCTAssertThrowsError(try SlintActor.assumeIsolated { () throws -> Int in throw CancellationError() }) { error in
+            XCTAssertTrue(error is CancellationError)
+        }
+    }
+
+    func testIsolationFollowsTheBoundThread() throws {
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        XCTAssertTrue(SlintActor.isIsolated)
+
+        // Another thread isn't the event loop.
+        let otherThreadIsIsolated = SharedFlag()
+        onOtherThread { otherThreadIsIsolated.value = SlintActor.isIsolated }
+        XCTAssertFalse(otherThreadIsIsolated.value)
+
+        // Once another thread is the event loop, this one isn't.
+        onOtherThread { SlintEventLoopExecutor.shared.bindToCurrentThread() }
+        XCTAssertFalse(SlintActor.isIsolated)
+    }
+
+    func testMainThreadIsIsolatedBeforeTheLoopStarts() throws {
+        // Until the loop starts, `SlintActor` runs on the main actor.
+        SlintEventLoopExecutor.shared.unbindThread()
+        XCTAssertEqual(SlintActor.isIsolated, Thread.isMainThread)
+    }
+
+    func testCheckIsolatedPassesOnTheBoundThread() throws {
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        // Crashes if it fails.
+        SlintEventLoopExecutor.shared.checkIsolated()
+    }
+
+    func testDispatchRunsInlineOnTheBoundThread() throws {
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        let log = IsolatedLog()
+
+        SlintActor.dispatch { log.entries.append("dispatched") }
+        SlintActor.assumeIsolated { log.entries.append("after") }
+
+        // Inline means it ran before `dispatch` returned, so it comes first.
+        XCTAssertEqual(SlintActor.assumeIsolated { log.entries }, ["dispatched", "after"])
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testAssumeIsolatedRunsInline", testAssumeIsolatedRunsInline),
+        ("testAssumeIsolatedRethrows", testAssumeIsolatedRethrows),
+        ("testIsolationFollowsTheBoundThread", testIsolationFollowsTheBoundThread),
+        ("testMainThreadIsIsolatedBeforeTheLoopStarts", testMainThreadIsIsolatedBeforeTheLoopStarts),
+        ("testCheckIsolatedPassesOnTheBoundThread", testCheckIsolatedPassesOnTheBoundThread),
+        ("testDispatchRunsInlineOnTheBoundThread", testDispatchRunsInlineOnTheBoundThread),
+    ]
+#endif
+}
+
+/// A flag written on one thread, and read on another after joining it.
+final class SharedFlag: @unchecked Sendable {
+    var value = false
+}
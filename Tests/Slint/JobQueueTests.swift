@@ -0,0 +1,119 @@
+// `JobQueue`, with many producers at once, and the `DrainHandshake` that decides who posts the executor's drain events.
+// The test thread is the consumer, standing in for the event loop.
+import XCTest
+
+import Atomics
+@testable import SlintUI
+
+final class JobQueueTests: XCTestCase {
+    /// A job: which producer pushed it, and how many it had pushed before.
+    struct Job {
+        let producer: Int
+        let index: Int
+    }
+
+    static let producers = 4
+    static let jobsPerProducer = 20_000
+
+    /// Start a thread per producer. `group` is left once each returns.
+    private func startProducers(_ group: DispatchGroup, _ body: @escaping @Sendable (Int) -> Void) {
+        for producer in 0 ..< Self.producers {
+            group.enter()
+            Thread {
+                body(producer)
+                group.leave()
+            }.start()
+        }
+    }
+
+    func testEveryJobPopsOnceInEachProducersOrder() throws {
+        // Small, so producers keep finding it full, and slots are reused many times over.
+        let queue = JobQueue<Job>(minimumCapacity: 64)
+        let group = DispatchGroup()
+        startProducers(group) { producer in
+            for index in 0 ..< Self.jobsPerProducer {
+                while !queue.push(Job(producer: producer, index: index)) { sched_yield() }
+            }
+        }
+
+        var next = [Int](repeating: 0, count: Self.producers)
+        var popped = 0
+        let deadline = Date().addingTimeInterval(30)
+        while popped < Self.producers * Self.jobsPerProducer, Date() < deadline {
+            guard let job = queue.pop() else {
+                sched_yield()
+                continue
+            }
+            // In order per producer means each job arrives exactly once: none skipped, none repeated.
+            XCTAssertEqual(job.index, next[job.producer], "Producer \(job.producer)'s jobs arrived out of order.")
+            next[job.producer] = job.index + 1
+            popped += 1
+        }
+
+        XCTAssertEqual(group.wait(timeout: .now() + 5), .success)
+        XCTAssertEqual(next, [Int](repeating: Self.jobsPerProducer, count: Self.producers))
+        XCTAssertNil(queue.pop())
+    }
+
+    func testFullQueueRefusesAndKeepsWhatItHas() throws {
+        let queue = JobQueue<Job>(minimumCapacity: 3)
+        XCTAssertEqual(queue.capacity, 4)
+        for index in 0 ..< 4 { XCTAssertTrue(queue.push(Job(producer: 0, index: index))) }
+        XCTAssertFalse(queue.push(Job(producer: 0, index: 4)))
+
+        XCTAssertEqual(queue.pop()?.index, 0)
+        XCTAssertTrue(queue.push(Job(producer: 0, index: 4)))
+        XCTAssertEqual((0 ..< 4).compactMap { _ in queue.pop()?.index }, [1, 2, 3, 4])
+        XCTAssertNil(queue.pop())
+    }
+
+    /// Producers push, and post a drain if the handshake says so. The test thread only pops while a drain is posted,
+    /// the way the event loop only drains from a posted event. If a push could slip in between the consumer's
+    /// last pop and it clearing the flag, without anyone posting, the job would be stranded, and this would stop short.
+    func testDrainHandshakeNeverStrandsAJob() throws {
+        let queue = JobQueue<Job>(minimumCapacity: Self.producers * Self.jobsPerProducer)
+        let handshake = DrainHandshake()
+        let postedDrains = ManagedAtomic<Int>(0)
+        let group = DispatchGroup()
+        startProducers(group) { producer in
+            for index in 0 ..< Self.jobsPerProducer {
+                XCTAssertTrue(queue.push(Job(producer: producer, index: index)))
+                if handshake.producerPushed() { postedDrains.wrappingIncrement(ordering: .sequentiallyConsistent) }
+            }
+        }
+
+        var popped = 0
+        var drains = 0
+        var producersDone = false
+        let deadline = Date().addingTimeInterval(30)
+        while Date() < deadline {
+            guard postedDrains.load(ordering: .sequentiallyConsistent) > drains else {
+                // No drain posted. Once the producers are done, and have posted everything they will, that's the end.
+                if producersDone { break }
+                producersDone = group.wait(timeout: .now()) == .success
+                sched_yield()
+                continue
+            }
+
+            // One drain event, the same loop as the executor's.
+            drains += 1
+            repeat {
+                while queue.pop() != nil { popped += 1 }
+            } while handshake.consumerFoundEmpty(queue)
+        }
+
+        XCTAssertTrue(producersDone)
+        XCTAssertEqual(popped, Self.producers * Self.jobsPerProducer, "Jobs were pushed, but no drain was posted for them.")
+        XCTAssertEqual(drains, postedDrains.load(ordering: .sequentiallyConsistent))
+        // Producers piggyback on a posted drain, rather than each posting their own.
+        XCTAssertLessThan(drains, popped)
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testEveryJobPopsOnceInEachProducersOrder", testEveryJobPopsOnceInEachProducersOrder),
+        ("testFullQueueRefusesAndKeepsWhatItHas", testFullQueueRefusesAndKeepsWhatItHas),
+        ("testDrainHandshakeNeverStrandsAJob", testDrainHandshakeNeverStrandsAJob),
+    ]
+#endif
+}
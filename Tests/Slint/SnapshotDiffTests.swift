@@ -0,0 +1,117 @@
+// `SnapshotDiff`: applying its removals, then its insertions, to the old rows must give the new ones, for every kind of edit.
+// Pure data, so no event loop.
+import XCTest
+
+@testable import SlintUI
+
+final class SnapshotDiffTests: XCTestCase {
+    struct Row: Identifiable, Equatable {
+        let id: Int
+        var text = ""
+    }
+
+    /// Rows with these ids, and no text.
+    private static func rows(_ ids: [Int]) -> [Row] {
+        ids.map { Row(id: $0) }
+    }
+
+    /// Apply a diff the way Slint sees it: remove old rows, last range first, then insert new rows, first range first.
+    private static func apply(_ diff: SnapshotDiff, to old: [Row], _ new: [Row]) -> [Row] {
+        var rows = old
+        for range in diff.removals { rows.removeSubrange(range) }
+        for range in diff.insertions { rows.insert(contentsOf: new[range], at: range.lowerBound) }
+        return rows
+    }
+
+    /// Old ids, new ids, and how many rows should stay put.
+    static let cases: [(name: String, old: [Int], new: [Int], kept: Int)] = [
+        ("empty to empty", [], [], 0),
+        ("empty to N", [], [1, 2, 3, 4], 0),
+        ("N to empty", [1, 2, 3, 4], [], 0),
+        ("unchanged", [1, 2, 3], [1, 2, 3], 3),
+        ("reversal", [1, 2, 3, 4, 5], [5, 4, 3, 2, 1], 1),
+        ("move to the front", [1, 2, 3, 4, 5], [5, 1, 2, 3, 4], 4),
+        ("move to the back", [1, 2, 3, 4, 5], [2, 3, 4, 5, 1], 4),
+        ("swap", [1, 2, 3, 4, 5], [1, 4, 3, 2, 5], 3),
+        ("interleaved", [1, 2, 3, 4, 5, 6], [2, 1, 4, 3, 6, 5], 3),
+        ("insert in the middle", [1, 2, 3], [1, 7, 8, 2, 3], 3),
+        ("remove from the middle", [1, 2, 3, 4, 5], [1, 5], 2),
+        ("replace everything", [1, 2, 3], [4, 5, 6], 0),
+        ("mixed", [1, 2, 3, 4, 5, 6, 7], [9, 3, 1, 4, 8, 7, 6], 3),
+        ("duplicate old ids", [1, 1, 2, 2, 3], [1, 2, 3], 3),
+        ("duplicate new ids", [1, 2, 3], [1, 1, 2, 3, 3], 3),
+        ("duplicate ids on both sides", [4, 4, 5, 4], [4, 5, 4, 4], 2),
+    ]
+
+    func testApplyingGivesTheNewRows() throws {
+        for (name, oldIDs, newIDs, kept) in Self.cases {
+            let old = Self.rows(oldIDs)
+            let new = Self.rows(newIDs)
+            let diff = SnapshotDiff(from: old, to: new)
+
+            XCTAssertEqual(Self.apply(diff, to: old, new).map(\.id), newIDs, name)
+
+            let removed = diff.removals.reduce(0) { $0 + $1.count }
+            let inserted = diff.insertions.reduce(0) { $0 + $1.count }
+            XCTAssertEqual(oldIDs.count - removed, kept, "\(name): kept the wrong number of rows.")
+            XCTAssertEqual(newIDs.count - inserted, kept, "\(name): kept the wrong number of rows.")
+            XCTAssertEqual(diff.changes, [], "\(name): nothing changed.")
+        }
+    }
+
+    /// Removals are applied last first, so they have to come in descending order. Insertions ascending.
+    func testRangesAreOrderedAndDisjoint() throws {
+        for (name, oldIDs, newIDs, _) in Self.cases {
+            let diff = SnapshotDiff(from: Self.rows(oldIDs), to: Self.rows(newIDs))
+            for (later, earlier) in zip(diff.removals, diff.removals.dropFirst()) {
+                XCTAssertLessThan(earlier.upperBound, later.lowerBound, "\(name): removals overlap, touch, or are out of order.")
+            }
+            for (earlier, later) in zip(diff.insertions, diff.insertions.dropFirst()) {
+                XCTAssertLessThan(earlier.upperBound, later.lowerBound, "\(name): insertions overlap, touch, or are out of order.")
+            }
+            XCTAssertFalse(diff.removals.contains(where: \.isEmpty) || diff.insertions.contains(where: \.isEmpty), name)
+        }
+    }
+
+    func testChangedRowsThatStayAreReported() throws {
+        let old = [Row(id: 1, text: "a"), Row(id: 2, text: "b"), Row(id: 3, text: "c"), Row(id: 4, text: "d")]
+        // 2 changed and stayed, 3 changed and moved, 4 is gone, 5 is new.
+        let new = [Row(id: 3, text: "C"), Row(id: 1, text: "a"), Row(id: 2, text: "B"), Row(id: 5, text: "e")]
+        let diff = SnapshotDiff(from: old, to: new)
+
+        let applied = Self.apply(diff, to: old, new)
+        XCTAssertEqual(applied.map(\.id), new.map(\.id))
+        // Kept rows are the old ones until a change notification tells Slint to read them again.
+        XCTAssertEqual(applied[2], Row(id: 2, text: "b"))
+        // Moved rows are removed and inserted, so they come in new, and aren't reported as changed.
+        XCTAssertEqual(diff.changes, [2])
+        XCTAssertEqual(diff.notificationCount, diff.removals.count + diff.insertions.count + 1)
+    }
+
+    /// Random edits of random snapshots, some with repeated ids.
+    func testRandomSnapshots() throws {
+        var random = SplitMix64(seed: 0xD1FF)
+        for round in 0 ..< 500 {
+            let idRange = 1 + Int(random.next() % 40)
+            let old = (0 ..< Int(random.next() % 30)).map { _ in Row(id: Int(random.next() % UInt64(idRange)), text: "\(random.next() % 3)") }
+            let new = (0 ..< Int(random.next() % 30)).map { _ in Row(id: Int(random.next() % UInt64(idRange)), text: "\(random.next() % 3)") }
+            let diff = SnapshotDiff(from: old, to: new)
+
+            let applied = Self.apply(diff, to: old, new)
+            XCTAssertEqual(applied.map(\.id), new.map(\.id), "Round \(round).")
+            // After the change notifications, every row reads as the new one.
+            var refreshed = applied
+            for row in diff.changes { refreshed[row] = new[row] }
+            XCTAssertEqual(refreshed, new, "Round \(round): a kept row changed, but wasn't reported.")
+        }
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testApplyingGivesTheNewRows", testApplyingGivesTheNewRows),
+        ("testRangesAreOrderedAndDisjoint", testRangesAreOrderedAndDisjoint),
+        ("testChangedRowsThatStayAreReported", testChangedRowsThatStayAreReported),
+        ("testRandomSnapshots", testRandomSnapshots),
+    ]
+#endif
+}
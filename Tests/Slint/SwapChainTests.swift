@@ -0,0 +1,135 @@
+// `SoftwareSwapChain` must give exactly what a full redraw gives, while only repainting what changed.
+// Rendered headless, with the test thread standing in for the event loop.
+import XCTest
+
+import SlintFFI
+@testable import SlintUI
+
+final class SwapChainTests: XCTestCase {
+    /// A box that moves, a counter, and a bar that grows. Small changes in different places each frame.
+    static let scene = """
+        export component SwapChainScene inherits Window {
+            in property <int> frame: 0;
+            width: 160px;
+            height: 120px;
+            background: #102030;
+
+            Rectangle {
+                x: mod(root.frame * 7, 140) * 1px;
+                y: mod(root.frame * 3, 100) * 1px;
+                width: 20px;
+                height: 20px;
+                background: #e08020;
+            }
+
+            Text {
+                x: 4px;
+                y: 4px;
+                text: "Frame \\(root.frame)";
+                color: white;
+            }
+
+            Rectangle {
+                x: 0;
+                y: parent.height - 6px;
+                height: 6px;
+                width: mod(root.frame * 5, 160) * 1px;
+                background: #40c080;
+            }
+        }
+        """
+
+    static let width = 160
+    static let height = 120
+    static let frames = 40
+
+    override func setUp() {
+        super.setUp()
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+    }
+
+    override func tearDown() {
+        SlintEventLoopExecutor.shared.unbindThread()
+        super.tearDown()
+    }
+
+    /// Render the scene through a swap chain, and through a window that repaints everything, and compare every frame.
+    private func compareWithFullRedraw(buffers: Int, storage: SoftwareSwapChain<Rgb8Pixel>.Storage = .anonymous) throws {
+        let platform = HeadlessPlatform.shared ?? HeadlessPlatform.install(manualTime: true)
+        let definition = try SlintCompiler().build(fromSource: Self.scene)
+
+        try SlintActor.assumeIsolated {
+            let reference = SoftwareWindowAdapter(width: UInt32(Self.width), height: UInt32(Self.height), bufferAge: 0)
+            platform.nextWindow = reference
+            let referenceInstance = definition.create()
+            referenceInstance.show()
+
+            let chain = try SoftwareSwapChain<Rgb8Pixel>(width: Self.width, height: Self.height, buffers: buffers, storage: storage)
+            platform.nextWindow = chain.window
+            let instance = definition.create()
+            instance.show()
+
+            let expected = UnsafeMutableBufferPointer<Rgb8Pixel>.allocate(capacity: Self.width * Self.height)
+            defer { expected.deallocate() }
+
+            for frame in 0 ..< Self.frames {
+                referenceInstance.setProperty("frame", .number(Double(frame)))
+                instance.setProperty("frame", .number(Double(frame)))
+                platform.advance(by: 16)
+
+                reference.render(into: expected)
+                let rendered = chain.render()
+
+                let matches = memcmp(expected.baseAddress!, rendered.pixels.baseAddress!, expected.count * MemoryLayout<Rgb8Pixel>.stride) == 0
+                XCTAssertTrue(matches, "Frame \(frame), in buffer \(rendered.index), doesn't match a full redraw.")
+            }
+
+            // After the first frame, only small parts of the scene change.
+            let statistics = chain.statistics
+            XCTAssertEqual(statistics.frames, Self.frames)
+            XCTAssertLessThan(statistics.pixelsRendered, Self.frames * Self.width * Self.height / 2)
+
+            referenceInstance.hide()
+            instance.hide()
+        }
+    }
+
+    func testDoubleBufferingMatchesFullRedraw() throws {
+        try compareWithFullRedraw(buffers: 2)
+    }
+
+    func testTripleBufferingMatchesFullRedraw() throws {
+        try compareWithFullRedraw(buffers: 3)
+    }
+
+    func testSharedMemoryMatchesFullRedraw() throws {
+        try compareWithFullRedraw(buffers: 2, storage: .sharedMemory(name: "/slint-swift-swap-chain-test-\(getpid())"))
+    }
+
+    func testUnionIgnoresEmptyRectangles() throws {
+        var a = IntRect()
+        a.x = 10
+        a.y = 20
+        a.width = 5
+        a.height = 5
+        var b = IntRect()
+        b.x = 30
+        b.y = 0
+        b.width = 10
+        b.height = 10
+
+        let union = a.union(b)
+        XCTAssertEqual([union.x, union.y, union.width, union.height], [10, 0, 30, 25])
+        XCTAssertEqual(a.union(IntRect()).area, a.area)
+        XCTAssertEqual(IntRect().union(b).area, b.area)
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testDoubleBufferingMatchesFullRedraw", testDoubleBufferingMatchesFullRedraw),
+        ("testTripleBufferingMatchesFullRedraw", testTripleBufferingMatchesFullRedraw),
+        ("testSharedMemoryMatchesFullRedraw", testSharedMemoryMatchesFullRedraw),
+        ("testUnionIgnoresEmptyRectangles", testUnionIgnoresEmptyRectangles),
+    ]
+#endif
+}
@@ -0,0 +1,185 @@
+// `SlintTimerService`: what fires, when, and what `stop`, `restart` and `isRunning` report along the way.
+// Its clock is stopped, and `fire()` is called by hand, standing in for the native timer. The test thread stands in for the loop.
+import XCTest
+
+@testable import SlintUI
+
+/// Milliseconds, moved by hand.
+final class ManualClock: @unchecked Sendable {
+    var now: UInt64 = 1_000
+}
+
+final class TimerServiceTests: XCTestCase {
+    private let clock = ManualClock()
+    private var service: SlintTimerService!
+
+    override func setUp() {
+        super.setUp()
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        // Arming starts a native Slint timer, which needs a platform. Its time is manual, so it never fires by itself.
+        _ = HeadlessPlatform.shared ?? HeadlessPlatform.install(manualTime: true)
+        let clock = clock
+        service = SlintTimerService(clock: { clock.now })
+    }
+
+    override func tearDown() {
+        service = nil
+        SlintEventLoopExecutor.shared.unbindThread()
+        super.tearDown()
+    }
+
+    /// Move the clock to `tick`, and fire whatever's due.
+    @SlintActor
+    private func fire(at tick: UInt64) {
+        clock.now = tick
+        service.fire()
+    }
+
+    func testFiresInDeadlineOrder() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            service.schedule(after: 30) { log.entries.append("30") }
+            service.schedule(after: 10) { log.entries.append("10") }
+            service.schedule(after: 20) { log.entries.append("20") }
+
+            fire(at: 1_009)
+            XCTAssertEqual(log.entries, [])
+
+            fire(at: 1_030)
+            XCTAssertEqual(log.entries, ["10", "20", "30"])
+            XCTAssertEqual(service.scheduledCount, 0)
+        }
+    }
+
+    func testStopBeforeFire() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            let timer = service.schedule(after: 10) { log.entries.append("fired") }
+            XCTAssertTrue(service.isRunning(timer))
+
+            service.stop(timer)
+            XCTAssertFalse(service.isRunning(timer))
+            fire(at: 1_100)
+            XCTAssertEqual(log.entries, [])
+
+            // Stopped, not cancelled, so it can be restarted, from now.
+            service.restart(timer)
+            XCTAssertTrue(service.isRunning(timer))
+            fire(at: 1_109)
+            XCTAssertEqual(log.entries, [])
+            fire(at: 1_110)
+            XCTAssertEqual(log.entries, ["fired"])
+            XCTAssertFalse(service.isRunning(timer))
+        }
+    }
+
+    func testRestartWhileRunningPushesTheDeadline() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            let timer = service.schedule(after: 100) { log.entries.append("fired") }
+
+            clock.now = 1_060
+            service.restart(timer)
+
+            fire(at: 1_100)
+            XCTAssertEqual(log.entries, [])
+            XCTAssertTrue(service.isRunning(timer))
+
+            fire(at: 1_160)
+            XCTAssertEqual(log.entries, ["fired"])
+            XCTAssertFalse(service.isRunning(timer))
+        }
+    }
+
+    func testPeriodicTimerRearms() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            let timer = service.schedule(every: 10) { log.entries.append("tick") }
+
+            fire(at: 1_010)
+            fire(at: 1_020)
+            XCTAssertEqual(log.entries.count, 2)
+            XCTAssertTrue(service.isRunning(timer))
+
+            // Late: the missed periods fire once, not as a burst, and the next stays on the original grid.
+            fire(at: 1_055)
+            XCTAssertEqual(log.entries.count, 3)
+            fire(at: 1_059)
+            XCTAssertEqual(log.entries.count, 3)
+            fire(at: 1_060)
+            XCTAssertEqual(log.entries.count, 4)
+
+            service.stop(timer)
+            fire(at: 1_100)
+            XCTAssertEqual(log.entries.count, 4)
+        }
+    }
+
+    func testPeriodicTimerCanStopItself() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            let service = service!
+            var timer: SlintTimerService.Handle?
+            timer = service.schedule(every: 10) {
+                log.entries.append("tick")
+                if log.entries.count == 2 { service.stop(timer!) }
+            }
+
+            for tick in stride(from: UInt64(1_010), through: 1_050, by: 10) { fire(at: tick) }
+            XCTAssertEqual(log.entries.count, 2)
+            XCTAssertFalse(service.isRunning(timer!))
+        }
+    }
+
+    /// Leeway rounds deadlines up to a grid of the largest power of two that fits in it, here 8 ms.
+    /// Timers due at 1,097 and 1,101 both land on 1,104, and fire in one wakeup, within their leeway.
+    func testLeewayCoalesces() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            service.schedule(after: 97, leeway: 10) { log.entries.append("97") }
+            service.schedule(after: 101, leeway: 10) { log.entries.append("101") }
+            // No leeway: exactly on time, on its own.
+            service.schedule(after: 99) { log.entries.append("99") }
+
+            fire(at: 1_099)
+            XCTAssertEqual(log.entries, ["99"])
+            fire(at: 1_103)
+            XCTAssertEqual(log.entries, ["99"])
+
+            let wakeups = service.statistics.wakeups
+            fire(at: 1_104)
+            XCTAssertEqual(Set(log.entries.dropFirst()), ["97", "101"])
+            XCTAssertEqual(service.statistics.wakeups, wakeups + 1)
+        }
+    }
+
+    func testCancelledHandleGoesStale() throws {
+        SlintActor.assumeIsolated {
+            let log = IsolatedLog()
+            let timer = service.schedule(after: 10) { log.entries.append("old") }
+            service.cancel(timer)
+
+            // The record is reused, but the old handle doesn't reach the new timer.
+            let reused = service.schedule(after: 20) { log.entries.append("new") }
+            service.stop(timer)
+            service.restart(timer)
+            XCTAssertFalse(service.isRunning(timer))
+            XCTAssertTrue(service.isRunning(reused))
+
+            fire(at: 1_020)
+            XCTAssertEqual(log.entries, ["new"])
+        }
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testFiresInDeadlineOrder", testFiresInDeadlineOrder),
+        ("testStopBeforeFire", testStopBeforeFire),
+        ("testRestartWhileRunningPushesTheDeadline", testRestartWhileRunningPushesTheDeadline),
+        ("testPeriodicTimerRearms", testPeriodicTimerRearms),
+        ("testPeriodicTimerCanStopItself", testPeriodicTimerCanStopItself),
+        ("testLeewayCoalesces", testLeewayCoalesces),
+        ("testCancelledHandleGoesStale", testCancelledHandleGoesStale),
+    ]
+#endif
+}
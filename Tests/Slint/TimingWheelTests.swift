@@ -0,0 +1,135 @@
+// `TimingWheel` must expire every deadline exactly on its tick, in order, however many levels it cascades through.
+// Pure data structure, so no event loop, and no clock.
+import XCTest
+
+@testable import SlintUI
+
+final class TimingWheelTests: XCTestCase {
+    /// Advance to `tick`, and return what expired.
+    private func advance(_ wheel: inout TimingWheel, to tick: UInt64) -> [Int] {
+        var expired: [Int] = []
+        wheel.advance(to: tick, into: &expired)
+        return expired
+    }
+
+    func testExpiresInDeadlineOrder() throws {
+        var wheel = TimingWheel(startingAt: 0)
+        let deadlines: [UInt64] = [500, 3, 70_000, 64, 1, 4_096, 63, 200]
+        for (id, deadline) in deadlines.enumerated() { wheel.schedule(id, at: deadline) }
+
+        let expired = advance(&wheel, to: 1_000_000)
+        XCTAssertEqual(expired.map { deadlines[$0] }, deadlines.sorted())
+        XCTAssertEqual(wheel.count, 0)
+        XCTAssertNil(wheel.nextDeadline())
+    }
+
+    /// Each deadline sits just before, on, or just after the start of a slot on a higher level,
+    /// so reaching it means cascading down through every level in between.
+    func testCascadesAcrossLevelBoundaries() throws {
+        let start: UInt64 = 60
+        var deadlines: [UInt64] = []
+        for level in 1 ... 5 {
+            let boundary = UInt64(1) << UInt64(level * TimingWheel.bitsPerLevel)
+            deadlines += [boundary - 1, boundary, boundary + 1]
+        }
+
+        var wheel = TimingWheel(startingAt: start)
+        for (id, deadline) in deadlines.enumerated() { wheel.schedule(id, at: deadline) }
+
+        for (id, deadline) in deadlines.enumerated() {
+            XCTAssertEqual(wheel.nextDeadline(), deadline)
+            XCTAssertEqual(advance(&wheel, to: deadline - 1), [], "\(deadline) expired a tick early.")
+            XCTAssertEqual(advance(&wheel, to: deadline), [id], "\(deadline) didn't expire on its tick.")
+        }
+        XCTAssertEqual(wheel.count, 0)
+    }
+
+    func testCancelAndReschedule() throws {
+        var wheel = TimingWheel(startingAt: 0)
+        wheel.schedule(0, at: 10)
+        wheel.schedule(1, at: 20)
+        wheel.schedule(2, at: 30)
+
+        wheel.cancel(1)
+        XCTAssertFalse(wheel.isScheduled(1))
+        // Cancelling twice, or something never scheduled, does nothing.
+        wheel.cancel(1)
+        wheel.cancel(7)
+
+        // Moving an entry doesn't count it twice.
+        wheel.schedule(2, at: 5_000)
+        XCTAssertEqual(wheel.count, 2)
+        XCTAssertEqual(wheel.deadline(of: 2), 5_000)
+
+        XCTAssertEqual(advance(&wheel, to: 4_999), [0])
+        XCTAssertEqual(advance(&wheel, to: 5_000), [2])
+    }
+
+    func testPastDeadlinesExpireOnNextAdvance() throws {
+        var wheel = TimingWheel(startingAt: 100)
+        XCTAssertEqual(advance(&wheel, to: 150), [])
+
+        wheel.schedule(0, at: 20)
+        XCTAssertEqual(wheel.deadline(of: 0), 151)
+        XCTAssertEqual(advance(&wheel, to: 151), [0])
+    }
+
+    /// Random deadlines, cancels and advances, against a plain list of what's scheduled.
+    func testMatchesReference() throws {
+        var random = SplitMix64(seed: 0x5EED)
+        var wheel = TimingWheel(startingAt: 1_000)
+        var reference: [Int: UInt64] = [:]
+        var now: UInt64 = 1_000
+
+        for _ in 0 ..< 20_000 {
+            let id = Int(random.next() % 256)
+            switch random.next() % 4 {
+            case 0, 1:
+                // Spread over several levels.
+                let delay = random.next() % (UInt64(1) << (random.next() % 24))
+                wheel.schedule(id, at: now + delay)
+                reference[id] = now + delay
+            case 2:
+                wheel.cancel(id)
+                reference[id] = nil
+            default:
+                let tick = now + random.next() % 5_000
+                let expired = advance(&wheel, to: tick)
+                let due = reference.filter { $0.value <= tick }
+                XCTAssertEqual(Set(expired), Set(due.keys))
+                XCTAssertEqual(expired.map { due[$0]! }, expired.map { due[$0]! }.sorted(), "Expired out of deadline order.")
+                for id in expired { reference[id] = nil }
+                now = tick + 1
+            }
+            XCTAssertEqual(wheel.count, reference.count)
+            XCTAssertEqual(wheel.nextDeadline(), reference.values.min())
+        }
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testExpiresInDeadlineOrder", testExpiresInDeadlineOrder),
+        ("testCascadesAcrossLevelBoundaries", testCascadesAcrossLevelBoundaries),
+        ("testCancelAndReschedule", testCancelAndReschedule),
+        ("testPastDeadlinesExpireOnNextAdvance", testPastDeadlinesExpireOnNextAdvance),
+        ("testMatchesReference", testMatchesReference),
+    ]
+#endif
+}
+
+/// Small, seeded random numbers, so a failure can be replayed.
+struct SplitMix64: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE5_E4B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        return z ^ (z >> 31)
+    }
+}
@@ -0,0 +1,89 @@
+// Typed callbacks on an interpreter instance: who owns the handler, whether Slint takes it or not.
+// The test thread stands in for the event loop.
+import XCTest
+
+@testable import SlintUI
+
+final class TypedAccessTests: XCTestCase {
+    static let scene = """
+        export global Logic {
+            callback double(int) -> int;
+        }
+
+        export component TypedAccessScene inherits Window {
+            callback add(int, int) -> int;
+        }
+        """
+
+    /// Something for a handler to hold, to see when the handler is freed.
+    final class Token { }
+
+    private var instance: SlintComponentInstance!
+
+    override func setUp() {
+        super.setUp()
+        SlintEventLoopExecutor.shared.bindToCurrentThread()
+        _ = HeadlessPlatform.shared ?? HeadlessPlatform.install(manualTime: true)
+        let definition = try! SlintCompiler().build(fromSource: Self.scene)
+        instance = SlintActor.assumeIsolated { definition.create() }
+    }
+
+    override func tearDown() {
+        instance = nil
+        SlintEventLoopExecutor.shared.unbindThread()
+        super.tearDown()
+    }
+
+    /// Set a handler holding a new token, through `set`.
+    /// - Returns: What `set` returned, and whether the token, which only the handler holds, is still alive.
+    @SlintActor
+    private func setHandler(_ set: (@escaping @SlintActor ([SlintValue]) -> SlintValue) -> Bool) -> (Bool, isHeld: () -> Bool) {
+        let token = Token()
+        let result = set { _ in
+            withExtendedLifetime(token) { .void }
+        }
+        return (result, { [weak token] in token != nil })
+    }
+
+    func testUnknownCallbackIsRefusedAndItsHandlerFreed() throws {
+        let instance = instance!
+        SlintActor.assumeIsolated {
+            // Slint drops the handler it refuses. Releasing it again here would free it twice.
+            let (set, isHeld) = setHandler { instance.setCallback(SlintName("no-such-callback"), $0) }
+            XCTAssertFalse(set)
+            XCTAssertFalse(isHeld(), "The refused handler wasn't freed.")
+
+            let (setGlobal, isGlobalHeld) = setHandler { instance.setCallback(SlintName("Logic"), SlintName("no-such-callback"), $0) }
+            XCTAssertFalse(setGlobal)
+            XCTAssertFalse(isGlobalHeld(), "The refused handler wasn't freed.")
+
+            let (setMissingGlobal, isMissingGlobalHeld) = setHandler { instance.setCallback(SlintName("NoSuchGlobal"), SlintName("double"), $0) }
+            XCTAssertFalse(setMissingGlobal)
+            XCTAssertFalse(isMissingGlobalHeld(), "The refused handler wasn't freed.")
+
+            // The instance is still fine.
+            XCTAssertTrue(instance.setCallback(SlintName("add")) { .number(($0[0].number ?? 0) + ($0[1].number ?? 0)) })
+            XCTAssertEqual(instance.invoke(SlintName("add"), [2, 3])?.number, 5)
+        }
+    }
+
+    func testReplacedHandlerIsFreed() throws {
+        let instance = instance!
+        SlintActor.assumeIsolated {
+            let (set, isHeld) = setHandler { instance.setCallback(SlintName("Logic"), SlintName("double"), $0) }
+            XCTAssertTrue(set)
+            XCTAssertTrue(isHeld(), "Slint freed a handler it kept.")
+
+            XCTAssertTrue(instance.setCallback(SlintName("Logic"), SlintName("double")) { .number(($0[0].number ?? 0) * 2) })
+            XCTAssertFalse(isHeld(), "The replaced handler wasn't freed.")
+            XCTAssertEqual(instance.invoke(SlintName("Logic"), SlintName("double"), [21])?.number, 42)
+        }
+    }
+
+#if MANUAL_TEST_DISCOVERY
+    static var allTests = [
+        ("testUnknownCallbackIsRefusedAndItsHandlerFreed", testUnknownCallbackIsRefusedAndItsHandlerFreed),
+        ("testReplacedHandlerIsFreed", testReplacedHandlerIsFreed),
+    ]
+#endif
+}
@@ -4,6 +4,15 @@ import XCTest
 
 var testCases = [
     testCase(ExampleTests.allTests),
+    testCase(IsolationTests.allTests),
+    testCase(SwapChainTests.allTests),
+    testCase(ComputedTests.allTests),
+    testCase(JobQueueTests.allTests),
+    testCase(ChannelTests.allTests),
+    testCase(TimingWheelTests.allTests),
+    testCase(TimerServiceTests.allTests),
+    testCase(SnapshotDiffTests.allTests),
+    testCase(TypedAccessTests.allTests),
 ]
 
 XCTMain(testCases)
@@ -0,0 +1,37 @@
+# Generate typed Swift accessors for `.slint` files, and add them to a target's sources.
+#
+#   slint_swift_generate(<target> <file.slint>... [STYLE <style>] [INCLUDE_PATHS <directory>...])
+#
+# Each file gives `<name>+Slint.swift` in the current binary directory, made by `SlintCodegen`.
+# STYLE and INCLUDE_PATHS are passed on as `--style` and `-I`, so the file compiles the way the app will compile it.
+# It's remade when the `.slint` file, or the generator, changes. Files it imports aren't tracked.
+function(slint_swift_generate target)
+  cmake_parse_arguments(PARSE_ARGV 1 GENERATE "" "STYLE" "INCLUDE_PATHS")
+  if(NOT GENERATE_UNPARSED_ARGUMENTS)
+    message(FATAL_ERROR "slint_swift_generate: no .slint files given for ${target}")
+  endif()
+
+  set(options)
+  if(GENERATE_STYLE)
+    list(APPEND options --style "${GENERATE_STYLE}")
+  endif()
+  foreach(path ${GENERATE_INCLUDE_PATHS})
+    get_filename_component(path "${path}" ABSOLUTE)
+    list(APPEND options -I "${path}")
+  endforeach()
+
+  foreach(source ${GENERATE_UNPARSED_ARGUMENTS})
+    get_filename_component(source "${source}" ABSOLUTE)
+    get_filename_component(name "${source}" NAME_WE)
+    set(output "${CMAKE_CURRENT_BINARY_DIR}/${name}+Slint.swift")
+
+    add_custom_command(
+      OUTPUT "${output}"
+      COMMAND SlintCodegen "${source}" "${output}" ${options}
+      DEPENDS SlintCodegen "${source}"
+      COMMENT "Generating Swift accessors for ${name}.slint"
+      VERBATIM
+    )
+    target_sources(${target} PRIVATE "${output}")
+  endforeach()
+endfunction()
@@ -0,0 +1,52 @@
+# Bake a font into bitmap glyphs at build time, and add them to a target's sources.
+#
+#   slint_swift_bake_font(<target> <font.ttf> SIZES <px>...
+#                         [CHARACTERS <text>] [RANGES <first>-<last>...] [NAME <SwiftName>] [FAMILY <family name>])
+#
+# Gives `<name>+Font/` in the current binary directory, made by `SlintFontBaker`: a Swift file with a `<SwiftName>.font`
+# to register, and a C++ file with the glyphs as static data, which the Swift file imports as `<SwiftName>Data`.
+# Without CHARACTERS or RANGES, printable ASCII is baked. It's remade when the font, or the baker, changes.
+# The baker is only built if FreeType is found.
+function(slint_swift_bake_font target font)
+  cmake_parse_arguments(PARSE_ARGV 2 BAKE "" "CHARACTERS;NAME;FAMILY" "SIZES;RANGES")
+  if(NOT TARGET SlintFontBaker)
+    message(FATAL_ERROR "slint_swift_bake_font: SlintFontBaker isn't built, so ${font} can't be baked. It needs FreeType.")
+  endif()
+  if(NOT BAKE_SIZES)
+    message(FATAL_ERROR "slint_swift_bake_font: no SIZES given for ${font}")
+  endif()
+
+  get_filename_component(font "${font}" ABSOLUTE)
+  get_filename_component(name "${font}" NAME_WE)
+  # A directory each, for the module map.
+  set(directory "${CMAKE_CURRENT_BINARY_DIR}/${name}+Font")
+  set(output "${directory}/${name}+Font.swift")
+  set(generated "${output}" "${directory}/${name}+Font.cpp" "${directory}/${name}+Font.h" "${directory}/module.modulemap")
+
+  list(JOIN BAKE_SIZES "," sizes)
+  set(options --sizes "${sizes}")
+  if(DEFINED BAKE_CHARACTERS)
+    list(APPEND options --characters "${BAKE_CHARACTERS}")
+  endif()
+  if(BAKE_RANGES)
+    list(JOIN BAKE_RANGES "," ranges)
+    list(APPEND options --ranges "${ranges}")
+  endif()
+  if(BAKE_NAME)
+    list(APPEND options --name "${BAKE_NAME}")
+  endif()
+  if(BAKE_FAMILY)
+    list(APPEND options --family "${BAKE_FAMILY}")
+  endif()
+
+  add_custom_command(
+    OUTPUT ${generated}
+    COMMAND "${CMAKE_COMMAND}" -E make_directory "${directory}"
+    COMMAND SlintFontBaker "${font}" "${output}" ${options}
+    DEPENDS SlintFontBaker "${font}"
+    COMMENT "Baking ${name} at ${sizes}px"
+    VERBATIM
+  )
+  target_sources(${target} PRIVATE "${output}" "${directory}/${name}+Font.cpp")
+  target_include_directories(${target} PRIVATE "${directory}")
+endfunction()